@@ -0,0 +1,29 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Common/Types.h"
+#include "Util/Platform.h"
+
+// Every benchmark suite is a free function registered in benchmark.cpp.
+// Suites print their own results, and should keep a checksum of their
+// work alive so the optimizer can't remove the measured loop.
+
+void BenchHashMapFindBatch();
+void BenchConcurrentHashMap();
+void BenchBloomFilter();
+void BenchRoaringBitmap();
+void BenchQueue();
+void BenchSharedArray();
+void BenchPipeline();
+void BenchStencil();
+void BenchSpatialHashGrid();
+void BenchEntityStore();
+void BenchTimerWheel();
+void BenchRadixTree();
+
+inline f64 TicksToNanoseconds(uint64 ticks)
+{
+	return f64(ticks) * 1000000000.0 / f64(Platform::GetFrequency());
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/BloomFilter.h"
+#include "Containers/Set.h"
+#include "Random.h"
+
+// Compares the cost of a negative lookup in a Set against a probe of a
+// BloomFilter and a BlockedBloomFilter holding the same items, each sized
+// for the same false positive rate, and reports the rate each reached.
+void BenchBloomFilter()
+{
+	const uint32 numLookups = 1000000;
+	const uint32 itemCounts[] = { 1 << 12, 1 << 16, 1 << 20, 1 << 22 };
+	const f64 falsePositiveRate = 0.01;
+	
+	Random::RandState rand;
+	rand.Seed(0xB100);
+	
+	for (uint32 numItems : itemCounts)
+	{
+		const BloomFilterSize size = BloomFilterSize::ForFalsePositiveRate(numItems, falsePositiveRate);
+		Set<uint64> set;
+		BloomFilter filter(size);
+		BlockedBloomFilter blocked(BloomFilterSize::ForFalsePositiveRateBlocked(numItems, falsePositiveRate));
+		for (uint32 i = 0; i < numItems; ++i)
+		{
+			const uint64 item = rand.RandU64();
+			set.Add(item);
+			filter.Add(item);
+			blocked.Add(item);
+		}
+		
+		// Practically every lookup misses
+		Array<uint64> keys(numLookups);
+		for (uint32 i = 0; i < numLookups; ++i)
+		{
+			keys.Add(rand.RandU64());
+		}
+		
+		uint64 setHits = 0;
+		uint64 start = Platform::GetTicks();
+		for (uint32 i = 0; i < numLookups; ++i)
+		{
+			setHits += set.Contains(keys[i]);
+		}
+		const f64 setNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		uint64 filterHits = 0;
+		start = Platform::GetTicks();
+		for (uint32 i = 0; i < numLookups; ++i)
+		{
+			filterHits += filter.MayContain(keys[i]);
+		}
+		const f64 filterNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		uint64 blockedHits = 0;
+		start = Platform::GetTicks();
+		for (uint32 i = 0; i < numLookups; ++i)
+		{
+			blockedHits += blocked.MayContain(keys[i]);
+		}
+		const f64 blockedNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		std::cout << "items " << numItems
+			<< "\tSet miss " << setNs / numLookups << " ns"
+			<< "\tBloom " << filterNs / numLookups << " ns (k=" << size.NumHashes
+			<< ", fp " << f64(filterHits - setHits) / numLookups << ")"
+			<< "\tBlocked " << blockedNs / numLookups << " ns (k=" << blocked.GetNumHashes()
+			<< ", " << f64(blocked.GetNumBits()) / size.NumBits << "x bits, fp "
+			<< f64(blockedHits - setHits) / numLookups << ")" << std::endl;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "Containers/ConcurrentHashMap.h"
+#include "Random.h"
+#include "Util/SpinLock.h"
+
+// Mixed FindOrAdd/Find traffic on a shared map, comparing one global
+// lock around a HashMap with the sharded ConcurrentHashMap.
+namespace {
+	const uint32 NumKeys = 1 << 16;
+	const uint32 NumOpsPerThread = 200000;
+
+	struct GlobalLockMap {
+		SpinLock Lock;
+		HashMap<uint64, uint32> Map;
+
+		uint32 FindOrAdd(uint64 key, uint32 value) {
+			ScopeLock<SpinLock> lock(Lock);
+			bool bAdded = false;
+			uint32& slot = Map.FindOrAdd(key, &bAdded);
+			if (bAdded) {
+				slot = value;
+			}
+			return slot;
+		}
+	};
+
+	template<typename M>
+	f64 RunThreads(M& map, uint32 numThreads)
+	{
+		std::vector<std::thread> threads;
+		const uint64 start = Platform::GetTicks();
+		for (uint32 t = 0; t < numThreads; ++t) {
+			threads.emplace_back([&map, t]() {
+				Random::RandState rand;
+				rand.Seed(t + 1);
+				uint64 checksum = 0;
+				for (uint32 i = 0; i < NumOpsPerThread; ++i) {
+					const uint64 key = rand.RandU32() % NumKeys;
+					checksum += map.FindOrAdd(key, uint32(key));
+				}
+				CHECK(checksum > 0);
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		return TicksToNanoseconds(Platform::GetTicks() - start);
+	}
+}
+
+void BenchConcurrentHashMap()
+{
+	const uint32 threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+	std::cout << "hardware threads " << std::thread::hardware_concurrency() << std::endl;
+
+	for (uint32 numThreads : threadCounts)
+	{
+		GlobalLockMap global;
+		const f64 globalNs = RunThreads(global, numThreads);
+
+		ConcurrentHashMap<uint64, uint32> sharded;
+		struct Adapter {
+			ConcurrentHashMap<uint64, uint32>& Map;
+			uint32 FindOrAdd(uint64 key, uint32 value) {
+				return Map.FindOrAdd(key, [value]() { return value; });
+			}
+		} adapter = { sharded };
+		const f64 shardedNs = RunThreads(adapter, numThreads);
+		CHECK(sharded.Num() == global.Map.Num());
+
+		const f64 numOps = f64(NumOpsPerThread) * numThreads;
+		std::cout << "threads " << numThreads
+			<< "\tglobal lock " << numOps * 1000.0 / globalNs << " Mops/s"
+			<< "\tsharded " << numOps * 1000.0 / shardedNs << " Mops/s" << std::endl;
+	}
+}
\ No newline at end of file
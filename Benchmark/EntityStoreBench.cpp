@@ -0,0 +1,153 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/Array.h"
+#include "Containers/EntityStore.h"
+#include "Containers/HashMap.h"
+#include "Random.h"
+
+struct BenchPosition {
+	f32 X = 0.0f;
+	f32 Y = 0.0f;
+	f32 Z = 0.0f;
+};
+
+struct BenchVelocity {
+	f32 X = 0.0f;
+	f32 Y = 0.0f;
+	f32 Z = 0.0f;
+};
+
+struct BenchHealth {
+	f32 Value = 100.0f;
+	f32 Regeneration = 1.0f;
+};
+
+struct BenchStunned {
+	f32 TimeLeft = 2.0f;
+};
+
+// Moves entities with a position and a velocity for a number of frames,
+// once with every component type in its own HashMap keyed by entity and
+// once in an EntityStore, where the movement system walks the chunks.
+// Also times stunning every entity with health, one entity at a time
+// and by moving whole archetypes at once.
+void BenchEntityStore()
+{
+	const uint32 numEntities = 50000;
+	const uint32 numFrames = 100;
+	const f32 deltaTime = 1.0f / 60.0f;
+	
+	Random::RandState rand;
+	rand.Seed(0xEC5);
+	
+	Array<BenchPosition> startPositions(numEntities);
+	Array<BenchVelocity> velocities(numEntities);
+	for (uint32 i = 0; i < numEntities; ++i)
+	{
+		startPositions.Add(BenchPosition{ f32(rand.RandU32() % 1000), f32(rand.RandU32() % 1000), 0.0f });
+		velocities.Add(BenchVelocity{ f32(rand.RandU32() % 10), f32(rand.RandU32() % 10), 1.0f });
+	}
+	
+	// Every entity moves, every other one has health as well
+	HashMap<uint32, BenchPosition> positionMap;
+	HashMap<uint32, BenchVelocity> velocityMap;
+	HashMap<uint32, BenchHealth> healthMap;
+	Array<uint32> movers(numEntities);
+	for (uint32 i = 0; i < numEntities; ++i)
+	{
+		positionMap.Add(i) = startPositions[i];
+		velocityMap.Add(i) = velocities[i];
+		if (i % 2 == 0)
+		{
+			healthMap.Add(i);
+		}
+		movers.Add(i);
+	}
+	
+	uint64 start = Platform::GetTicks();
+	for (uint32 frame = 0; frame < numFrames; ++frame)
+	{
+		for (uint32 i = 0; i < movers.Num(); ++i)
+		{
+			BenchPosition& position = positionMap.FindChecked(movers[i]);
+			const BenchVelocity& velocity = velocityMap.FindChecked(movers[i]);
+			position.X += velocity.X * deltaTime;
+			position.Y += velocity.Y * deltaTime;
+			position.Z += velocity.Z * deltaTime;
+		}
+	}
+	const f64 mapNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	f64 mapSum = 0.0;
+	for (uint32 i = 0; i < numEntities; ++i)
+	{
+		mapSum += positionMap.FindChecked(i).X + positionMap.FindChecked(i).Y;
+	}
+	
+	EntityStore store;
+	Array<EntityId> entities(numEntities);
+	for (uint32 i = 0; i < numEntities; ++i)
+	{
+		if (i % 2 == 0)
+		{
+			entities.Add(store.Create(startPositions[i], velocities[i], BenchHealth()));
+		}
+		else
+		{
+			entities.Add(store.Create(startPositions[i], velocities[i]));
+		}
+	}
+	
+	start = Platform::GetTicks();
+	for (uint32 frame = 0; frame < numFrames; ++frame)
+	{
+		store.ForEachChunk<BenchPosition, BenchVelocity>([deltaTime](uint32 num, const EntityId*, BenchPosition* positions, BenchVelocity* velocities)
+		{
+			for (uint32 i = 0; i < num; ++i)
+			{
+				positions[i].X += velocities[i].X * deltaTime;
+				positions[i].Y += velocities[i].Y * deltaTime;
+				positions[i].Z += velocities[i].Z * deltaTime;
+			}
+		});
+	}
+	const f64 storeNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	f64 storeSum = 0.0;
+	for (uint32 i = 0; i < numEntities; ++i)
+	{
+		const BenchPosition* position = store.Get<BenchPosition>(entities[i]);
+		storeSum += position->X + position->Y;
+	}
+	
+	const ComponentMask health = EntityStore::MaskOf<BenchHealth>();
+	const ComponentMask stunned = EntityStore::MaskOf<BenchStunned>();
+	start = Platform::GetTicks();
+	for (uint32 i = 0; i < numEntities; i += 2)
+	{
+		store.ChangeComponents(entities[i], stunned, 0);
+	}
+	const f64 stunEachNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	store.ChangeComponentsAll(stunned, 0, stunned);
+	
+	start = Platform::GetTicks();
+	store.ChangeComponentsAll(health, stunned, 0);
+	const f64 stunAllNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	uint32 numStunned = 0;
+	store.ForEachChunk<BenchStunned>([&numStunned](uint32 num, const EntityId*, BenchStunned*)
+	{
+		numStunned += num;
+	});
+	
+	if (mapSum != storeSum || numStunned != numEntities / 2)
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	
+	std::cout << numEntities << " entities, " << store.GetNumArchetypes() << " archetypes" << std::endl
+		<< "\tmove system  hash maps " << mapNs / numFrames / 1000.0 << " us\tentity store " << storeNs / numFrames / 1000.0 << " us" << std::endl
+		<< "\tstun " << numEntities / 2 << "   one by one " << stunEachNs / 1000.0 << " us\twhole archetypes " << stunAllNs / 1000.0 << " us" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/HashMap.h"
+#include "Random.h"
+#include "Strings/String.h"
+
+// Compares a loop of HashMap::Find against HashMap::FindBatch for the
+// same keys, over tables from cache resident to much larger than L2.
+void BenchHashMapFindBatch()
+{
+	const uint32 numLookups = 100000;
+	const uint32 numRepeats = 10;
+	const uint32 tableSizes[] = { 1 << 10, 1 << 14, 1 << 18, 1 << 20, 1 << 22 };
+	
+	Random::RandState rand;
+	rand.Seed(0x5EED);
+	
+	for (uint32 tableSize : tableSizes)
+	{
+		HashMap<uint64, uint32> map;
+		Array<uint64> inserted(tableSize);
+		for (uint32 i = 0; i < tableSize; ++i)
+		{
+			const uint64 key = rand.RandU64();
+			map.Add(key) = i;
+			inserted.Add(key);
+		}
+		
+		// Half of the lookups hit, half of them miss
+		Array<uint64> keys(numLookups);
+		for (uint32 i = 0; i < numLookups; ++i)
+		{
+			keys.Add((i & 1) ? inserted[rand.RandU32() % tableSize] : rand.RandU64());
+		}
+		
+		uint64 checksum = 0;
+		
+		uint64 start = Platform::GetTicks();
+		for (uint32 repeat = 0; repeat < numRepeats; ++repeat)
+		{
+			for (uint32 i = 0; i < numLookups; ++i)
+			{
+				const uint32* value = map.Find(keys[i]);
+				checksum += value ? *value : 1;
+			}
+		}
+		const f64 findNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		Array<const uint32*> values;
+		const HashMap<uint64, uint32>& constMap = map;
+		start = Platform::GetTicks();
+		for (uint32 repeat = 0; repeat < numRepeats; ++repeat)
+		{
+			constMap.FindBatch(keys.View(), values);
+			for (uint32 i = 0; i < numLookups; ++i)
+			{
+				checksum += values[i] ? *values[i] : 1;
+			}
+		}
+		const f64 batchNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		const f64 numTotal = f64(numLookups) * numRepeats;
+		std::cout << "entries " << tableSize
+			<< "\tFind " << findNs / numTotal << " ns/key"
+			<< "\tFindBatch " << batchNs / numTotal << " ns/key"
+			<< "\tspeedup " << findNs / batchNs << "x"
+			<< "\t(checksum " << checksum << ")" << std::endl;
+		
+#if HASH_TABLE_STATS
+		HashTableStats stats;
+		map.GetStats(stats);
+		std::cout << stats.ToString().AsCString() << std::endl;
+#endif
+	}
+}
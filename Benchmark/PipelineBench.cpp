@@ -0,0 +1,117 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/Array.h"
+#include "Containers/View/Pipeline.h"
+#include "Random.h"
+
+static int64 ParseOrZero(StringView piece)
+{
+	int64 value = 0;
+	piece.ParseAsInt(value, 10);
+	return value;
+}
+
+// Parses a comma separated line of numbers with empty fields in it,
+// once with StringView::Split into an intermediate Array and once with
+// a lazy pipeline. Also compares a Filter and Map pipeline over an
+// array against the same loop written by hand.
+void BenchPipeline()
+{
+	const uint32 numFields = 1000000;
+	const uint32 numRepeats = 10;
+	
+	Random::RandState rand;
+	rand.Seed(0x9199);
+	
+	Array<char8> line;
+	Array<uint32> numbers(numFields);
+	for (uint32 i = 0; i < numFields; ++i)
+	{
+		const uint32 number = rand.RandU32() % 100000;
+		numbers.Add(number);
+		if ((number & 7) != 0)
+		{
+			char8 digits[8];
+			uint32 numDigits = 0;
+			for (uint32 rest = number; rest > 0 || numDigits == 0; rest /= 10)
+			{
+				digits[numDigits++] = char8('0' + rest % 10);
+			}
+			while (numDigits > 0)
+			{
+				line.Add(digits[--numDigits]);
+			}
+		}
+		line.Add(',');
+	}
+	const StringView lineView(line.GetData(), line.Num());
+	
+	uint64 start = Platform::GetTicks();
+	int64 splitSum = 0;
+	for (uint32 r = 0; r < numRepeats; ++r)
+	{
+		Array<StringView> pieces = lineView.Split(',');
+		Array<int64> values;
+		for (uint32 i = 0; i < pieces.Num(); ++i)
+		{
+			if (pieces[i].Size() > 0)
+			{
+				values.Add(ParseOrZero(pieces[i]));
+			}
+		}
+		splitSum += values[values.Num() - 1] + values.Num();
+	}
+	const f64 splitNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	int64 pipelineSum = 0;
+	for (uint32 r = 0; r < numRepeats; ++r)
+	{
+		Array<int64> values;
+		Pipeline::Split(lineView, ',')
+			.Filter([](StringView piece) { return piece.Size() > 0; })
+			.Map(&ParseOrZero)
+			.CollectInto(values);
+		pipelineSum += values[values.Num() - 1] + values.Num();
+	}
+	const f64 pipelineNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	uint64 loopSum = 0;
+	for (uint32 r = 0; r < numRepeats; ++r)
+	{
+		for (uint32 i = 0; i < numbers.Num(); ++i)
+		{
+			if ((numbers[i] & 1) == 0)
+			{
+				loopSum += uint64(numbers[i]) * 3 + r;
+			}
+		}
+	}
+	const f64 loopNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	uint64 mapSum = 0;
+	for (uint32 r = 0; r < numRepeats; ++r)
+	{
+		Pipeline::From(numbers)
+			.Filter([](uint32 number) { return (number & 1) == 0; })
+			.Map([r](uint32 number) { return uint64(number) * 3 + r; })
+			.ForEach([&mapSum](uint64 value) { mapSum += value; });
+	}
+	const f64 mapNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	if (splitSum != pipelineSum || loopSum != mapSum)
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	
+	std::cout << "parse " << numFields << " fields" << std::endl
+		<< "\tSplit    " << splitNs / numRepeats / 1000000.0 << " ms\tPipeline " << pipelineNs / numRepeats / 1000000.0 << " ms" << std::endl
+		<< "filter and map " << numFields << " values" << std::endl
+		<< "\tloop     " << loopNs / numRepeats / 1000000.0 << " ms\tPipeline " << mapNs / numRepeats / 1000000.0 << " ms" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "Containers/Array.h"
+#include "Containers/MpmcQueue.h"
+#include "Containers/SpscQueue.h"
+#include "Util/SpinLock.h"
+
+// Throughput of the SPSC and MPMC queues moving items one at a time and
+// in batches, and the round trip latency of a ping pong between two
+// threads, for a few pairs of cores. Threads that find their queue full
+// or empty back off with a SpinWait.
+namespace
+{
+	const uint32 NumItems = 1 << 22;
+	const uint32 NumRoundTrips = 100000;
+	const uint32 QueueCapacity = 1024;
+	const uint32 BatchSize = 64;
+
+	void Pin(uint32 core)
+	{
+		if (!Platform::PinThreadToCore(core))
+		{
+			std::cout << "failed to pin to core " << core << std::endl;
+		}
+	}
+
+	// Pushes the values 1 to NumItems split over the producers, and pops
+	// them with the consumers. Producer and consumer i are pinned to the
+	// given cores plus 2 * i. Returns the time in nanoseconds.
+	template<typename Q>
+	f64 RunThroughput(Q& queue, uint32 numProducers, uint32 numConsumers, uint32 batchSize, uint32 producerCore, uint32 consumerCore)
+	{
+		const uint32 numCores = Platform::GetNumCores();
+		Atomic<uint64> checksum(0);
+		std::vector<std::thread> threads;
+		const uint64 start = Platform::GetTicks();
+		for (uint32 p = 0; p < numProducers; ++p)
+		{
+			threads.emplace_back([&queue, p, numProducers, batchSize, core = (producerCore + 2 * p) % numCores]() {
+				Pin(core);
+				Array<uint64> batch(batchSize);
+				for (uint32 i = p + 1; i <= NumItems; )
+				{
+					batch.Reset();
+					for (; batch.Num() < batchSize && i <= NumItems; i += numProducers)
+					{
+						batch.Add(i);
+					}
+					uint32 numPushed = 0;
+					SpinWait wait;
+					while (numPushed < batch.Num())
+					{
+						const uint32 pushed = batchSize == 1
+							? (queue.Push(batch[0]) ? 1 : 0)
+							: queue.PushN(ArrayView<uint64>(batch.GetData() + numPushed, batch.Num() - numPushed));
+						numPushed += pushed;
+						if (pushed == 0)
+						{
+							wait.Wait();
+						}
+					}
+				}
+			});
+		}
+		Atomic<uint32> numPopped(0);
+		for (uint32 c = 0; c < numConsumers; ++c)
+		{
+			threads.emplace_back([&queue, &numPopped, &checksum, batchSize, core = (consumerCore + 2 * c) % numCores]() {
+				Pin(core);
+				uint64 items[BatchSize];
+				uint64 sum = 0;
+				SpinWait wait;
+				while (numPopped.Load(EMemoryOrder::Relaxed) < NumItems)
+				{
+					const uint32 popped = batchSize == 1
+						? (queue.Pop(items[0]) ? 1 : 0)
+						: queue.PopN(items, batchSize);
+					for (uint32 i = 0; i < popped; ++i)
+					{
+						sum += items[i];
+					}
+					if (popped == 0)
+					{
+						wait.Wait();
+					}
+					else
+					{
+						numPopped.FetchAdd(popped, EMemoryOrder::Relaxed);
+						wait = SpinWait();
+					}
+				}
+				checksum.FetchAdd(sum);
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		const f64 ns = TicksToNanoseconds(Platform::GetTicks() - start);
+		CHECK(checksum.Load() == uint64(NumItems) * (NumItems + 1) / 2);
+		return ns;
+	}
+
+	// Sends a value back and forth over two queues, returns the time of
+	// one round trip in nanoseconds
+	template<typename Q>
+	f64 RunPingPong(uint32 coreA, uint32 coreB)
+	{
+		Q ping(QueueCapacity);
+		Q pong(QueueCapacity);
+		std::thread echo([&ping, &pong, coreB]() {
+			Pin(coreB);
+			for (uint32 i = 0; i < NumRoundTrips; ++i)
+			{
+				uint64 value;
+				SpinWait wait;
+				while (!ping.Pop(value))
+				{
+					wait.Wait();
+				}
+				while (!pong.Push(value + 1))
+				{
+					wait.Wait();
+				}
+			}
+		});
+		f64 ns = 0.0;
+		uint64 value = 0;
+		std::thread send([&ping, &pong, &ns, &value, coreA]() {
+			Pin(coreA);
+			const uint64 start = Platform::GetTicks();
+			for (uint32 i = 0; i < NumRoundTrips; ++i)
+			{
+				SpinWait wait;
+				while (!ping.Push(value))
+				{
+					wait.Wait();
+				}
+				while (!pong.Pop(value))
+				{
+					wait.Wait();
+				}
+			}
+			ns = TicksToNanoseconds(Platform::GetTicks() - start);
+		});
+		send.join();
+		echo.join();
+		CHECK(value == NumRoundTrips);
+		return ns / NumRoundTrips;
+	}
+}
+
+void BenchQueue()
+{
+	const uint32 numCores = Platform::GetNumCores();
+	std::cout << "cores " << numCores << std::endl;
+
+	// Neighbouring cores, which often share a cache, and the first and
+	// last core, which are usually the furthest apart
+	Array<uint32> pairs;
+	if (numCores == 1)
+	{
+		std::cout << "one core, both threads of a pair share it" << std::endl;
+		pairs.Add(0);
+		pairs.Add(0);
+	}
+	else
+	{
+		pairs.Add(0);
+		pairs.Add(1);
+		if (numCores > 2)
+		{
+			pairs.Add(0);
+			pairs.Add(numCores - 1);
+		}
+	}
+
+	for (uint32 pair = 0; pair < pairs.Num(); pair += 2)
+	{
+		const uint32 coreA = pairs[pair];
+		const uint32 coreB = pairs[pair + 1];
+		const f64 numItems = NumItems;
+
+		SpscQueue<uint64> spsc(QueueCapacity);
+		const f64 spscNs = RunThroughput(spsc, 1, 1, 1, coreA, coreB);
+		const f64 spscBatchNs = RunThroughput(spsc, 1, 1, BatchSize, coreA, coreB);
+		MpmcQueue<uint64> mpmc(QueueCapacity);
+		const f64 mpmcNs = RunThroughput(mpmc, 1, 1, 1, coreA, coreB);
+		const f64 mpmcBatchNs = RunThroughput(mpmc, 1, 1, BatchSize, coreA, coreB);
+
+		std::cout << "cores " << coreA << " -> " << coreB << std::endl
+			<< "\tSPSC  " << numItems * 1000.0 / spscNs << " Mitems/s\tbatched " << numItems * 1000.0 / spscBatchNs
+			<< " Mitems/s\tround trip " << RunPingPong<SpscQueue<uint64>>(coreA, coreB) << " ns" << std::endl
+			<< "\tMPMC  " << numItems * 1000.0 / mpmcNs << " Mitems/s\tbatched " << numItems * 1000.0 / mpmcBatchNs
+			<< " Mitems/s\tround trip " << RunPingPong<MpmcQueue<uint64>>(coreA, coreB) << " ns" << std::endl;
+	}
+
+	// Contended MPMC, producers on the even cores and consumers on the odd ones
+	const uint32 threadCounts[] = { 2, 4, 8 };
+	for (uint32 numThreads : threadCounts)
+	{
+		MpmcQueue<uint64> mpmc(QueueCapacity);
+		const f64 ns = RunThroughput(mpmc, numThreads, numThreads, BatchSize, 0, 1);
+		std::cout << "MPMC " << numThreads << " producers " << numThreads << " consumers, batched "
+			<< f64(NumItems) * 1000.0 / ns << " Mitems/s" << std::endl;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/RadixTree.h"
+#include "Random.h"
+
+static void AppendText(Array<char8>& chars, const char8* text)
+{
+	for (; *text != '\0'; ++text)
+	{
+		chars.Add(*text);
+	}
+}
+
+// Builds asset-like paths such as "Game/Forest/Textures/T_Forest_04172",
+// which share long prefixes and fan out at every directory level.
+static void MakeAssetPaths(uint32 num, Random::RandState& rand, Array<char8>& chars, Array<uint32>& ends)
+{
+	const char8* areas[] = { "Characters", "Forest", "Desert", "City", "Dungeon", "Harbor", "Castle", "Swamp",
+		"Mountain", "Village", "Ruins", "Caves", "Tundra", "Jungle", "Island", "Shared" };
+	const char8* kinds[] = { "Textures", "Meshes", "Materials", "Sounds", "Animations", "Particles", "Blueprints", "Levels" };
+	const char8* prefixes[] = { "T_", "SM_", "M_", "S_", "A_", "P_", "BP_", "L_" };
+	
+	for (uint32 i = 0; i < num; ++i)
+	{
+		const uint32 area = rand.RandU32() % ARRAY_COUNT(areas);
+		const uint32 kind = rand.RandU32() % ARRAY_COUNT(kinds);
+		AppendText(chars, "Game/");
+		AppendText(chars, areas[area]);
+		chars.Add('/');
+		AppendText(chars, kinds[kind]);
+		chars.Add('/');
+		AppendText(chars, prefixes[kind]);
+		AppendText(chars, areas[area]);
+		chars.Add('_');
+		// Unique per path, so no two paths are equal
+		for (uint32 n = i, digit = 0; digit < 7; ++digit, n /= 10)
+		{
+			chars.Add(char8('0' + n % 10));
+		}
+		ends.Add(chars.Num());
+	}
+}
+
+// Looks up hexadecimal keys in a tree small enough to stay in cache.
+// With 16 symbols per byte almost every inner node is a Node16, so this
+// mostly measures its key search.
+static void BenchNode16Find(Random::RandState& rand)
+{
+	const uint32 numKeys = 4096;
+	const uint32 keyLength = 8;
+	const uint32 numLookups = 1000000;
+	const char8* digits = "0123456789abcdef";
+	
+	Array<char8> chars(numKeys * keyLength);
+	for (uint32 i = 0; i < numKeys * keyLength; ++i)
+	{
+		chars.Add(digits[rand.RandU32() & 15]);
+	}
+	RadixTree<uint32> tree;
+	for (uint32 i = 0; i < numKeys; ++i)
+	{
+		tree.FindOrAdd(StringView(chars.GetData() + i * keyLength, keyLength)) = 1;
+	}
+	Array<StringView> keys(numLookups);
+	for (uint32 i = 0; i < numLookups; ++i)
+	{
+		keys.Add(StringView(chars.GetData() + (rand.RandU32() % numKeys) * keyLength, keyLength));
+	}
+	
+	uint64 sum = 0;
+	const uint64 start = Platform::GetTicks();
+	for (uint32 i = 0; i < numLookups; ++i)
+	{
+		sum += *tree.Find(keys[i]);
+	}
+	const f64 findNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	if (sum != numLookups)
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	std::cout << tree.Num() << " hex keys" << std::endl
+		<< "	find     " << findNs / numLookups << " ns" << std::endl;
+}
+
+// Adds 1M asset-like paths to a RadixTree, looks them up in random
+// order, and visits everything below a directory with a prefix query.
+// Then times lookups that mostly search Node16 keys.
+void BenchRadixTree()
+{
+	const uint32 numKeys = 1000000;
+	
+	Random::RandState rand;
+	rand.Seed(0x4AD1);
+	
+	// The tree doesn't copy its keys, so they all live in one buffer that
+	// is filled before the first view into it is taken.
+	Array<char8> chars;
+	Array<uint32> ends(numKeys);
+	MakeAssetPaths(numKeys, rand, chars, ends);
+	Array<StringView> keys(numKeys);
+	for (uint32 i = 0; i < numKeys; ++i)
+	{
+		const uint32 begin = i == 0 ? 0 : ends[i - 1];
+		keys.Add(StringView(chars.GetData() + begin, ends[i] - begin));
+	}
+	
+	RadixTree<uint32> tree;
+	uint64 start = Platform::GetTicks();
+	for (uint32 i = 0; i < numKeys; ++i)
+	{
+		tree.Add(keys[i]) = i;
+	}
+	const f64 addNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	Array<uint32> order(numKeys);
+	for (uint32 i = 0; i < numKeys; ++i)
+	{
+		order.Add(rand.RandU32() % numKeys);
+	}
+	uint64 sum = 0;
+	uint64 expectedSum = 0;
+	start = Platform::GetTicks();
+	for (uint32 i = 0; i < numKeys; ++i)
+	{
+		sum += *tree.Find(keys[order[i]]);
+	}
+	const f64 findNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	for (uint32 i = 0; i < numKeys; ++i)
+	{
+		expectedSum += order[i];
+	}
+	
+	const StringView prefix("Game/Forest/Textures/");
+	uint32 numPrefixed = 0;
+	start = Platform::GetTicks();
+	tree.ForEachWithPrefix(prefix, [&numPrefixed](StringView, uint32&) {
+		++numPrefixed;
+	});
+	const f64 prefixNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	if (tree.Num() != numKeys || sum != expectedSum)
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	
+	std::cout << numKeys << " asset paths" << std::endl
+		<< "\tadd      " << addNs / numKeys << " ns" << std::endl
+		<< "\tfind     " << findNs / numKeys << " ns" << std::endl
+		<< "\tprefix   " << prefixNs / 1000000.0 << " ms for " << numPrefixed << " keys" << std::endl;
+	
+	BenchNode16Find(rand);
+}
\ No newline at end of file
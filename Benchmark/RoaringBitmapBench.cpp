@@ -0,0 +1,146 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/BitArray.h"
+#include "Containers/RoaringBitmap.h"
+#include "Containers/Set.h"
+#include "Random.h"
+
+// Compares a RoaringBitmap against a Set and a plain BitArray over the
+// same values at several densities of a 2^24 universe. Reports the time
+// to build, to look up random values and to union two sets, and the
+// memory the bitmaps use. Also times the Roaring intersection with an
+// equally large set and with one 64 times smaller.
+void BenchRoaringBitmap()
+{
+	const uint32 universe = 1 << 24;
+	const uint32 numLookups = 1000000;
+	const f64 densities[] = { 0.001, 0.01, 0.1, 0.5 };
+	
+	Random::RandState rand;
+	rand.Seed(0x2EA1);
+	
+	Array<uint32> keys(numLookups);
+	for (uint32 i = 0; i < numLookups; ++i)
+	{
+		keys.Add(rand.RandU32() % universe);
+	}
+	
+	for (f64 density : densities)
+	{
+		const uint32 numValues = uint32(universe * density);
+		Array<uint32> values(numValues);
+		Array<uint32> otherValues(numValues);
+		for (uint32 i = 0; i < numValues; ++i)
+		{
+			values.Add(rand.RandU32() % universe);
+			otherValues.Add(rand.RandU32() % universe);
+		}
+		
+		uint64 start = Platform::GetTicks();
+		Set<uint32> set;
+		Set<uint32> otherSet;
+		for (uint32 i = 0; i < numValues; ++i)
+		{
+			set.Add(values[i]);
+			otherSet.Add(otherValues[i]);
+		}
+		const f64 setBuildNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		start = Platform::GetTicks();
+		BitArray bits;
+		BitArray otherBits;
+		bits.SetBitCount(universe);
+		otherBits.SetBitCount(universe);
+		for (uint32 i = 0; i < numValues; ++i)
+		{
+			bits.SetBit(values[i]);
+			otherBits.SetBit(otherValues[i]);
+		}
+		const f64 bitsBuildNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		start = Platform::GetTicks();
+		RoaringBitmap roaring;
+		RoaringBitmap otherRoaring;
+		for (uint32 i = 0; i < numValues; ++i)
+		{
+			roaring.Add(values[i]);
+			otherRoaring.Add(otherValues[i]);
+		}
+		const f64 roaringBuildNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		uint64 setHits = 0;
+		start = Platform::GetTicks();
+		for (uint32 i = 0; i < numLookups; ++i)
+		{
+			setHits += set.Contains(keys[i]);
+		}
+		const f64 setFindNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		uint64 bitsHits = 0;
+		start = Platform::GetTicks();
+		for (uint32 i = 0; i < numLookups; ++i)
+		{
+			bitsHits += bits.GetBit(keys[i]);
+		}
+		const f64 bitsFindNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		uint64 roaringHits = 0;
+		start = Platform::GetTicks();
+		for (uint32 i = 0; i < numLookups; ++i)
+		{
+			roaringHits += roaring.Contains(keys[i]);
+		}
+		const f64 roaringFindNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		RoaringBitmap sparseRoaring;
+		for (uint32 i = 0; i < numValues / 64; ++i)
+		{
+			sparseRoaring.Add(otherValues[i]);
+		}
+		RoaringBitmap intersection(roaring);
+		RoaringBitmap sparseIntersection(roaring);
+		start = Platform::GetTicks();
+		intersection.And(otherRoaring);
+		const f64 intersectNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		start = Platform::GetTicks();
+		sparseIntersection.And(sparseRoaring);
+		const f64 sparseIntersectNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		start = Platform::GetTicks();
+		for (uint32 i = 0; i < numValues; ++i)
+		{
+			set.Add(otherValues[i]);
+		}
+		const f64 setUnionNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		start = Platform::GetTicks();
+		bits.Or(otherBits);
+		const f64 bitsUnionNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		start = Platform::GetTicks();
+		roaring.Or(otherRoaring);
+		const f64 roaringUnionNs = TicksToNanoseconds(Platform::GetTicks() - start);
+		
+		if (setHits != roaringHits || bitsHits != roaringHits ||
+			set.Num() != roaring.GetCardinality() || bits.PopCount() != roaring.GetCardinality())
+		{
+			std::cout << "mismatch" << std::endl;
+		}
+		
+		std::cout << "density " << density << " (" << numValues << " values)" << std::endl
+			<< "\tbuild  Set " << setBuildNs / numValues << " ns\tBitArray " << bitsBuildNs / numValues
+			<< " ns\tRoaring " << roaringBuildNs / numValues << " ns" << std::endl
+			<< "\tfind   Set " << setFindNs / numLookups << " ns\tBitArray " << bitsFindNs / numLookups
+			<< " ns\tRoaring " << roaringFindNs / numLookups << " ns" << std::endl
+			<< "\tunion  Set " << setUnionNs / 1000000.0 << " ms\tBitArray " << bitsUnionNs / 1000000.0
+			<< " ms\tRoaring " << roaringUnionNs / 1000000.0 << " ms" << std::endl
+			<< "\tand    Roaring " << intersectNs / 1000000.0 << " ms\t1/64 as large " << sparseIntersectNs / 1000000.0
+			<< " ms (" << intersection.GetCardinality() + sparseIntersection.GetCardinality() << " values)" << std::endl
+			<< "\tmemory BitArray " << bits.GetWordCount() * sizeof(uint64) / 1024
+			<< " KiB\tRoaring " << roaring.GetNumBytes() / 1024 << " KiB" << std::endl;
+	}
+}
\ No newline at end of file
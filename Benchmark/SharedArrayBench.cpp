@@ -0,0 +1,107 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/Array.h"
+#include "Containers/SharedArray.h"
+#include "Random.h"
+
+// Simulates an undo stack: an array of 2^20 values is snapshotted and
+// then changed in a few random places, over and over. Compares deep
+// copying an Array, a copy-on-write SharedArray and a chunked
+// PersistentArray, and reads every snapshot back to check them.
+void BenchSharedArray()
+{
+	const uint32 num = 1 << 20;
+	const uint32 numSnapshots = 200;
+	const uint32 editsPerSnapshot = 16;
+	
+	Random::RandState rand;
+	rand.Seed(0x5A4E);
+	
+	Array<uint32> edits(numSnapshots * editsPerSnapshot);
+	for (uint32 i = 0; i < numSnapshots * editsPerSnapshot; ++i)
+	{
+		edits.Add(rand.RandU32() % num);
+	}
+	Array<uint32> initial(num);
+	for (uint32 i = 0; i < num; ++i)
+	{
+		initial.Add(i);
+	}
+	
+	uint64 start = Platform::GetTicks();
+	Array<Array<uint32>> arraySnapshots(numSnapshots);
+	{
+		Array<uint32> current(initial);
+		for (uint32 s = 0; s < numSnapshots; ++s)
+		{
+			arraySnapshots.Add(current);
+			for (uint32 e = 0; e < editsPerSnapshot; ++e)
+			{
+				current[edits[s * editsPerSnapshot + e]] = s;
+			}
+		}
+	}
+	const f64 arrayNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	Array<SharedArray<uint32>> sharedSnapshots(numSnapshots);
+	{
+		SharedArray<uint32> current(initial.View());
+		for (uint32 s = 0; s < numSnapshots; ++s)
+		{
+			sharedSnapshots.Add(current);
+			for (uint32 e = 0; e < editsPerSnapshot; ++e)
+			{
+				current.Set(edits[s * editsPerSnapshot + e], s);
+			}
+		}
+	}
+	const f64 sharedNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	Array<PersistentArray<uint32>> persistentSnapshots(numSnapshots);
+	{
+		PersistentArray<uint32> current(initial.View());
+		for (uint32 s = 0; s < numSnapshots; ++s)
+		{
+			persistentSnapshots.Add(current);
+			for (uint32 e = 0; e < editsPerSnapshot; ++e)
+			{
+				current.Set(edits[s * editsPerSnapshot + e], s);
+			}
+		}
+	}
+	const f64 persistentNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	uint64 arraySum = 0;
+	uint64 sharedSum = 0;
+	uint64 persistentSum = 0;
+	for (uint32 s = 0; s < numSnapshots; s += 17)
+	{
+		for (uint32 i = 0; i < num; i += 61)
+		{
+			arraySum += arraySnapshots[s][i];
+			sharedSum += sharedSnapshots[s][i];
+			persistentSum += persistentSnapshots[s][i];
+		}
+	}
+	if (arraySum != sharedSum || arraySum != persistentSum)
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	
+	// Every Array and SharedArray snapshot owns a full copy, the
+	// persistent ones share all chunks that weren't edited.
+	const uint64 fullBytes = uint64(numSnapshots) * num * sizeof(uint32);
+	const uint64 persistentBytes = uint64(numSnapshots) * ((num / PersistentArray<uint32>::ChunkSize) * sizeof(SharedArray<uint32>)
+		+ editsPerSnapshot * PersistentArray<uint32>::ChunkSize * sizeof(uint32));
+	
+	std::cout << numSnapshots << " snapshots of " << num << " values, " << editsPerSnapshot << " edits each" << std::endl
+		<< "\tArray       " << arrayNs / numSnapshots / 1000.0 << " us/snapshot\t" << fullBytes / (1024 * 1024) << " MiB" << std::endl
+		<< "\tSharedArray " << sharedNs / numSnapshots / 1000.0 << " us/snapshot\t" << fullBytes / (1024 * 1024) << " MiB" << std::endl
+		<< "\tPersistent  " << persistentNs / numSnapshots / 1000.0 << " us/snapshot\t<= " << persistentBytes / (1024 * 1024) << " MiB" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/Array.h"
+#include "Containers/SpatialHashGrid.h"
+#include "Random.h"
+
+static f32 RandomInRange(Random::RandState& rand, f32 min, f32 max)
+{
+	return min + (max - min) * f32(rand.RandU32() & 0xFFFFFF) / f32(0x1000000);
+}
+
+static SpatialPoint RandomPoint(Random::RandState& rand)
+{
+	return SpatialPoint{ RandomInRange(rand, 0.0f, 2000.0f), RandomInRange(rand, 0.0f, 2000.0f), RandomInRange(rand, 0.0f, 100.0f) };
+}
+
+static f32 DistanceSquared(const SpatialPoint& a, const SpatialPoint& b)
+{
+	const f32 dx = a.X - b.X;
+	const f32 dy = a.Y - b.Y;
+	const f32 dz = a.Z - b.Z;
+	return dx * dx + dy * dy + dz * dz;
+}
+
+// Spreads entities over a 2000x2000x100 world and compares sphere and
+// nearest neighbour queries on a SpatialHashGrid against scanning every
+// position, the way gameplay code does without a broad-phase. Also
+// reports the cost of the per frame rebuild.
+void BenchSpatialHashGrid()
+{
+	const uint32 numEntities = 100000;
+	const uint32 numQueries = 10000;
+	const uint32 numBruteForceQueries = 500;
+	const uint32 numFrames = 20;
+	const f32 radius = 10.0f;
+	
+	Random::RandState rand;
+	rand.Seed(0x6A1D);
+	
+	Array<SpatialPoint> positions(numEntities);
+	Array<uint32> entities(numEntities);
+	for (uint32 i = 0; i < numEntities; ++i)
+	{
+		positions.Add(RandomPoint(rand));
+		entities.Add(i);
+	}
+	Array<SpatialPoint> queries(numQueries);
+	for (uint32 i = 0; i < numQueries; ++i)
+	{
+		queries.Add(RandomPoint(rand));
+	}
+	
+	SpatialHashGrid<uint32> grid(radius);
+	grid.Rebuild(positions.View(), entities.View());
+	uint64 start = Platform::GetTicks();
+	for (uint32 frame = 0; frame < numFrames; ++frame)
+	{
+		// Jitter a few entities so every frame sorts slightly different data
+		positions[frame * 7].X += 1.0f;
+		grid.Rebuild(positions.View(), entities.View());
+	}
+	const f64 rebuildNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	uint64 bruteHits = 0;
+	start = Platform::GetTicks();
+	for (uint32 q = 0; q < numBruteForceQueries; ++q)
+	{
+		for (uint32 i = 0; i < numEntities; ++i)
+		{
+			bruteHits += DistanceSquared(positions[i], queries[q]) <= radius * radius;
+		}
+	}
+	const f64 bruteSphereNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	uint64 gridHits = 0;
+	uint64 gridHitsSubset = 0;
+	start = Platform::GetTicks();
+	for (uint32 q = 0; q < numQueries; ++q)
+	{
+		grid.ForEachInSphere(queries[q], radius, [&gridHits](const uint32&, const SpatialPoint&) { ++gridHits; });
+		if (q + 1 == numBruteForceQueries)
+		{
+			gridHitsSubset = gridHits;
+		}
+	}
+	const f64 gridSphereNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	uint64 bruteNearestSum = 0;
+	start = Platform::GetTicks();
+	for (uint32 q = 0; q < numBruteForceQueries; ++q)
+	{
+		f32 best = 4.0f * radius * radius;
+		uint32 bestIndex = INVALID_INDEX;
+		for (uint32 i = 0; i < numEntities; ++i)
+		{
+			const f32 distance = DistanceSquared(positions[i], queries[q]);
+			if (distance < best)
+			{
+				best = distance;
+				bestIndex = i;
+			}
+		}
+		bruteNearestSum += bestIndex;
+	}
+	const f64 bruteNearestNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	Array<uint32> nearest(numQueries);
+	start = Platform::GetTicks();
+	grid.FindNearest(queries.View(), 2.0f * radius, nearest);
+	const f64 gridNearestNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	uint64 gridNearestSum = 0;
+	for (uint32 q = 0; q < numBruteForceQueries; ++q)
+	{
+		gridNearestSum += nearest[q];
+	}
+	
+	if (bruteHits != gridHitsSubset || bruteNearestSum != gridNearestSum)
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	
+	std::cout << numEntities << " entities, radius " << radius << ", " << gridHits / f64(numQueries) << " hits per sphere" << std::endl
+		<< "\trebuild            " << rebuildNs / numFrames / 1000000.0 << " ms" << std::endl
+		<< "\tsphere   brute " << bruteSphereNs / numBruteForceQueries / 1000.0 << " us\tgrid " << gridSphereNs / numQueries / 1000.0 << " us" << std::endl
+		<< "\tnearest  brute " << bruteNearestNs / numBruteForceQueries / 1000.0 << " us\tgrid " << gridNearestNs / numQueries / 1000.0 << " us" << std::endl;
+}
\ No newline at end of file
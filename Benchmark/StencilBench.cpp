@@ -0,0 +1,245 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/Array.h"
+#include "Containers/MortonArray.h"
+#include "Containers/View/ArrayView2D.h"
+#include "Containers/View/ArrayView3D.h"
+#include "Random.h"
+
+static const uint32 NumPasses = 4;
+static const uint32 TileWidth = 512;
+static const uint32 TileHeight = 64;
+
+static void Stencil2DRows(ArrayView2D<const f32> in, ArrayView2D<f32> out, uint32 x0, uint32 y0, uint32 width, uint32 height)
+{
+	for (uint32 y = y0; y < y0 + height; ++y)
+	{
+		const f32* up = in.Row(y - 1);
+		const f32* row = in.Row(y);
+		const f32* down = in.Row(y + 1);
+		f32* result = out.Row(y);
+		for (uint32 x = x0; x < x0 + width; ++x)
+		{
+			result[x] = 0.2f * (row[x] + row[x - 1] + row[x + 1] + up[x] + down[x]);
+		}
+	}
+}
+
+// The same pass with the loops swapped, so every step jumps a whole row
+static void Stencil2DColumns(ArrayView2D<const f32> in, ArrayView2D<f32> out)
+{
+	const uint32 stride = in.Stride();
+	const f32* cells = in.Data();
+	f32* result = out.Data();
+	for (uint32 x = 1; x + 1 < in.Width(); ++x)
+	{
+		for (uint32 y = 1; y + 1 < in.Height(); ++y)
+		{
+			const uint64 i = uint64(y) * stride + x;
+			result[i] = 0.2f * (cells[i] + cells[i - 1] + cells[i + 1] + cells[i - stride] + cells[i + stride]);
+		}
+	}
+}
+
+static void Stencil3DRows(ArrayView3D<const f32> in, ArrayView3D<f32> out, uint32 x0, uint32 y0, uint32 z0, uint32 width, uint32 height, uint32 depth)
+{
+	for (uint32 z = z0; z < z0 + depth; ++z)
+	{
+		for (uint32 y = y0; y < y0 + height; ++y)
+		{
+			const f32* row = in.Row(y, z);
+			const f32* up = in.Row(y - 1, z);
+			const f32* down = in.Row(y + 1, z);
+			const f32* front = in.Row(y, z - 1);
+			const f32* back = in.Row(y, z + 1);
+			f32* result = out.Row(y, z);
+			for (uint32 x = x0; x < x0 + width; ++x)
+			{
+				result[x] = (1.0f / 7.0f) * (row[x] + row[x - 1] + row[x + 1] + up[x] + down[x] + front[x] + back[x]);
+			}
+		}
+	}
+}
+
+static f64 Checksum(const Array<f32>& values)
+{
+	f64 sum = 0.0;
+	for (uint32 i = 0; i < values.Num(); ++i)
+	{
+		sum += values[i];
+	}
+	return sum;
+}
+
+static void PrintResult(const char* name, f64 ns, uint64 numCells)
+{
+	std::cout << "\t" << name << "\t" << ns / (f64(numCells) * NumPasses) << " ns/cell" << std::endl;
+}
+
+// Runs a 5 point blur over a 4096^2 heightfield, row by row, column by
+// column, in 512x64 tiles and on Morton ordered storage.
+static void BenchStencil2D(Random::RandState& rand)
+{
+	const uint32 size = 4096;
+	const uint64 numCells = uint64(size - 2) * (size - 2);
+	
+	Array<f32> input(size * size);
+	for (uint32 i = 0; i < size * size; ++i)
+	{
+		input.Add(f32(rand.RandU32() & 0xFFFF));
+	}
+	Array<f32> rowOutput(input);
+	Array<f32> tiledOutput(input);
+	Array<f32> mortonOutput(input);
+	
+	ArrayView2D<const f32> in(input.GetData(), size, size);
+	
+	uint64 start = Platform::GetTicks();
+	for (uint32 pass = 0; pass < NumPasses; ++pass)
+	{
+		Stencil2DRows(in, ArrayView2D<f32>(rowOutput, size, size), 1, 1, size - 2, size - 2);
+	}
+	const f64 rowNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	Array<f32> columnOutput(input);
+	start = Platform::GetTicks();
+	for (uint32 pass = 0; pass < NumPasses; ++pass)
+	{
+		Stencil2DColumns(in, ArrayView2D<f32>(columnOutput, size, size));
+	}
+	const f64 columnNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	for (uint32 pass = 0; pass < NumPasses; ++pass)
+	{
+		ArrayView2D<f32> out(tiledOutput, size, size);
+		out.Slice(1, 1, size - 2, size - 2).ForEachTile(TileWidth, TileHeight,
+			[&](const ArrayView2D<f32>& tile, uint32 x, uint32 y) {
+				Stencil2DRows(in, out, x + 1, y + 1, tile.Width(), tile.Height());
+			});
+	}
+	const f64 tiledNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	// A square power of two grid is a single tile, so every slot index is
+	// the Morton code of its cell
+	MortonArray2D<f32> mortonIn(size, size);
+	MortonArray2D<f32> mortonOut(size, size);
+	mortonIn.CopyFrom(in);
+	mortonOut.CopyFrom(in);
+	start = Platform::GetTicks();
+	for (uint32 pass = 0; pass < NumPasses; ++pass)
+	{
+		const f32* cells = mortonIn.GetData();
+		f32* result = mortonOut.GetData();
+		for (uint32 i = 0; i < mortonIn.GetNumSlots(); ++i)
+		{
+			uint32 x, y;
+			Morton::Decode2(i, x, y);
+			if (x - 1 >= size - 2 || y - 1 >= size - 2)
+				continue;
+			result[i] = 0.2f * (cells[i] + cells[Morton::Decrement(i, Morton::MaskX2)] + cells[Morton::Increment(i, Morton::MaskX2)]
+				+ cells[Morton::Decrement(i, Morton::MaskY2)] + cells[Morton::Increment(i, Morton::MaskY2)]);
+		}
+	}
+	const f64 mortonNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	mortonOut.CopyTo(ArrayView2D<f32>(mortonOutput, size, size));
+	
+	const f64 checksum = Checksum(rowOutput);
+	if (checksum != Checksum(columnOutput) || checksum != Checksum(tiledOutput) || checksum != Checksum(mortonOutput))
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	
+	std::cout << "2D 5 point, " << size << "^2 f32" << std::endl;
+	PrintResult("rows   ", rowNs, numCells);
+	PrintResult("columns", columnNs, numCells);
+	PrintResult("tiled  ", tiledNs, numCells);
+	PrintResult("Morton ", mortonNs, numCells);
+}
+
+// Runs a 7 point blur over a 256^3 voxel grid, row by row, in tiles of
+// full rows by 32x32 and on Morton ordered storage.
+static void BenchStencil3D(Random::RandState& rand)
+{
+	const uint32 size = 256;
+	const uint32 total = size * size * size;
+	const uint64 numCells = uint64(size - 2) * (size - 2) * (size - 2);
+	
+	Array<f32> input(total);
+	for (uint32 i = 0; i < total; ++i)
+	{
+		input.Add(f32(rand.RandU32() & 0xFFFF));
+	}
+	Array<f32> rowOutput(input);
+	Array<f32> tiledOutput(input);
+	Array<f32> mortonOutput(input);
+	
+	ArrayView3D<const f32> in(input.GetData(), size, size, size);
+	
+	uint64 start = Platform::GetTicks();
+	for (uint32 pass = 0; pass < NumPasses; ++pass)
+	{
+		Stencil3DRows(in, ArrayView3D<f32>(rowOutput, size, size, size), 1, 1, 1, size - 2, size - 2, size - 2);
+	}
+	const f64 rowNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	for (uint32 pass = 0; pass < NumPasses; ++pass)
+	{
+		ArrayView3D<f32> out(tiledOutput, size, size, size);
+		out.Slice(1, 1, 1, size - 2, size - 2, size - 2).ForEachTile(size, TileHeight / 2, TileHeight / 2,
+			[&](const ArrayView3D<f32>& tile, uint32 x, uint32 y, uint32 z) {
+				Stencil3DRows(in, out, x + 1, y + 1, z + 1, tile.Width(), tile.Height(), tile.Depth());
+			});
+	}
+	const f64 tiledNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	// A single tile like in the 2D pass
+	MortonArray3D<f32> mortonIn(size, size, size);
+	MortonArray3D<f32> mortonOut(size, size, size);
+	mortonIn.CopyFrom(in);
+	mortonOut.CopyFrom(in);
+	start = Platform::GetTicks();
+	for (uint32 pass = 0; pass < NumPasses; ++pass)
+	{
+		const f32* cells = mortonIn.GetData();
+		f32* result = mortonOut.GetData();
+		for (uint32 i = 0; i < mortonIn.GetNumSlots(); ++i)
+		{
+			uint32 x, y, z;
+			Morton::Decode3(i, x, y, z);
+			if (x - 1 >= size - 2 || y - 1 >= size - 2 || z - 1 >= size - 2)
+				continue;
+			result[i] = (1.0f / 7.0f) * (cells[i] + cells[Morton::Decrement(i, Morton::MaskX3)] + cells[Morton::Increment(i, Morton::MaskX3)]
+				+ cells[Morton::Decrement(i, Morton::MaskY3)] + cells[Morton::Increment(i, Morton::MaskY3)]
+				+ cells[Morton::Decrement(i, Morton::MaskZ3)] + cells[Morton::Increment(i, Morton::MaskZ3)]);
+		}
+	}
+	const f64 mortonNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	mortonOut.CopyTo(ArrayView3D<f32>(mortonOutput, size, size, size));
+	
+	const f64 checksum = Checksum(rowOutput);
+	if (checksum != Checksum(tiledOutput) || checksum != Checksum(mortonOutput))
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	
+	std::cout << "3D 7 point, " << size << "^3 f32" << std::endl;
+	PrintResult("rows   ", rowNs, numCells);
+	PrintResult("tiled  ", tiledNs, numCells);
+	PrintResult("Morton ", mortonNs, numCells);
+}
+
+// Compares neighbourhood passes in row-major order, in cache sized tiles
+// and over Morton ordered storage.
+void BenchStencil()
+{
+	Random::RandState rand;
+	rand.Seed(0x57E0);
+	BenchStencil2D(rand);
+	BenchStencil3D(rand);
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+
+#include "Benchmarks.h"
+#include "Containers/Array.h"
+#include "Delegate.h"
+#include "Random.h"
+#include "TimerWheel.h"
+
+struct BenchTimer {
+	TimerWheel* Wheel;
+	uint64* Frame;
+	uint64 Deadline;
+	uint32 State;
+	uint32 NumFired;
+};
+
+// Every timer picks its next delay from its own state, so both runs see
+// the same deadlines.
+static uint64 NextDelay(BenchTimer& timer)
+{
+	timer.State = timer.State * 1664525 + 1013904223;
+	return 1 + (timer.State >> 8) % 600;
+}
+
+static void PollTimer(void* context)
+{
+	BenchTimer& timer = *static_cast<BenchTimer*>(context);
+	if (*timer.Frame < timer.Deadline)
+	{
+		return;
+	}
+	++timer.NumFired;
+	timer.Deadline = *timer.Frame + NextDelay(timer);
+}
+
+static void FireTimer(void* context)
+{
+	BenchTimer& timer = *static_cast<BenchTimer*>(context);
+	++timer.NumFired;
+	timer.Wheel->ScheduleAfter(NextDelay(timer), &FireTimer, &timer);
+}
+
+// Runs cooldown like timers that reschedule themselves with a delay of
+// up to 10 seconds at 60 frames per second, once by invoking a Delegate
+// every frame and letting callbacks that aren't due return early, and
+// once on a TimerWheel that only calls the timers that are due.
+void BenchTimerWheel()
+{
+	const uint32 numTimers = 200000;
+	const uint32 numFrames = 600;
+	const uint32 numCancels = 1000;
+	
+	Random::RandState rand;
+	rand.Seed(0x71E5);
+	Array<uint32> seeds(numTimers);
+	for (uint32 i = 0; i < numTimers; ++i)
+	{
+		seeds.Add(rand.RandU32());
+	}
+	
+	uint64 frame = 0;
+	TimerWheel wheel;
+	Array<BenchTimer> polled(numTimers);
+	Array<BenchTimer> wheeled(numTimers);
+	for (uint32 i = 0; i < numTimers; ++i)
+	{
+		polled.Add(BenchTimer{ nullptr, &frame, 0, seeds[i], 0 });
+		polled[i].Deadline = NextDelay(polled[i]);
+		wheeled.Add(BenchTimer{ &wheel, &frame, 0, seeds[i], 0 });
+	}
+	
+	Delegate delegate;
+	for (uint32 i = 0; i < numTimers; ++i)
+	{
+		delegate.Register(&polled[i], &PollTimer, &polled[i]);
+	}
+	uint64 start = Platform::GetTicks();
+	for (frame = 1; frame <= numFrames; ++frame)
+	{
+		delegate.Invoke();
+	}
+	const f64 pollNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	Array<TimerHandle> handles(numTimers);
+	for (uint32 i = 0; i < numTimers; ++i)
+	{
+		handles.Add(wheel.Schedule(NextDelay(wheeled[i]), &FireTimer, &wheeled[i]));
+	}
+	const f64 scheduleNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	start = Platform::GetTicks();
+	uint64 numWheelFired = 0;
+	for (frame = 1; frame <= numFrames; ++frame)
+	{
+		numWheelFired += wheel.Advance(frame);
+	}
+	const f64 wheelNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	uint64 numPolledFired = 0;
+	bool bMismatch = false;
+	for (uint32 i = 0; i < numTimers; ++i)
+	{
+		numPolledFired += polled[i].NumFired;
+		bMismatch |= polled[i].NumFired != wheeled[i].NumFired;
+	}
+	
+	// A Delegate finds the entries to unregister by searching all of them,
+	// the wheel cancels by handle.
+	start = Platform::GetTicks();
+	for (uint32 i = 0; i < numCancels; ++i)
+	{
+		delegate.Unregister(&polled[i]);
+	}
+	const f64 unregisterNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	handles.Reset();
+	for (uint32 i = 0; i < numCancels; ++i)
+	{
+		handles.Add(wheel.ScheduleAfter(1000 + i, &FireTimer, &wheeled[i]));
+	}
+	start = Platform::GetTicks();
+	uint32 numCancelled = 0;
+	for (uint32 i = 0; i < numCancels; ++i)
+	{
+		numCancelled += wheel.Cancel(handles[i]);
+	}
+	const f64 cancelNs = TicksToNanoseconds(Platform::GetTicks() - start);
+	
+	if (bMismatch || numPolledFired != numWheelFired || numCancelled != numCancels)
+	{
+		std::cout << "mismatch" << std::endl;
+	}
+	
+	std::cout << numTimers << " timers, " << numFrames << " frames, " << numWheelFired / f64(numFrames) << " fired per frame" << std::endl
+		<< "\tframe    delegate " << pollNs / numFrames / 1000.0 << " us\ttimer wheel " << wheelNs / numFrames / 1000.0 << " us" << std::endl
+		<< "\tschedule          " << scheduleNs / numTimers << " ns" << std::endl
+		<< "\tcancel   delegate " << unregisterNs / numCancels << " ns\ttimer wheel " << cancelNs / numCancels << " ns" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <iostream>
+#include <cstring>
+
+#include "Common/CompilerMacros.h"
+#include "Benchmarks.h"
+
+struct BenchmarkSuite {
+	const char* Name;
+	void (*Run)();
+};
+
+static const BenchmarkSuite Suites[] = {
+	{ "HashMapFindBatch", &BenchHashMapFindBatch },
+	{ "ConcurrentHashMap", &BenchConcurrentHashMap },
+	{ "BloomFilter", &BenchBloomFilter },
+	{ "RoaringBitmap", &BenchRoaringBitmap },
+	{ "Queue", &BenchQueue },
+	{ "SharedArray", &BenchSharedArray },
+	{ "Pipeline", &BenchPipeline },
+	{ "Stencil", &BenchStencil },
+	{ "SpatialHashGrid", &BenchSpatialHashGrid },
+	{ "EntityStore", &BenchEntityStore },
+	{ "TimerWheel", &BenchTimerWheel },
+	{ "RadixTree", &BenchRadixTree },
+};
+
+// Runs every suite, or only the ones named on the command line.
+int main(int argc, char** argv)
+{
+	for (uint32 i = 0; i < ARRAY_COUNT(Suites); ++i)
+	{
+		bool bSelected = argc < 2;
+		for (int32 arg = 1; arg < argc; ++arg)
+		{
+			bSelected |= strcmp(argv[arg], Suites[i].Name) == 0;
+		}
+		if (!bSelected)
+			continue;
+		
+		std::cout << "== " << Suites[i].Name << " ==" << std::endl;
+		Suites[i].Run();
+	}
+	return 0;
+}
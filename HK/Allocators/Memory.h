@@ -39,6 +39,26 @@ struct RemoveReference<T&&> {
 	typedef T Type;
 };
 
+template<typename T>
+struct RemoveCV {
+	typedef T Type;
+};
+
+template<typename T>
+struct RemoveCV<const T> {
+	typedef T Type;
+};
+
+template<typename T>
+struct RemoveCV<volatile T> {
+	typedef T Type;
+};
+
+template<typename T>
+struct RemoveCV<const volatile T> {
+	typedef T Type;
+};
+
 template<typename T>
 typename RemoveReference<T>::Type&& Move(T&& arg) noexcept {
 	return static_cast<typename RemoveReference<T>::Type&&>(arg);
@@ -66,7 +66,7 @@ void AssertFailed(const char* file, int line, const char* code);
 
 #define __LIKELY_IMPL(x) x
 #define __UNLIKELY_IMPL(x) x
-#define __RESTRICT_IMPL(x) __restrict
+#define __RESTRICT_IMPL(x) __restrict x
 #define __ASSUME_IMPL(x) __assume(LIKELY(x))
 #define __BREAK_IMPL {__nop(); __debugbreak();}
 #define __PREFETCH_READ_IMPL(x) _mm_prefetch((const char*)(x), _MM_HINT_T0)
@@ -74,6 +74,7 @@ void AssertFailed(const char* file, int line, const char* code);
 #define __UNREACHABLE_IMPL __assume(0)
 #define __PACK_START_IMPL __pragma(pack(push,1))
 #define __PACK_END_IMPL __pragma(pack(pop))
+#define __CPU_PAUSE_IMPL _mm_pause()
 
 #endif
 
@@ -81,13 +82,18 @@ void AssertFailed(const char* file, int line, const char* code);
 
 #define __LIKELY_IMPL(x) __builtin_expect(!!(x), 1)
 #define __UNLIKELY_IMPL(x) __builtin_expect(!!(x), 0)
-#define __RESTRICT_IMPL(x) __restrict__
+#define __RESTRICT_IMPL(x) __restrict__ x
 #define __ASSUME_IMPL(x) do { if (!(LIKELY(x))) __builtin_unreachable(); } while (0)
 #define __BREAK_IMPL __builtin_trap()
 #define __PREFETCH_READ_IMPL(x) __builtin_prefetch((const void*)(x), 0, 1)
 #define __PREFETCH_WRITE_IMPL(x) __builtin_prefetch((const void*)(x), 1, 1)
 #define __UNREACHABLE_IMPL __builtin_unreachable()
 #define __PACK_START_IMPL __attribute__((packed))
+#if defined(__x86_64__) || defined(__i386__)
+#define __CPU_PAUSE_IMPL __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define __CPU_PAUSE_IMPL __asm__ __volatile__("yield")
+#endif
 
 #endif
 
@@ -123,6 +129,9 @@ void AssertFailed(const char* file, int line, const char* code);
 #ifndef __PACK_END_IMPL
 #define __PACK_END_IMPL 
 #endif
+#ifndef __CPU_PAUSE_IMPL
+#define __CPU_PAUSE_IMPL {}
+#endif
 #ifndef __DBG_INCREMENT_IMPL
 #define __DBG_INCREMENT_IMPL(x) {}
 #endif
@@ -178,6 +187,10 @@ void AssertFailed(const char* file, int line, const char* code);
 #define PACK_START			__PACK_START_IMPL
 #define PACK_END			__PACK_END_IMPL
 #define DBG_INCREMENT(x)	__DBG_INCREMENT_IMPL(x)
+#define CPU_PAUSE			__CPU_PAUSE_IMPL
+
+// Assumed size of a cache line, used to pad data shared between threads
+#define CACHE_LINE_SIZE		64
 
 #define ARRAY_COUNT(x)		(sizeof(x) / sizeof(x[0]))
 
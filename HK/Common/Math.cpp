@@ -33,4 +33,28 @@ f32 Math::Ceil(f32 a)
 f64 Math::Ceil(f64 a)
 {
 	return std::ceil(a);
+}
+
+f64 Math::Log(f64 a)
+{
+	return std::log(a);
+}
+
+f64 Math::Exp(f64 a)
+{
+	return std::exp(a);
+}
+
+uint32 Math::NextPowerOfTwo(uint32 a)
+{
+	if (a <= 1) {
+		return 1;
+	}
+	--a;
+	a |= a >> 1;
+	a |= a >> 2;
+	a |= a >> 4;
+	a |= a >> 8;
+	a |= a >> 16;
+	return a + 1;
 }
\ No newline at end of file
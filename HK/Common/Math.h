@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "Common/CompilerMacros.h"
 #include "Common/Types.h"
 
 namespace Math {
@@ -72,4 +73,40 @@ namespace Math {
 	f64 Floor(f64 a);
 	f32 Ceil(f32 a);
 	f64 Ceil(f64 a);
+	// Natural logarithm
+	f64 Log(f64 a);
+	f64 Exp(f64 a);
+	
+	// Returns the smallest power of two that is >= a, 1 for 0.
+	uint32 NextPowerOfTwo(uint32 a);
+	
+	// The number of zero bits above the highest set bit, a must not be 0
+	inline uint32 CountLeadingZeros(uint64 a) {
+#ifdef MSVC
+		unsigned long index;
+		_BitScanReverse64(&index, a);
+		return 63 - index;
+#else
+		return __builtin_clzll(a);
+#endif
+	}
+	
+	// The number of zero bits below the lowest set bit, a must not be 0
+	inline uint32 CountTrailingZeros(uint64 a) {
+#ifdef MSVC
+		unsigned long index;
+		_BitScanForward64(&index, a);
+		return index;
+#else
+		return __builtin_ctzll(a);
+#endif
+	}
+	
+	inline uint32 PopCount(uint64 a) {
+#ifdef MSVC
+		return uint32(__popcnt64(a));
+#else
+		return __builtin_popcountll(a);
+#endif
+	}
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Common/CompilerMacros.h"
+#include "Common/Types.h"
+
+// BMI2 can't be detected at run time without a branch per call, so
+// pdep and pext are only used when the build targets CPUs that have
+// them, see HK_BMI2 in the CMake options. Note that AMD CPUs before
+// Zen 3 implement them in microcode, there the shifts are faster.
+#if defined(__BMI2__) || (defined(MSVC) && defined(__AVX2__))
+#define MORTON_BMI2 1
+#else
+#define MORTON_BMI2 0
+#endif
+
+// Z-order curve codes, which interleave the bits of the coordinates so
+// cells that are close in space are mostly close in memory too.
+// 2D codes take coordinates up to 16 bits, 3D codes up to 10 bits.
+namespace Morton
+{
+	constexpr uint32 MaskX2 = 0x55555555;
+	constexpr uint32 MaskY2 = 0xAAAAAAAA;
+	constexpr uint32 MaskX3 = 0x09249249;
+	constexpr uint32 MaskY3 = 0x12492492;
+	constexpr uint32 MaskZ3 = 0x24924924;
+
+	inline uint32 Deposit(uint32 value, uint32 mask) {
+#if MORTON_BMI2 && defined(MSVC)
+		return _pdep_u32(value, mask);
+#elif MORTON_BMI2
+		return __builtin_ia32_pdep_si(value, mask);
+#else
+		// Only called with the masks above when BMI2 is off
+		if (mask == MaskX2) {
+			value &= 0x0000FFFF;
+			value = (value | (value << 8)) & 0x00FF00FF;
+			value = (value | (value << 4)) & 0x0F0F0F0F;
+			value = (value | (value << 2)) & 0x33333333;
+			return (value | (value << 1)) & 0x55555555;
+		}
+		value &= 0x000003FF;
+		value = (value | (value << 16)) & 0x030000FF;
+		value = (value | (value << 8)) & 0x0300F00F;
+		value = (value | (value << 4)) & 0x030C30C3;
+		return (value | (value << 2)) & 0x09249249;
+#endif
+	}
+
+	inline uint32 Extract(uint32 code, uint32 mask) {
+#if MORTON_BMI2 && defined(MSVC)
+		return _pext_u32(code, mask);
+#elif MORTON_BMI2
+		return __builtin_ia32_pext_si(code, mask);
+#else
+		if (mask == MaskX2) {
+			code &= 0x55555555;
+			code = (code | (code >> 1)) & 0x33333333;
+			code = (code | (code >> 2)) & 0x0F0F0F0F;
+			code = (code | (code >> 4)) & 0x00FF00FF;
+			return (code | (code >> 8)) & 0x0000FFFF;
+		}
+		code &= 0x09249249;
+		code = (code | (code >> 2)) & 0x030C30C3;
+		code = (code | (code >> 4)) & 0x0300F00F;
+		code = (code | (code >> 8)) & 0xFF0000FF;
+		return (code | (code >> 16)) & 0x000003FF;
+#endif
+	}
+
+	inline uint32 Encode2(uint32 x, uint32 y) {
+		return Deposit(x, MaskX2) | (Deposit(y, MaskX2) << 1);
+	}
+
+	inline void Decode2(uint32 code, uint32& outX, uint32& outY) {
+		outX = Extract(code, MaskX2);
+		outY = Extract(code >> 1, MaskX2);
+	}
+
+	inline uint32 Encode3(uint32 x, uint32 y, uint32 z) {
+		return Deposit(x, MaskX3) | (Deposit(y, MaskX3) << 1) | (Deposit(z, MaskX3) << 2);
+	}
+
+	inline void Decode3(uint32 code, uint32& outX, uint32& outY, uint32& outZ) {
+		outX = Extract(code, MaskX3);
+		outY = Extract(code >> 1, MaskX3);
+		outZ = Extract(code >> 2, MaskX3);
+	}
+
+	// Moves a code one step along the axis of mask without decoding it.
+	// Filling the other axes' bits with ones makes the carry of the add
+	// run through them, the borrow of the subtract runs through zeros.
+	inline uint32 Increment(uint32 code, uint32 mask) {
+		return (((code | ~mask) + 1) & mask) | (code & ~mask);
+	}
+
+	inline uint32 Decrement(uint32 code, uint32 mask) {
+		return (((code & mask) - 1) & mask) | (code & ~mask);
+	}
+}
\ No newline at end of file
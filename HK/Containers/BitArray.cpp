@@ -4,19 +4,20 @@
 #include "Containers/BitArray.h"
 
 #include "Allocators/Memory.h"
+#include "Common/Math.h"
 
-BitArray::BitArray() : Array<uint8>() {
+BitArray::BitArray() : Array<uint64>() {
 	BitNum = 0;
 }
-BitArray::BitArray(uint32 bitsbuffer) : Array<uint8>(bitsbuffer / 8 + 1) {
+BitArray::BitArray(uint32 bitsbuffer) : Array<uint64>(bitsbuffer / 64 + 1) {
 	BitNum = 0;
 }
 
-BitArray::BitArray(const BitArray& other) : Array<uint8>(other) {
+BitArray::BitArray(const BitArray& other) : Array<uint64>(other) {
 	BitNum = other.BitNum;
 }
 
-BitArray::BitArray(BitArray&& other) : Array<uint8>(Move(other)) {
+BitArray::BitArray(BitArray&& other) : Array<uint64>(Move(other)) {
 	BitNum = other.BitNum;
 	other.BitNum = 0;
 }
@@ -25,29 +26,157 @@ BitArray::~BitArray() {
 }
 
 void BitArray::AddBit(bool bit) {
-	if (UNLIKELY(BitNum / 8 >= ArrayNum))
-		(void)AddUninitialized(1);
-	
-	uint32 byteIndex = BitNum / 8;
-	uint32 bitIndex = BitNum % 8;
+	if (UNLIKELY(BitNum / 64 >= ArrayNum))
+		*AddUninitialized(1) = 0;
 	
+	if (bit) {
+		Data[BitNum / 64] |= uint64(1) << (BitNum % 64);
+	}
 	++BitNum;
+}
+
+bool BitArray::GetBit(uint32 index) const {
+	CHECK(index < BitNum);
+	return (Data[index / 64] >> (index % 64)) & 1;
+}
+
+void BitArray::SetBit(uint32 index) {
+	CHECK(index < BitNum);
+	Data[index / 64] |= uint64(1) << (index % 64);
+}
+
+void BitArray::ClearBit(uint32 index) {
+	CHECK(index < BitNum);
+	Data[index / 64] &= ~(uint64(1) << (index % 64));
+}
+
+void BitArray::SetBitCount(uint32 bitCount) {
+	const uint32 wordCount = (bitCount + 63) / 64;
+	if (wordCount > ArrayNum) {
+		const uint32 numAdded = wordCount - ArrayNum;
+		Memory::FillZero(AddUninitialized(numAdded), sizeof(uint64) * numAdded);
+	}
+	ArrayNum = wordCount;
+	if (bitCount < BitNum && bitCount % 64 != 0) {
+		Data[bitCount / 64] &= (uint64(1) << (bitCount % 64)) - 1;
+	}
+	BitNum = bitCount;
+}
+
+void BitArray::AddBits(uint64 value, uint32 count) {
+	CHECK(count <= 64);
+	if (count == 0) {
+		return;
+	}
+	if (count < 64) {
+		value &= (uint64(1) << count) - 1;
+	}
 	
-	if (bit) {
-		Data[byteIndex] |= 1 << bitIndex;
+	const uint32 offset = BitNum % 64;
+	if (offset == 0) {
+		*AddUninitialized(1) = value;
 	} else {
-		Data[byteIndex] &= ~(1 << bitIndex);
+		Data[ArrayNum - 1] |= value << offset;
+		if (offset + count > 64) {
+			*AddUninitialized(1) = value >> (64 - offset);
+		}
 	}
+	BitNum += count;
 }
 
-bool BitArray::GetBit(uint32 index) const {
-	uint32 byteIndex = index / 8;
-	uint32 bitIndex = index % 8;
+uint64 BitArray::GetBits(uint32 pos, uint32 count) const {
+	CHECK(count <= 64 && uint64(pos) + count <= BitNum);
+	if (count == 0) {
+		return 0;
+	}
 	
-	CHECK(index < BitNum);
-	CHECK(byteIndex < ArrayNum);
+	const uint32 word = pos / 64;
+	const uint32 offset = pos % 64;
+	uint64 value = Data[word] >> offset;
+	if (offset + count > 64) {
+		value |= Data[word + 1] << (64 - offset);
+	}
+	return count < 64 ? value & ((uint64(1) << count) - 1) : value;
+}
+
+void BitArray::SetRange(uint32 start, uint32 count) {
+	FillRange(start, count, true);
+}
+
+void BitArray::ClearRange(uint32 start, uint32 count) {
+	FillRange(start, count, false);
+}
+
+// The word loops below are written so the compiler vectorizes them
+void BitArray::And(const BitArray& other) {
+	CHECK(BitNum == other.BitNum);
+	uint64* RESTRICT(words) = Data;
+	const uint64* RESTRICT(otherWords) = other.Data;
+	for (uint32 i = 0; i < ArrayNum; ++i) {
+		words[i] &= otherWords[i];
+	}
+}
+
+void BitArray::Or(const BitArray& other) {
+	CHECK(BitNum == other.BitNum);
+	uint64* RESTRICT(words) = Data;
+	const uint64* RESTRICT(otherWords) = other.Data;
+	for (uint32 i = 0; i < ArrayNum; ++i) {
+		words[i] |= otherWords[i];
+	}
+}
+
+void BitArray::Xor(const BitArray& other) {
+	CHECK(BitNum == other.BitNum);
+	uint64* RESTRICT(words) = Data;
+	const uint64* RESTRICT(otherWords) = other.Data;
+	for (uint32 i = 0; i < ArrayNum; ++i) {
+		words[i] ^= otherWords[i];
+	}
+}
+
+void BitArray::AndNot(const BitArray& other) {
+	CHECK(BitNum == other.BitNum);
+	uint64* RESTRICT(words) = Data;
+	const uint64* RESTRICT(otherWords) = other.Data;
+	for (uint32 i = 0; i < ArrayNum; ++i) {
+		words[i] &= ~otherWords[i];
+	}
+}
+
+uint32 BitArray::PopCount() const {
+	uint32 count = 0;
+	for (uint32 i = 0; i < ArrayNum; ++i) {
+		count += Math::PopCount(Data[i]);
+	}
+	return count;
+}
+
+uint32 BitArray::FindFirstSet() const {
+	for (uint32 i = 0; i < ArrayNum; ++i) {
+		if (Data[i] != 0) {
+			return i * 64 + Math::CountTrailingZeros(Data[i]);
+		}
+	}
+	return INVALID_INDEX;
+}
+
+uint32 BitArray::FindNextSet(uint32 index) const {
+	const uint32 start = index + 1;
+	if (start >= BitNum) {
+		return INVALID_INDEX;
+	}
 	
-	return (Data[byteIndex] & (1 << bitIndex)) != 0;
+	uint32 word = start / 64;
+	// Only look at the bits from start on in the first word
+	uint64 bits = Data[word] & (~uint64(0) << (start % 64));
+	while (bits == 0) {
+		if (++word >= ArrayNum) {
+			return INVALID_INDEX;
+		}
+		bits = Data[word];
+	}
+	return word * 64 + Math::CountTrailingZeros(bits);
 }
 
 uint32 BitArray::GetBitCount() const {
@@ -55,9 +184,31 @@ uint32 BitArray::GetBitCount() const {
 }
 
 uint32 BitArray::GetByteCount() const {
+	return (BitNum + 7) / 8;
+}
+
+uint32 BitArray::GetWordCount() const {
 	return ArrayNum;
 }
 
+// Words are little endian on every platform we target, so their bytes
+// are already in bit order.
+uint8* BitArray::GetBytes() {
+	return reinterpret_cast<uint8*>(Data);
+}
+
+const uint8* BitArray::GetBytes() const {
+	return reinterpret_cast<const uint8*>(Data);
+}
+
+uint64* BitArray::GetWords() {
+	return Data;
+}
+
+const uint64* BitArray::GetWords() const {
+	return Data;
+}
+
 void BitArray::Reset() {
 	ArrayNum = 0;
 	BitNum = 0;
@@ -72,14 +223,39 @@ bool BitArray::operator[](uint32 index) const {
 }
 
 BitArray& BitArray::operator=(const BitArray& other) {
-	Array<uint8>::operator=(other);
+	Array<uint64>::operator=(other);
 	BitNum = other.BitNum;
 	return *this;
 }
 
 BitArray& BitArray::operator=(BitArray&& other) {
-	Array<uint8>::operator=(Move(other));
+	Array<uint64>::operator=(Move(other));
 	BitNum = other.BitNum;
 	other.BitNum = 0;
 	return *this;
+}
+
+void BitArray::FillRange(uint32 start, uint32 count, bool bit) {
+	CHECK(uint64(start) + count <= BitNum);
+	if (count == 0) {
+		return;
+	}
+	
+	const uint32 end = start + count;
+	const uint32 firstWord = start / 64;
+	const uint32 lastWord = (end - 1) / 64;
+	const uint64 firstMask = ~uint64(0) << (start % 64);
+	const uint64 lastMask = ~uint64(0) >> (63 - (end - 1) % 64);
+	
+	if (firstWord == lastWord) {
+		const uint64 mask = firstMask & lastMask;
+		Data[firstWord] = bit ? Data[firstWord] | mask : Data[firstWord] & ~mask;
+		return;
+	}
+	
+	Data[firstWord] = bit ? Data[firstWord] | firstMask : Data[firstWord] & ~firstMask;
+	for (uint32 i = firstWord + 1; i < lastWord; ++i) {
+		Data[i] = bit ? ~uint64(0) : 0;
+	}
+	Data[lastWord] = bit ? Data[lastWord] | lastMask : Data[lastWord] & ~lastMask;
 }
\ No newline at end of file
@@ -5,7 +5,10 @@
 
 #include "Containers/Array.h"
 
-class BitArray : protected Array<uint8> {
+// Bits packed into uint64 words, lowest bit first. Bits past the end
+// of the last word are always kept clear, so word level operations
+// never need to mask them.
+class BitArray : protected Array<uint64> {
 public:
 	BitArray();
 	BitArray(uint32 bitsbuffer);
@@ -15,9 +18,38 @@ public:
 	
 	void AddBit(bool bit);
 	bool GetBit(uint32 index) const;
+	void SetBit(uint32 index);
+	void ClearBit(uint32 index);
+	// Grows with cleared bits, or shrinks to bitCount bits
+	void SetBitCount(uint32 bitCount);
+	
+	// Appends the count lowest bits of value, count is at most 64
+	void AddBits(uint64 value, uint32 count);
+	// Returns count bits starting at pos in the lowest bits
+	uint64 GetBits(uint32 pos, uint32 count) const;
+	void SetRange(uint32 start, uint32 count);
+	void ClearRange(uint32 start, uint32 count);
+	
+	// In place logical operations with a BitArray of the same size
+	void And(const BitArray& other);
+	void Or(const BitArray& other);
+	void Xor(const BitArray& other);
+	void AndNot(const BitArray& other);
+	
+	uint32 PopCount() const;
+	// Returns INVALID_INDEX if no bit is set
+	uint32 FindFirstSet() const;
+	// Returns the first set bit after index, or INVALID_INDEX
+	uint32 FindNextSet(uint32 index) const;
 	
 	uint32 GetBitCount() const;
 	uint32 GetByteCount() const;
+	uint32 GetWordCount() const;
+	// The bits packed eight to a byte, lowest bit first
+	uint8* GetBytes();
+	const uint8* GetBytes() const;
+	uint64* GetWords();
+	const uint64* GetWords() const;
 	
 	void Reset();
 	bool IsValidIndex(uint32 index) const;
@@ -28,5 +60,8 @@ public:
 	BitArray& operator=(BitArray&& other);
 	
 protected:
+	// Sets or clears the bits of a range, word by word
+	void FillRange(uint32 start, uint32 count, bool bit);
+	
 	uint32 BitNum;
 };
\ No newline at end of file
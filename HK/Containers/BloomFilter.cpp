@@ -0,0 +1,360 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/BloomFilter.h"
+
+#include "Common/Math.h"
+#include "File/File.h"
+
+static constexpr uint32 BloomFilterMagic = 0x46424B48; // "HKBF"
+// "HKB2", the probes moved in a block since "HKBB", so files of that
+// layout would give false negatives
+static constexpr uint32 BlockedBloomFilterMagic = 0x32424B48;
+
+struct BloomFilterFileHeader {
+	uint32 Magic;
+	uint32 NumBits;
+	uint32 NumHashes;
+	uint32 Padding;
+};
+
+// Maps a 32 bit value onto [0, range) without a division
+static uint32 ReduceRange(uint32 value, uint32 range)
+{
+	return uint32((uint64(value) * range) >> 32);
+}
+
+static bool ReadHeader(File& file, uint32 magic, BloomFilterFileHeader& outHeader)
+{
+	if (file.Read(reinterpret_cast<uint8*>(&outHeader), sizeof(outHeader)) != sizeof(outHeader)) {
+		return false;
+	}
+	return outHeader.Magic == magic && outHeader.NumHashes > 0;
+}
+
+BloomFilterSize BloomFilterSize::ForFalsePositiveRate(uint32 numItems, f64 falsePositiveRate)
+{
+	CHECK(falsePositiveRate > 0.0 && falsePositiveRate < 1.0);
+	const f64 ln2 = 0.6931471805599453;
+	const f64 items = numItems > 0 ? f64(numItems) : 1.0;
+	const f64 bits = Math::Ceil(-items * Math::Log(falsePositiveRate) / (ln2 * ln2));
+	
+	BloomFilterSize size;
+	size.NumBits = bits < 64.0 ? 64 : bits > 4294967295.0 ? 0xFFFFFFFF : uint32(bits);
+	size.NumHashes = uint32(Math::Round(f64(size.NumBits) / items * ln2));
+	size.NumHashes = Math::Max<uint32>(1, Math::Min<uint32>(size.NumHashes, 16));
+	return size;
+}
+
+static constexpr uint32 Log2(uint32 value)
+{
+	return value <= 1 ? 0 : 1 + Log2(value / 2);
+}
+
+// The top bits of the hash pick a block. Each probe in the block takes its
+// own bits of the remixed hash, and the hash is mixed again when those bits
+// run out. That keeps the probes independent of each other and of the block.
+// Double hashing in a block this small put the probes of many items on
+// shared arithmetic progressions.
+struct BlockProbes {
+	static constexpr uint32 BitsPerProbe = Log2(BlockedBloomFilter::BlockBits);
+	static constexpr uint32 ProbesPerMix = 64 / BitsPerProbe;
+
+	BlockProbes(uint64 hash) : Bits(Hasher::Mix(hash)), NumLeft(ProbesPerMix) {}
+
+	uint32 Next()
+	{
+		if (NumLeft == 0) {
+			Bits = Hasher::Mix(Bits);
+			NumLeft = ProbesPerMix;
+		}
+		const uint32 bit = uint32(Bits) & (BlockedBloomFilter::BlockBits - 1);
+		Bits >>= BitsPerProbe;
+		--NumLeft;
+		return bit;
+	}
+
+	uint64 Bits;
+	uint32 NumLeft;
+};
+
+// The false positive rate of a blocked filter with numBlocks blocks, from
+// the Poisson distribution of the number of items that land in a block.
+static f64 BlockedFalsePositiveRate(f64 numItems, f64 numBlocks, uint32 numHashes)
+{
+	const f64 itemsPerBlock = numItems / numBlocks;
+	const f64 logBitClear = Math::Log(1.0 - 1.0 / BlockedBloomFilter::BlockBits);
+	const uint32 maxItems = uint32(3.0 * itemsPerBlock + 64.0);
+	f64 probability = Math::Exp(-itemsPerBlock);
+	f64 rate = 0.0;
+	for (uint32 j = 0; j <= maxItems; ++j) {
+		if (j > 0) {
+			probability *= itemsPerBlock / j;
+		}
+		const f64 bitSet = 1.0 - Math::Exp(logBitClear * numHashes * j);
+		f64 blockRate = 1.0;
+		for (uint32 i = 0; i < numHashes; ++i) {
+			blockRate *= bitSet;
+		}
+		rate += probability * blockRate;
+	}
+	return rate;
+}
+
+BloomFilterSize BloomFilterSize::ForFalsePositiveRateBlocked(uint32 numItems, f64 falsePositiveRate)
+{
+	// Grow the classic size until the blocked model reaches the rate, a
+	// few percent at a time.
+	BloomFilterSize size = ForFalsePositiveRate(numItems, falsePositiveRate);
+	const f64 items = numItems > 0 ? f64(numItems) : 1.0;
+	f64 bits = f64(size.NumBits);
+	for (;;) {
+		const f64 numBlocks = Math::Ceil(bits / BlockedBloomFilter::BlockBits);
+		f64 bestRate = 1.0;
+		for (uint32 numHashes = 1; numHashes <= 16; ++numHashes) {
+			const f64 rate = BlockedFalsePositiveRate(items, numBlocks, numHashes);
+			if (rate < bestRate) {
+				bestRate = rate;
+				size.NumHashes = numHashes;
+			}
+		}
+		if (bestRate <= falsePositiveRate || bits >= 4294967295.0) {
+			break;
+		}
+		bits *= 1.02;
+	}
+	size.NumBits = bits > 4294967295.0 ? 0xFFFFFFFF : uint32(bits);
+	return size;
+}
+
+BloomFilter::BloomFilter()
+	: NumHashes(0)
+{
+}
+
+BloomFilter::BloomFilter(const BloomFilterSize& size)
+	: NumHashes(size.NumHashes)
+{
+	CHECK(size.NumBits > 0 && size.NumHashes > 0);
+	Bits.SetBitCount(size.NumBits);
+}
+
+void BloomFilter::AddHash(uint64 hash)
+{
+	const uint32 numBits = Bits.GetBitCount();
+	uint64* words = Bits.GetWords();
+	const uint32 h1 = uint32(hash);
+	const uint32 h2 = uint32(hash >> 32) | 1;
+	for (uint32 i = 0; i < NumHashes; ++i) {
+		const uint32 bit = ReduceRange(h1 + i * h2, numBits);
+		words[bit / 64] |= uint64(1) << (bit % 64);
+	}
+}
+
+bool BloomFilter::MayContainHash(uint64 hash) const
+{
+	// Reads the words directly, this is the hot path
+	const uint32 numBits = Bits.GetBitCount();
+	const uint64* words = Bits.GetWords();
+	const uint32 h1 = uint32(hash);
+	const uint32 h2 = uint32(hash >> 32) | 1;
+	for (uint32 i = 0; i < NumHashes; ++i) {
+		const uint32 bit = ReduceRange(h1 + i * h2, numBits);
+		if ((words[bit / 64] & (uint64(1) << (bit % 64))) == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void BloomFilter::Merge(const BloomFilter& other)
+{
+	CHECK(NumHashes == other.NumHashes);
+	Bits.Or(other.Bits);
+}
+
+void BloomFilter::Clear()
+{
+	Bits.ClearRange(0, Bits.GetBitCount());
+}
+
+uint32 BloomFilter::GetNumBits() const
+{
+	return Bits.GetBitCount();
+}
+
+uint32 BloomFilter::GetNumHashes() const
+{
+	return NumHashes;
+}
+
+void BloomFilter::Save(File& file) const
+{
+	BloomFilterFileHeader header;
+	header.Magic = BloomFilterMagic;
+	header.NumBits = Bits.GetBitCount();
+	header.NumHashes = NumHashes;
+	header.Padding = 0;
+	file.Write(&header, sizeof(header));
+	file.Write(Bits.GetBytes(), Bits.GetByteCount());
+}
+
+bool BloomFilter::Load(File& file)
+{
+	BloomFilterFileHeader header;
+	if (!ReadHeader(file, BloomFilterMagic, header) || header.NumBits == 0) {
+		return false;
+	}
+	Bits.Reset();
+	Bits.SetBitCount(header.NumBits);
+	NumHashes = header.NumHashes;
+	return file.Read(Bits.GetBytes(), Bits.GetByteCount()) == Bits.GetByteCount();
+}
+
+BlockedBloomFilter::BlockedBloomFilter()
+	: Blocks(nullptr)
+	, Allocation(nullptr)
+	, NumBlocks(0)
+	, NumHashes(0)
+{
+}
+
+BlockedBloomFilter::BlockedBloomFilter(const BloomFilterSize& size)
+	: BlockedBloomFilter()
+{
+	CHECK(size.NumBits > 0 && size.NumHashes > 0);
+	NumHashes = size.NumHashes;
+	Allocate((size.NumBits + BlockBits - 1) / BlockBits);
+}
+
+BlockedBloomFilter::BlockedBloomFilter(const BlockedBloomFilter& other)
+	: BlockedBloomFilter()
+{
+	*this = other;
+}
+
+BlockedBloomFilter::BlockedBloomFilter(BlockedBloomFilter&& other)
+	: BlockedBloomFilter()
+{
+	*this = Move(other);
+}
+
+BlockedBloomFilter::~BlockedBloomFilter()
+{
+	FreeBlocks();
+}
+
+BlockedBloomFilter& BlockedBloomFilter::operator=(const BlockedBloomFilter& other)
+{
+	if (this != &other) {
+		Allocate(other.NumBlocks);
+		NumHashes = other.NumHashes;
+		Memory::Copy(other.Blocks, Blocks, uint64(NumBlocks) * CACHE_LINE_SIZE);
+	}
+	return *this;
+}
+
+BlockedBloomFilter& BlockedBloomFilter::operator=(BlockedBloomFilter&& other)
+{
+	if (this != &other) {
+		FreeBlocks();
+		Blocks = other.Blocks;
+		Allocation = other.Allocation;
+		NumBlocks = other.NumBlocks;
+		NumHashes = other.NumHashes;
+		other.Blocks = nullptr;
+		other.Allocation = nullptr;
+		other.NumBlocks = 0;
+	}
+	return *this;
+}
+
+void BlockedBloomFilter::AddHash(uint64 hash)
+{
+	uint64* block = Blocks + uint64(ReduceRange(uint32(hash >> 32), NumBlocks)) * BlockWords;
+	BlockProbes probes(hash);
+	for (uint32 i = 0; i < NumHashes; ++i) {
+		const uint32 bit = probes.Next();
+		block[bit / 64] |= uint64(1) << (bit % 64);
+	}
+}
+
+bool BlockedBloomFilter::MayContainHash(uint64 hash) const
+{
+	const uint64* block = Blocks + uint64(ReduceRange(uint32(hash >> 32), NumBlocks)) * BlockWords;
+	BlockProbes probes(hash);
+	for (uint32 i = 0; i < NumHashes; ++i) {
+		const uint32 bit = probes.Next();
+		if ((block[bit / 64] & (uint64(1) << (bit % 64))) == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void BlockedBloomFilter::Merge(const BlockedBloomFilter& other)
+{
+	CHECK(NumBlocks == other.NumBlocks && NumHashes == other.NumHashes);
+	const uint32 numWords = NumBlocks * BlockWords;
+	for (uint32 i = 0; i < numWords; ++i) {
+		Blocks[i] |= other.Blocks[i];
+	}
+}
+
+void BlockedBloomFilter::Clear()
+{
+	Memory::FillZero(Blocks, uint64(NumBlocks) * CACHE_LINE_SIZE);
+}
+
+uint32 BlockedBloomFilter::GetNumBits() const
+{
+	return NumBlocks * BlockBits;
+}
+
+uint32 BlockedBloomFilter::GetNumHashes() const
+{
+	return NumHashes;
+}
+
+void BlockedBloomFilter::Save(File& file) const
+{
+	BloomFilterFileHeader header;
+	header.Magic = BlockedBloomFilterMagic;
+	header.NumBits = GetNumBits();
+	header.NumHashes = NumHashes;
+	header.Padding = 0;
+	file.Write(&header, sizeof(header));
+	file.Write(Blocks, uint64(NumBlocks) * CACHE_LINE_SIZE);
+}
+
+bool BlockedBloomFilter::Load(File& file)
+{
+	BloomFilterFileHeader header;
+	if (!ReadHeader(file, BlockedBloomFilterMagic, header) ||
+		header.NumBits == 0 || header.NumBits % BlockBits != 0) {
+		return false;
+	}
+	Allocate(header.NumBits / BlockBits);
+	NumHashes = header.NumHashes;
+	const uint64 numBytes = uint64(NumBlocks) * CACHE_LINE_SIZE;
+	return file.Read(reinterpret_cast<uint8*>(Blocks), numBytes) == numBytes;
+}
+
+void BlockedBloomFilter::Allocate(uint32 numBlocks)
+{
+	FreeBlocks();
+	NumBlocks = numBlocks;
+	Allocation = Memory::Allocate(uint64(numBlocks + 1) * CACHE_LINE_SIZE);
+	Blocks = reinterpret_cast<uint64*>((uintptr(Allocation) + CACHE_LINE_SIZE - 1) & ~uintptr(CACHE_LINE_SIZE - 1));
+	Memory::FillZero(Blocks, uint64(numBlocks) * CACHE_LINE_SIZE);
+}
+
+void BlockedBloomFilter::FreeBlocks()
+{
+	if (Allocation != nullptr) {
+		Memory::Free(Allocation, uint64(NumBlocks + 1) * CACHE_LINE_SIZE);
+	}
+	Blocks = nullptr;
+	Allocation = nullptr;
+	NumBlocks = 0;
+}
\ No newline at end of file
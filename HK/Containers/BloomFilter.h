@@ -0,0 +1,138 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Containers/BitArray.h"
+#include "Util/Hasher.h"
+
+class File;
+
+struct BloomFilterSize {
+	uint32 NumBits;
+	uint32 NumHashes;
+	
+	// The smallest filter that holds numItems items with at most the
+	// given false positive rate.
+	static BloomFilterSize ForFalsePositiveRate(uint32 numItems, f64 falsePositiveRate);
+	// The same for a BlockedBloomFilter. Items spread unevenly over its
+	// blocks and the fullest blocks give most false positives, so it
+	// needs more bits per item for the same rate.
+	static BloomFilterSize ForFalsePositiveRateBlocked(uint32 numItems, f64 falsePositiveRate);
+};
+
+// A probabilistic set that can report false positives but never false
+// negatives, as a cheap negative check before an expensive lookup.
+// Every item is hashed once to 64 bits, and double hashing derives
+// all of its probe positions from the two halves.
+class BloomFilter {
+public:
+	BloomFilter();
+	BloomFilter(const BloomFilterSize& size);
+	
+	template<typename T>
+	void Add(const T& item);
+	// False means the item was never added
+	template<typename T>
+	bool MayContain(const T& item) const;
+	
+	// For callers that already hold a hash, see HashOf
+	void AddHash(uint64 hash);
+	bool MayContainHash(uint64 hash) const;
+	
+	// Adds every item of other, which must be the same size
+	void Merge(const BloomFilter& other);
+	void Clear();
+	
+	uint32 GetNumBits() const;
+	uint32 GetNumHashes() const;
+	
+	void Save(File& file) const;
+	// Returns false if the file doesn't hold a bloom filter
+	bool Load(File& file);
+	
+	template<typename T>
+	static uint64 HashOf(const T& item);
+	
+private:
+	BitArray Bits;
+	uint32 NumHashes;
+};
+
+// A bloom filter that keeps all probes of an item in one 512 bit
+// block, so a lookup touches a single cache line. It needs slightly
+// more bits than BloomFilter for the same false positive rate.
+// The blocks are cache line aligned, which BitArray can't guarantee,
+// so they are stored as raw words instead.
+class BlockedBloomFilter {
+public:
+	static constexpr uint32 BlockBits = CACHE_LINE_SIZE * 8;
+	static constexpr uint32 BlockWords = BlockBits / 64;
+	
+	BlockedBloomFilter();
+	// Rounds the bits up to whole blocks
+	BlockedBloomFilter(const BloomFilterSize& size);
+	BlockedBloomFilter(const BlockedBloomFilter& other);
+	BlockedBloomFilter(BlockedBloomFilter&& other);
+	~BlockedBloomFilter();
+	
+	BlockedBloomFilter& operator=(const BlockedBloomFilter& other);
+	BlockedBloomFilter& operator=(BlockedBloomFilter&& other);
+	
+	template<typename T>
+	void Add(const T& item);
+	template<typename T>
+	bool MayContain(const T& item) const;
+	
+	void AddHash(uint64 hash);
+	bool MayContainHash(uint64 hash) const;
+	
+	void Merge(const BlockedBloomFilter& other);
+	void Clear();
+	
+	uint32 GetNumBits() const;
+	uint32 GetNumHashes() const;
+	
+	void Save(File& file) const;
+	bool Load(File& file);
+	
+private:
+	void Allocate(uint32 numBlocks);
+	void FreeBlocks();
+	
+	// Points into Allocation, aligned to a cache line
+	uint64* Blocks;
+	void* Allocation;
+	uint32 NumBlocks;
+	uint32 NumHashes;
+};
+
+template<typename T>
+void BloomFilter::Add(const T& item)
+{
+	AddHash(HashOf(item));
+}
+
+template<typename T>
+bool BloomFilter::MayContain(const T& item) const
+{
+	return MayContainHash(HashOf(item));
+}
+
+template<typename T>
+uint64 BloomFilter::HashOf(const T& item)
+{
+	return Hasher::Mix(Hasher::Hash<uint64>(item));
+}
+
+template<typename T>
+void BlockedBloomFilter::Add(const T& item)
+{
+	AddHash(BloomFilter::HashOf(item));
+}
+
+template<typename T>
+bool BlockedBloomFilter::MayContain(const T& item) const
+{
+	return MayContainHash(BloomFilter::HashOf(item));
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "HashMap.h"
+#include "Util/SpinLock.h"
+
+// A hash map that may be used from many threads at once. Keys are
+// sharded on the high bits of their hash into NumShards HashMaps, each
+// behind its own readers-writer lock on its own cache line, so threads
+// only contend when they touch the same shard.
+// Reads take the shard lock shared and never wait on other readers.
+// Values are returned by copy, as a reference could be moved by a
+// concurrent rehash, so keep TValue small (an id or a pointer).
+template<class TKey, class TValue, int NumShards = 64>
+class ConcurrentHashMap {
+	static_assert(NumShards > 0 && (NumShards & (NumShards - 1)) == 0, "NumShards must be a power of two");
+public:
+	ConcurrentHashMap() = default;
+	ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+	ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+	bool Find(const TKey& key, TValue& outValue) const;
+	// See HashMap::FindAs.
+	template<typename K>
+	bool FindAs(const K& key, TValue& outValue) const;
+	bool Contains(const TKey& key) const;
+
+	// Returns false and keeps the existing value if the key is present.
+	bool Add(const TKey& key, const TValue& value);
+	// Returns the value for key, calling create() to make it when the key
+	// is missing. Across all threads create is called at most once per
+	// key, while the shard is locked.
+	template<typename F>
+	TValue FindOrAdd(const TKey& key, const F& create);
+	bool Remove(const TKey& key);
+	void Clear();
+	uint32 Num() const;
+
+	// Calls f(key, value) for all entries, locking one shard at a time,
+	// so it's not a snapshot of the whole map. f may not call back into
+	// this map.
+	template<typename F>
+	void ForEach(const F& f) const;
+	template<typename F>
+	void ForEachInShard(uint32 shardIndex, const F& f) const;
+
+	static constexpr uint32 GetNumShards() { return NumShards; }
+
+protected:
+	struct alignas(CACHE_LINE_SIZE) Shard {
+		mutable SharedSpinLock Lock;
+		HashMap<TKey, TValue> Map;
+	};
+
+	template<typename K>
+	static uint32 GetShardIndex(const K& key);
+
+	Shard Shards[NumShards];
+};
+
+template<class TKey, class TValue, int NumShards>
+template<typename K>
+uint32 ConcurrentHashMap<TKey, TValue, NumShards>::GetShardIndex(const K& key)
+{
+	// The shards use the high bits, while the HashMap in a shard
+	// finds the slot from the low bits.
+	const uint64 hash = Hasher::Hash<uint32>(key);
+	return uint32((hash * NumShards) >> 32);
+}
+
+template<class TKey, class TValue, int NumShards>
+bool ConcurrentHashMap<TKey, TValue, NumShards>::Find(const TKey& key, TValue& outValue) const
+{
+	return FindAs(key, outValue);
+}
+
+template<class TKey, class TValue, int NumShards>
+template<typename K>
+bool ConcurrentHashMap<TKey, TValue, NumShards>::FindAs(const K& key, TValue& outValue) const
+{
+	const Shard& shard = Shards[GetShardIndex(key)];
+	ScopeSharedLock lock(shard.Lock);
+	const TValue* value = shard.Map.FindAs(key);
+	if (value == nullptr) {
+		return false;
+	}
+	outValue = *value;
+	return true;
+}
+
+template<class TKey, class TValue, int NumShards>
+bool ConcurrentHashMap<TKey, TValue, NumShards>::Contains(const TKey& key) const
+{
+	const Shard& shard = Shards[GetShardIndex(key)];
+	ScopeSharedLock lock(shard.Lock);
+	return shard.Map.Find(key) != nullptr;
+}
+
+template<class TKey, class TValue, int NumShards>
+bool ConcurrentHashMap<TKey, TValue, NumShards>::Add(const TKey& key, const TValue& value)
+{
+	Shard& shard = Shards[GetShardIndex(key)];
+	ScopeLock<SharedSpinLock> lock(shard.Lock);
+	bool bAdded = false;
+	TValue& slot = shard.Map.FindOrAdd(key, &bAdded);
+	if (bAdded) {
+		slot = value;
+	}
+	return bAdded;
+}
+
+template<class TKey, class TValue, int NumShards>
+template<typename F>
+TValue ConcurrentHashMap<TKey, TValue, NumShards>::FindOrAdd(const TKey& key, const F& create)
+{
+	Shard& shard = Shards[GetShardIndex(key)];
+	{
+		ScopeSharedLock lock(shard.Lock);
+		const TValue* value = shard.Map.Find(key);
+		if (value != nullptr) {
+			return *value;
+		}
+	}
+
+	// Another thread may have added the key between the two locks,
+	// FindOrAdd tells us whether we are the one that adds it.
+	ScopeLock<SharedSpinLock> lock(shard.Lock);
+	bool bAdded = false;
+	TValue& slot = shard.Map.FindOrAdd(key, &bAdded);
+	if (bAdded) {
+		slot = create();
+	}
+	return slot;
+}
+
+template<class TKey, class TValue, int NumShards>
+bool ConcurrentHashMap<TKey, TValue, NumShards>::Remove(const TKey& key)
+{
+	Shard& shard = Shards[GetShardIndex(key)];
+	ScopeLock<SharedSpinLock> lock(shard.Lock);
+	const uint32 numBefore = shard.Map.Num();
+	shard.Map.Remove(key);
+	return shard.Map.Num() != numBefore;
+}
+
+template<class TKey, class TValue, int NumShards>
+void ConcurrentHashMap<TKey, TValue, NumShards>::Clear()
+{
+	for (uint32 i = 0; i < NumShards; ++i) {
+		ScopeLock<SharedSpinLock> lock(Shards[i].Lock);
+		Shards[i].Map.Clear();
+	}
+}
+
+template<class TKey, class TValue, int NumShards>
+uint32 ConcurrentHashMap<TKey, TValue, NumShards>::Num() const
+{
+	uint32 num = 0;
+	for (uint32 i = 0; i < NumShards; ++i) {
+		ScopeSharedLock lock(Shards[i].Lock);
+		num += Shards[i].Map.Num();
+	}
+	return num;
+}
+
+template<class TKey, class TValue, int NumShards>
+template<typename F>
+void ConcurrentHashMap<TKey, TValue, NumShards>::ForEach(const F& f) const
+{
+	for (uint32 i = 0; i < NumShards; ++i) {
+		ForEachInShard(i, f);
+	}
+}
+
+template<class TKey, class TValue, int NumShards>
+template<typename F>
+void ConcurrentHashMap<TKey, TValue, NumShards>::ForEachInShard(uint32 shardIndex, const F& f) const
+{
+	CHECK(shardIndex < NumShards);
+	const Shard& shard = Shards[shardIndex];
+	ScopeSharedLock lock(shard.Lock);
+	shard.Map.ForEach(f);
+}
\ No newline at end of file
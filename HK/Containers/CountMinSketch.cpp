@@ -0,0 +1,161 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/CountMinSketch.h"
+
+#include "Common/Math.h"
+#include "File/File.h"
+
+static constexpr uint32 CountMinSketchMagic = 0x4D434B48; // "HKCM"
+
+struct CountMinSketchFileHeader {
+	uint32 Magic;
+	uint32 Width;
+	uint32 Depth;
+	uint32 Padding;
+	uint64 Total;
+};
+
+static uint32 SaturatingAdd(uint32 a, uint32 b)
+{
+	const uint32 sum = a + b;
+	return sum < a ? Traits::Limits<uint32>::Max : sum;
+}
+
+CountMinSketch::CountMinSketch()
+	: Width(0)
+	, Depth(0)
+	, Total(0)
+{
+}
+
+CountMinSketch::CountMinSketch(uint32 width, uint32 depth)
+	: Width(0)
+	, Depth(depth)
+	, Total(0)
+{
+	// Checked before rounding, which wraps to 0 above 2^31
+	CHECK(width > 0 && width <= MaxCounters && depth > 0 && depth <= MaxDepth);
+	Width = Math::NextPowerOfTwo(width);
+	CHECK(uint64(Width) * Depth <= MaxCounters);
+	Memory::FillZero(Counters.AddUninitialized(Width * Depth), sizeof(uint32) * uint64(Width) * Depth);
+}
+
+CountMinSketch CountMinSketch::ForError(f64 relativeError, f64 failureProbability)
+{
+	CHECK(relativeError > 0.0 && failureProbability > 0.0 && failureProbability < 1.0);
+	const f64 e = 2.718281828459045;
+	const f64 width = Math::Ceil(e / relativeError);
+	const f64 depth = Math::Max(1.0, Math::Min(Math::Ceil(Math::Log(1.0 / failureProbability)), f64(MaxDepth)));
+	// Stays in f64 until it's known to fit the counter budget
+	CHECK(width <= f64(MaxCounters / uint32(depth)));
+	return CountMinSketch(uint32(width), uint32(depth));
+}
+
+void CountMinSketch::AddHash(uint64 hash, uint32 count)
+{
+	uint32 slots[MaxDepth];
+	GetSlots(hash, slots);
+	
+	uint32 minimum = Traits::Limits<uint32>::Max;
+	for (uint32 row = 0; row < Depth; ++row) {
+		minimum = Math::Min(minimum, Counters[slots[row]]);
+	}
+	const uint32 target = SaturatingAdd(minimum, count);
+	for (uint32 row = 0; row < Depth; ++row) {
+		Counters[slots[row]] = Math::Max(Counters[slots[row]], target);
+	}
+	Total += count;
+}
+
+uint32 CountMinSketch::EstimateHash(uint64 hash) const
+{
+	uint32 slots[MaxDepth];
+	GetSlots(hash, slots);
+	
+	uint32 minimum = Traits::Limits<uint32>::Max;
+	for (uint32 row = 0; row < Depth; ++row) {
+		minimum = Math::Min(minimum, Counters[slots[row]]);
+	}
+	return minimum;
+}
+
+void CountMinSketch::Merge(const CountMinSketch& other)
+{
+	CHECK(Width == other.Width && Depth == other.Depth);
+	// A plain element wise add, which compilers vectorize
+	uint32* RESTRICT(counters) = Counters.GetData();
+	const uint32* RESTRICT(otherCounters) = other.Counters.GetData();
+	for (uint32 i = 0; i < Counters.Num(); ++i) {
+		counters[i] = SaturatingAdd(counters[i], otherCounters[i]);
+	}
+	Total += other.Total;
+}
+
+void CountMinSketch::Clear()
+{
+	Memory::FillZero(Counters.GetData(), sizeof(uint32) * uint64(Counters.Num()));
+	Total = 0;
+}
+
+uint32 CountMinSketch::GetWidth() const
+{
+	return Width;
+}
+
+uint32 CountMinSketch::GetDepth() const
+{
+	return Depth;
+}
+
+uint64 CountMinSketch::GetTotal() const
+{
+	return Total;
+}
+
+void CountMinSketch::Save(File& file) const
+{
+	CountMinSketchFileHeader header;
+	header.Magic = CountMinSketchMagic;
+	header.Width = Width;
+	header.Depth = Depth;
+	header.Padding = 0;
+	header.Total = Total;
+	file.Write(&header, sizeof(header));
+	file.Write(Counters.GetData(), sizeof(uint32) * uint64(Counters.Num()));
+}
+
+bool CountMinSketch::Load(File& file)
+{
+	CountMinSketchFileHeader header;
+	if (file.Read(reinterpret_cast<uint8*>(&header), sizeof(header)) != sizeof(header) ||
+		header.Magic != CountMinSketchMagic || header.Width == 0 ||
+		(header.Width & (header.Width - 1)) != 0 ||
+		header.Depth == 0 || header.Depth > MaxDepth ||
+		uint64(header.Width) * header.Depth > MaxCounters) {
+		return false;
+	}
+	
+	const uint32 numCounters = header.Width * header.Depth;
+	const uint64 numBytes = sizeof(uint32) * uint64(numCounters);
+	Array<uint32> counters;
+	if (file.Read(reinterpret_cast<uint8*>(counters.AddUninitialized(numCounters)), numBytes) != numBytes) {
+		return false;
+	}
+	Counters = Move(counters);
+	Width = header.Width;
+	Depth = header.Depth;
+	Total = header.Total;
+	return true;
+}
+
+void CountMinSketch::GetSlots(uint64 hash, uint32* outSlots) const
+{
+	// Double hashing gives every row its own column
+	const uint32 h1 = uint32(hash);
+	const uint32 h2 = uint32(hash >> 32) | 1;
+	const uint32 mask = Width - 1;
+	for (uint32 row = 0; row < Depth; ++row) {
+		outSlots[row] = row * Width + ((h1 + row * h2) & mask);
+	}
+}
\ No newline at end of file
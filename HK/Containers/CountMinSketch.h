@@ -0,0 +1,70 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Util/Hasher.h"
+
+class File;
+
+// Estimates how often every item was added in fixed memory. Estimates
+// never undercount, and overcount by at most relativeError times the
+// total count with probability 1 - failureProbability.
+// Adds use conservative update, only raising the counters that hold
+// the current minimum, which keeps the overcount much lower in practice.
+class CountMinSketch {
+public:
+	static constexpr uint32 MaxDepth = 16;
+	// Width times depth, a GiB of counters
+	static constexpr uint32 MaxCounters = 1 << 28;
+	
+	CountMinSketch();
+	// Rounds the width up to a power of two
+	CountMinSketch(uint32 width, uint32 depth);
+	// The error bound must not need more than MaxCounters counters
+	static CountMinSketch ForError(f64 relativeError, f64 failureProbability);
+	
+	template<typename T>
+	void Add(const T& item, uint32 count = 1);
+	template<typename T>
+	uint32 Estimate(const T& item) const;
+	void AddHash(uint64 hash, uint32 count = 1);
+	uint32 EstimateHash(uint64 hash) const;
+	
+	// Adds the counts of other, which must be the same size. The merged
+	// sketch still never undercounts.
+	void Merge(const CountMinSketch& other);
+	void Clear();
+	
+	uint32 GetWidth() const;
+	uint32 GetDepth() const;
+	// The sum of every count added
+	uint64 GetTotal() const;
+	
+	void Save(File& file) const;
+	// Returns false if the file doesn't hold a valid CountMinSketch,
+	// which leaves this one as it was.
+	bool Load(File& file);
+	
+private:
+	void GetSlots(uint64 hash, uint32* outSlots) const;
+	
+	// Depth rows of Width counters
+	Array<uint32> Counters;
+	uint32 Width;
+	uint32 Depth;
+	uint64 Total;
+};
+
+template<typename T>
+void CountMinSketch::Add(const T& item, uint32 count)
+{
+	AddHash(Hasher::Mix(Hasher::Hash<uint64>(item)), count);
+}
+
+template<typename T>
+uint32 CountMinSketch::Estimate(const T& item) const
+{
+	return EstimateHash(Hasher::Mix(Hasher::Hash<uint64>(item)));
+}
\ No newline at end of file
@@ -0,0 +1,419 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/EntityStore.h"
+#include "Common/Math.h"
+#include "Util/SpinLock.h"
+
+EntityStore::ComponentType EntityStore::ComponentTypes[MaxComponentTypes];
+Atomic<uint32> EntityStore::NumComponentTypes;
+static SpinLock RegisterLock;
+
+static uint32 AlignOffset(uint32 offset, uint32 alignment)
+{
+	return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+EntityStore::EntityStore()
+	: FirstFreeRecord(INVALID_INDEX)
+	, NumEntities(0)
+{}
+
+EntityStore::~EntityStore()
+{
+	// The pool frees the chunks themselves
+	for (uint32 i = 0; i < Archetypes.Num(); ++i) {
+		Archetype* archetype = Archetypes[i];
+		for (uint32 c = 0; c < archetype->Chunks.Num(); ++c) {
+			DestructRows(*archetype, archetype->Chunks[c], 0, GetChunkNum(*archetype, c), archetype->Mask);
+		}
+		archetype->~Archetype();
+		Memory::Free(archetype, sizeof(Archetype));
+	}
+}
+
+uint32 EntityStore::RegisterComponent(uint32 size, uint32 alignment, void (*construct)(void*), void (*destruct)(void*))
+{
+	// Every column starts at its alignment in a chunk, and chunks are only
+	// as aligned as the allocations of the pool.
+	CHECK(alignment <= 16);
+	CHECK(size + sizeof(EntityId) <= ChunkSize);
+	ScopeLock<SpinLock> lock(RegisterLock);
+	const uint32 id = NumComponentTypes.Load(EMemoryOrder::Relaxed);
+	CHECK(id < MaxComponentTypes);
+	ComponentTypes[id] = { size, alignment, construct, destruct };
+	NumComponentTypes.Store(id + 1, EMemoryOrder::Relaxed);
+	return id;
+}
+
+EntityId EntityStore::Create()
+{
+	return CreateWithMask(0);
+}
+
+EntityId EntityStore::CreateWithMask(ComponentMask components)
+{
+	const uint32 archetypeIndex = FindOrAddArchetype(components);
+	const EntityId entity = AllocateEntity();
+	AddRow(archetypeIndex, entity);
+	const EntityRecord& record = Records[entity.Index];
+	const Archetype& archetype = *Archetypes[archetypeIndex];
+	ConstructRows(archetype, archetype.Chunks[record.Chunk], record.Row, 1, archetype.Mask);
+	return entity;
+}
+
+void EntityStore::CreateBatch(ComponentMask components, uint32 num, Array<EntityId>& outEntities)
+{
+	const uint32 archetypeIndex = FindOrAddArchetype(components);
+	Archetype& archetype = *Archetypes[archetypeIndex];
+	outEntities.Reserve(num);
+	Records.Reserve(num);
+	for (uint32 i = 0; i < num; ++i) {
+		const EntityId entity = AllocateEntity();
+		AddRow(archetypeIndex, entity);
+		outEntities.Add(entity);
+	}
+	// Construct column by column over the rows that were just added
+	uint32 row = archetype.NumRows - num;
+	while (row < archetype.NumRows) {
+		const uint32 chunk = row / archetype.RowsPerChunk;
+		const uint32 chunkRow = row % archetype.RowsPerChunk;
+		const uint32 count = Math::Min(archetype.RowsPerChunk - chunkRow, archetype.NumRows - row);
+		ConstructRows(archetype, archetype.Chunks[chunk], chunkRow, count, archetype.Mask);
+		row += count;
+	}
+}
+
+void EntityStore::Destroy(EntityId entity)
+{
+	const EntityRecord record = GetRecordChecked(entity);
+	const Archetype& archetype = *Archetypes[record.ArchetypeIndex];
+	DestructRows(archetype, archetype.Chunks[record.Chunk], record.Row, 1, archetype.Mask);
+	RemoveRow(record.ArchetypeIndex, record.Chunk, record.Row);
+	FreeRecord(entity.Index);
+}
+
+void EntityStore::DestroyBatch(ArrayView<EntityId> entities)
+{
+	const EntityId* data = entities.ConstData();
+	for (uint32 i = 0; i < entities.Size(); ++i) {
+		Destroy(data[i]);
+	}
+}
+
+void EntityStore::DestroyAll(ComponentMask required)
+{
+	for (uint32 i = 0; i < Archetypes.Num(); ++i) {
+		Archetype& archetype = *Archetypes[i];
+		if ((archetype.Mask & required) != required) {
+			continue;
+		}
+		for (uint32 c = 0; c < archetype.Chunks.Num(); ++c) {
+			uint8* chunk = archetype.Chunks[c];
+			const uint32 num = GetChunkNum(archetype, c);
+			DestructRows(archetype, chunk, 0, num, archetype.Mask);
+			const EntityId* entities = reinterpret_cast<const EntityId*>(chunk);
+			for (uint32 row = 0; row < num; ++row) {
+				FreeRecord(entities[row].Index);
+			}
+			Chunks.Free(chunk);
+		}
+		archetype.Chunks.Reset();
+		archetype.NumRows = 0;
+	}
+}
+
+bool EntityStore::IsAlive(EntityId entity) const
+{
+	return entity.Index < Records.Num()
+		&& Records[entity.Index].Generation == entity.Generation
+		&& Records[entity.Index].ArchetypeIndex != INVALID_INDEX;
+}
+
+uint32 EntityStore::Num() const
+{
+	return NumEntities;
+}
+
+uint32 EntityStore::GetNumArchetypes() const
+{
+	return Archetypes.Num();
+}
+
+ComponentMask EntityStore::GetComponents(EntityId entity) const
+{
+	return Archetypes[GetRecordChecked(entity).ArchetypeIndex]->Mask;
+}
+
+void EntityStore::ChangeComponents(EntityId entity, ComponentMask add, ComponentMask remove)
+{
+	const ComponentMask mask = (GetComponents(entity) | add) & ~remove;
+	MoveEntity(entity, FindOrAddArchetype(mask));
+}
+
+void EntityStore::ChangeComponentsBatch(ArrayView<EntityId> entities, ComponentMask add, ComponentMask remove)
+{
+	const EntityId* data = entities.ConstData();
+	uint32 sourceIndex = INVALID_INDEX;
+	uint32 targetIndex = INVALID_INDEX;
+	for (uint32 i = 0; i < entities.Size(); ++i) {
+		const EntityRecord& record = GetRecordChecked(data[i]);
+		if (record.ArchetypeIndex != sourceIndex) {
+			sourceIndex = record.ArchetypeIndex;
+			targetIndex = FindOrAddArchetype((Archetypes[sourceIndex]->Mask | add) & ~remove);
+		}
+		MoveEntity(data[i], targetIndex);
+	}
+}
+
+void EntityStore::ChangeComponentsAll(ComponentMask required, ComponentMask add, ComponentMask remove)
+{
+	// Archetypes added on the way are targets, and applying the same
+	// change to a target leaves it where it is.
+	const uint32 numArchetypes = Archetypes.Num();
+	for (uint32 i = 0; i < numArchetypes; ++i) {
+		const Archetype& archetype = *Archetypes[i];
+		if ((archetype.Mask & required) != required || archetype.NumRows == 0) {
+			continue;
+		}
+		const ComponentMask mask = (archetype.Mask | add) & ~remove;
+		if (mask != archetype.Mask) {
+			MoveAllRows(i, FindOrAddArchetype(mask));
+		}
+	}
+}
+
+uint32 EntityStore::FindOrAddArchetype(ComponentMask mask)
+{
+	if (const uint32* found = ArchetypeLookup.Find(mask)) {
+		return *found;
+	}
+
+	Archetype* archetype = Memory::PlacementNew<Archetype>(Memory::Allocate(sizeof(Archetype)));
+	archetype->Mask = mask;
+	archetype->NumRows = 0;
+	uint32 rowSize = sizeof(EntityId);
+	for (uint32 id = 0; id < MaxComponentTypes; ++id) {
+		if ((mask >> id) & 1) {
+			archetype->ComponentIds.Add(id);
+			rowSize += ComponentTypes[id].Size;
+		}
+	}
+
+	// Padding between the columns may push the last one out of the chunk,
+	// then try again with a row less.
+	uint32 rowsPerChunk = ChunkSize / rowSize;
+	for (;;) {
+		CHECK(rowsPerChunk > 0);
+		uint32 offset = rowsPerChunk * sizeof(EntityId);
+		for (uint32 i = 0; i < archetype->ComponentIds.Num(); ++i) {
+			const ComponentType& type = ComponentTypes[archetype->ComponentIds[i]];
+			offset = AlignOffset(offset, type.Alignment);
+			archetype->ColumnOffsets[archetype->ComponentIds[i]] = uint16(offset);
+			offset += rowsPerChunk * type.Size;
+		}
+		if (offset <= ChunkSize) {
+			break;
+		}
+		--rowsPerChunk;
+	}
+	archetype->RowsPerChunk = rowsPerChunk;
+
+	const uint32 index = Archetypes.Num();
+	Archetypes.Add(archetype);
+	ArchetypeLookup.Add(mask) = index;
+	return index;
+}
+
+EntityId EntityStore::AllocateEntity()
+{
+	uint32 index = FirstFreeRecord;
+	if (index != INVALID_INDEX) {
+		FirstFreeRecord = Records[index].Row;
+	} else {
+		index = Records.Num();
+		EntityRecord record;
+		record.Generation = 0;
+		Records.Add(record);
+	}
+	++NumEntities;
+
+	EntityId entity;
+	entity.Index = index;
+	entity.Generation = Records[index].Generation;
+	return entity;
+}
+
+void EntityStore::FreeRecord(uint32 index)
+{
+	EntityRecord& record = Records[index];
+	record.ArchetypeIndex = INVALID_INDEX;
+	record.Row = FirstFreeRecord;
+	++record.Generation;
+	FirstFreeRecord = index;
+	--NumEntities;
+}
+
+void EntityStore::AddRow(uint32 archetypeIndex, EntityId entity)
+{
+	Archetype& archetype = *Archetypes[archetypeIndex];
+	const uint32 chunk = archetype.NumRows / archetype.RowsPerChunk;
+	const uint32 row = archetype.NumRows % archetype.RowsPerChunk;
+	if (chunk == archetype.Chunks.Num()) {
+		archetype.Chunks.Add(Chunks.Allocate());
+	}
+	reinterpret_cast<EntityId*>(archetype.Chunks[chunk])[row] = entity;
+	++archetype.NumRows;
+
+	EntityRecord& record = Records[entity.Index];
+	record.ArchetypeIndex = archetypeIndex;
+	record.Chunk = chunk;
+	record.Row = row;
+}
+
+void EntityStore::RemoveRow(uint32 archetypeIndex, uint32 chunk, uint32 row)
+{
+	Archetype& archetype = *Archetypes[archetypeIndex];
+	const uint32 last = archetype.NumRows - 1;
+	const uint32 lastChunk = last / archetype.RowsPerChunk;
+	const uint32 lastRow = last % archetype.RowsPerChunk;
+	if (chunk != lastChunk || row != lastRow) {
+		const uint8* from = archetype.Chunks[lastChunk];
+		CopyRows(archetype, from, lastRow, archetype, archetype.Chunks[chunk], row, 1);
+		EntityRecord& moved = Records[reinterpret_cast<const EntityId*>(from)[lastRow].Index];
+		moved.Chunk = chunk;
+		moved.Row = row;
+	}
+	--archetype.NumRows;
+	if (lastRow == 0) {
+		Chunks.Free(archetype.Chunks.Pop());
+	}
+}
+
+void EntityStore::MoveEntity(EntityId entity, uint32 targetIndex)
+{
+	const EntityRecord source = GetRecordChecked(entity);
+	if (source.ArchetypeIndex == targetIndex) {
+		return;
+	}
+	AddRow(targetIndex, entity);
+	const EntityRecord& target = Records[entity.Index];
+	const Archetype& from = *Archetypes[source.ArchetypeIndex];
+	const Archetype& to = *Archetypes[targetIndex];
+	uint8* fromChunk = from.Chunks[source.Chunk];
+	uint8* toChunk = to.Chunks[target.Chunk];
+	CopyRows(from, fromChunk, source.Row, to, toChunk, target.Row, 1);
+	ConstructRows(to, toChunk, target.Row, 1, to.Mask & ~from.Mask);
+	DestructRows(from, fromChunk, source.Row, 1, from.Mask & ~to.Mask);
+	RemoveRow(source.ArchetypeIndex, source.Chunk, source.Row);
+}
+
+void EntityStore::MoveAllRows(uint32 sourceIndex, uint32 targetIndex)
+{
+	Archetype& from = *Archetypes[sourceIndex];
+	Archetype& to = *Archetypes[targetIndex];
+	for (uint32 c = 0; c < from.Chunks.Num(); ++c) {
+		uint8* fromChunk = from.Chunks[c];
+		const uint32 num = GetChunkNum(from, c);
+		const EntityId* entities = reinterpret_cast<const EntityId*>(fromChunk);
+		// The rows may land in two chunks of the target
+		uint32 done = 0;
+		while (done < num) {
+			const uint32 toChunkIndex = to.NumRows / to.RowsPerChunk;
+			const uint32 toRow = to.NumRows % to.RowsPerChunk;
+			if (toChunkIndex == to.Chunks.Num()) {
+				to.Chunks.Add(Chunks.Allocate());
+			}
+			uint8* toChunk = to.Chunks[toChunkIndex];
+			const uint32 count = Math::Min(num - done, to.RowsPerChunk - toRow);
+			CopyRows(from, fromChunk, done, to, toChunk, toRow, count);
+			ConstructRows(to, toChunk, toRow, count, to.Mask & ~from.Mask);
+			for (uint32 i = 0; i < count; ++i) {
+				EntityRecord& record = Records[entities[done + i].Index];
+				record.ArchetypeIndex = targetIndex;
+				record.Chunk = toChunkIndex;
+				record.Row = toRow + i;
+			}
+			to.NumRows += count;
+			done += count;
+		}
+		DestructRows(from, fromChunk, 0, num, from.Mask & ~to.Mask);
+		Chunks.Free(fromChunk);
+	}
+	from.Chunks.Reset();
+	from.NumRows = 0;
+}
+
+void EntityStore::CopyRows(const Archetype& from, const uint8* fromChunk, uint32 fromRow,
+	const Archetype& to, uint8* toChunk, uint32 toRow, uint32 num)
+{
+	Memory::Copy(fromChunk + uint64(fromRow) * sizeof(EntityId), toChunk + uint64(toRow) * sizeof(EntityId), uint64(num) * sizeof(EntityId));
+	for (uint32 i = 0; i < to.ComponentIds.Num(); ++i) {
+		const uint32 id = to.ComponentIds[i];
+		if (((from.Mask >> id) & 1) == 0) {
+			continue;
+		}
+		const uint32 size = ComponentTypes[id].Size;
+		Memory::Copy(fromChunk + from.ColumnOffsets[id] + uint64(fromRow) * size,
+			toChunk + to.ColumnOffsets[id] + uint64(toRow) * size, uint64(num) * size);
+	}
+}
+
+void EntityStore::ConstructRows(const Archetype& archetype, uint8* chunk, uint32 firstRow, uint32 num, ComponentMask components)
+{
+	for (uint32 i = 0; i < archetype.ComponentIds.Num() && components != 0; ++i) {
+		const uint32 id = archetype.ComponentIds[i];
+		if (((components >> id) & 1) == 0) {
+			continue;
+		}
+		const ComponentType& type = ComponentTypes[id];
+		uint8* column = GetColumn(archetype, chunk, id);
+		for (uint32 row = firstRow; row < firstRow + num; ++row) {
+			type.Construct(column + uint64(row) * type.Size);
+		}
+	}
+}
+
+void EntityStore::DestructRows(const Archetype& archetype, uint8* chunk, uint32 firstRow, uint32 num, ComponentMask components)
+{
+	for (uint32 i = 0; i < archetype.ComponentIds.Num() && components != 0; ++i) {
+		const uint32 id = archetype.ComponentIds[i];
+		const ComponentType& type = ComponentTypes[id];
+		if (((components >> id) & 1) == 0 || type.Destruct == nullptr) {
+			continue;
+		}
+		uint8* column = GetColumn(archetype, chunk, id);
+		for (uint32 row = firstRow; row < firstRow + num; ++row) {
+			type.Destruct(column + uint64(row) * type.Size);
+		}
+	}
+}
+
+uint8* EntityStore::GetColumn(const Archetype& archetype, uint8* chunk, uint32 componentId)
+{
+	return chunk + archetype.ColumnOffsets[componentId];
+}
+
+uint32 EntityStore::GetChunkNum(const Archetype& archetype, uint32 chunk)
+{
+	if (chunk + 1 < archetype.Chunks.Num()) {
+		return archetype.RowsPerChunk;
+	}
+	return archetype.NumRows - chunk * archetype.RowsPerChunk;
+}
+
+const EntityStore::EntityRecord& EntityStore::GetRecordChecked(EntityId entity) const
+{
+	CHECK(IsAlive(entity));
+	return Records[entity.Index];
+}
+
+void* EntityStore::GetComponent(EntityId entity, uint32 componentId) const
+{
+	const EntityRecord& record = GetRecordChecked(entity);
+	const Archetype& archetype = *Archetypes[record.ArchetypeIndex];
+	if (((archetype.Mask >> componentId) & 1) == 0) {
+		return nullptr;
+	}
+	return GetColumn(archetype, archetype.Chunks[record.Chunk], componentId) + uint64(record.Row) * ComponentTypes[componentId].Size;
+}
\ No newline at end of file
@@ -0,0 +1,300 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Allocators/Pool.h"
+#include "Containers/Array.h"
+#include "Containers/HashMap.h"
+#include "Util/Atomic.h"
+
+// Refers to one entity of an EntityStore. Stays valid until the entity
+// is destroyed, after which IsAlive returns false even when its index
+// is handed out again.
+struct EntityId {
+	uint32 Index = INVALID_INDEX;
+	uint32 Generation = 0;
+
+	bool operator==(const EntityId& other) const { return Index == other.Index && Generation == other.Generation; }
+	bool operator!=(const EntityId& other) const { return !(*this == other); }
+};
+
+// One bit per component type, see EntityStore::MaskOf
+typedef uint64 ComponentMask;
+
+// Stores entities by their set of component types, their archetype.
+// Every archetype keeps its rows in chunks of 16 KB from a pool, and
+// a chunk holds one column per component plus one of entity ids, so a
+// query walks plain arrays of exactly the components it reads instead
+// of looking every entity up in a container per component.
+// All chunks of an archetype are full except the last. Removing a row
+// moves the archetype's last row into the hole, and adding or removing
+// components moves the row to another archetype.
+// Components are moved between rows bitwise like Array elements, so they
+// must not point into themselves. Pointers to components are only valid
+// until the next structural change, which must not happen while a query
+// is iterating. At most MaxComponentTypes component types exist.
+class EntityStore {
+public:
+	static constexpr uint32 ChunkSize = 16 * 1024;
+	static constexpr uint32 MaxComponentTypes = 64;
+
+	EntityStore();
+	EntityStore(const EntityStore&) = delete;
+	EntityStore& operator=(const EntityStore&) = delete;
+	~EntityStore();
+
+	template<typename T>
+	static uint32 GetComponentId();
+	template<typename... Ts>
+	static ComponentMask MaskOf();
+
+	// Creates an entity with default constructed components
+	template<typename... Ts>
+	EntityId Create();
+	// Creates an entity with copies of the given components
+	template<typename... Ts>
+	EntityId Create(const Ts&... components);
+	EntityId Create();
+	EntityId CreateWithMask(ComponentMask components);
+	// Adds num entities with default constructed components to
+	// outEntities, filling the archetype's chunks one after the other.
+	template<typename... Ts>
+	void CreateBatch(uint32 num, Array<EntityId>& outEntities);
+	void CreateBatch(ComponentMask components, uint32 num, Array<EntityId>& outEntities);
+	void Destroy(EntityId entity);
+	void DestroyBatch(ArrayView<EntityId> entities);
+	// Destroys every entity with all components of required, by freeing
+	// whole chunks.
+	void DestroyAll(ComponentMask required);
+
+	bool IsAlive(EntityId entity) const;
+	uint32 Num() const;
+	uint32 GetNumArchetypes() const;
+	ComponentMask GetComponents(EntityId entity) const;
+
+	template<typename T>
+	bool Has(EntityId entity) const;
+	// Returns nullptr when the entity doesn't have the component
+	template<typename T>
+	T* Get(EntityId entity);
+	template<typename T>
+	const T* Get(EntityId entity) const;
+
+	// Moves the entity to the archetype with add and without remove.
+	// Components that are added are default constructed.
+	void ChangeComponents(EntityId entity, ComponentMask add, ComponentMask remove);
+	// Like ChangeComponents for every entity, looking the target
+	// archetype up once per run of entities that share an archetype.
+	void ChangeComponentsBatch(ArrayView<EntityId> entities, ComponentMask add, ComponentMask remove);
+	// Like ChangeComponents for every entity with all components of
+	// required, which moves their chunks column by column.
+	void ChangeComponentsAll(ComponentMask required, ComponentMask add, ComponentMask remove);
+	template<typename... Ts>
+	void AddComponents(EntityId entity);
+	template<typename... Ts>
+	void RemoveComponents(EntityId entity);
+
+	// Calls visit(uint32 num, const EntityId* entities, Ts*... columns)
+	// for every chunk of the archetypes that have all of Ts, with num
+	// rows in every column.
+	template<typename... Ts, typename F>
+	void ForEachChunk(F&& visit);
+	// Calls visit(Ts&... components) for every entity that has all of Ts
+	template<typename... Ts, typename F>
+	void ForEach(F&& visit);
+
+private:
+	struct ComponentType {
+		uint32 Size;
+		uint32 Alignment;
+		void (*Construct)(void* component);
+		// nullptr when destroying the component does nothing
+		void (*Destruct)(void* component);
+	};
+
+	struct Archetype {
+		ComponentMask Mask;
+		uint32 RowsPerChunk;
+		// Rows in all chunks together
+		uint32 NumRows;
+		Array<uint32> ComponentIds;
+		// The offset of every component's column in a chunk, indexed by
+		// component id, only valid for components in Mask. The column of
+		// entity ids starts at offset 0.
+		uint16 ColumnOffsets[MaxComponentTypes];
+		Array<uint8*> Chunks;
+	};
+
+	struct EntityRecord {
+		// INVALID_INDEX when the entity is destroyed
+		uint32 ArchetypeIndex;
+		uint32 Chunk;
+		// The next free record when the entity is destroyed
+		uint32 Row;
+		uint32 Generation;
+	};
+
+	class ChunkPool : public GPool<ChunkSize, 64> {
+	public:
+		uint8* Allocate() { return Allocate_Internal(); }
+		void Free(uint8* chunk) { Free_Internal(chunk); }
+	};
+
+	template<typename T>
+	static uint32 GetRegisteredId();
+	static uint32 RegisterComponent(uint32 size, uint32 alignment, void (*construct)(void*), void (*destruct)(void*));
+	template<typename T>
+	static void ConstructComponent(void* component);
+	template<typename T>
+	static void DestructComponent(void* component);
+
+	uint32 FindOrAddArchetype(ComponentMask mask);
+	EntityId AllocateEntity();
+	void FreeRecord(uint32 index);
+	// Adds a row to the end of the archetype and points the entity at
+	// it, leaving its components uninitialized.
+	void AddRow(uint32 archetypeIndex, EntityId entity);
+	// Fills the hole at chunk and row with the archetype's last row,
+	// without destroying the components in the hole.
+	void RemoveRow(uint32 archetypeIndex, uint32 chunk, uint32 row);
+	void MoveEntity(EntityId entity, uint32 targetIndex);
+	// Appends every row of the source to the target, a chunk at a time
+	void MoveAllRows(uint32 sourceIndex, uint32 targetIndex);
+	// Copies the entity ids and the components both archetypes have of
+	// num rows, which must not cross the end of either chunk.
+	static void CopyRows(const Archetype& from, const uint8* fromChunk, uint32 fromRow,
+		const Archetype& to, uint8* toChunk, uint32 toRow, uint32 num);
+	static void ConstructRows(const Archetype& archetype, uint8* chunk, uint32 firstRow, uint32 num, ComponentMask components);
+	static void DestructRows(const Archetype& archetype, uint8* chunk, uint32 firstRow, uint32 num, ComponentMask components);
+	static uint8* GetColumn(const Archetype& archetype, uint8* chunk, uint32 componentId);
+	static uint32 GetChunkNum(const Archetype& archetype, uint32 chunk);
+	const EntityRecord& GetRecordChecked(EntityId entity) const;
+	void* GetComponent(EntityId entity, uint32 componentId) const;
+
+	// Shared by all stores, so a component has the same id in each
+	static ComponentType ComponentTypes[MaxComponentTypes];
+	static Atomic<uint32> NumComponentTypes;
+
+	Array<Archetype*> Archetypes;
+	HashMap<ComponentMask, uint32> ArchetypeLookup;
+	Array<EntityRecord> Records;
+	uint32 FirstFreeRecord;
+	uint32 NumEntities;
+	ChunkPool Chunks;
+};
+
+template<typename T>
+uint32 EntityStore::GetComponentId()
+{
+	// A query for const T reads the same column as one for T
+	return GetRegisteredId<typename RemoveCV<T>::Type>();
+}
+
+template<typename T>
+uint32 EntityStore::GetRegisteredId()
+{
+	static const uint32 id = RegisterComponent(sizeof(T), alignof(T), &ConstructComponent<T>,
+		__has_trivial_destructor(T) ? nullptr : &DestructComponent<T>);
+	return id;
+}
+
+template<typename... Ts>
+ComponentMask EntityStore::MaskOf()
+{
+	return ((ComponentMask(1) << GetComponentId<Ts>()) | ... | ComponentMask(0));
+}
+
+template<typename... Ts>
+EntityId EntityStore::Create()
+{
+	return CreateWithMask(MaskOf<Ts...>());
+}
+
+template<typename... Ts>
+EntityId EntityStore::Create(const Ts&... components)
+{
+	const uint32 archetypeIndex = FindOrAddArchetype(MaskOf<Ts...>());
+	const EntityId entity = AllocateEntity();
+	AddRow(archetypeIndex, entity);
+	const EntityRecord& record = Records[entity.Index];
+	const Archetype& archetype = *Archetypes[archetypeIndex];
+	uint8* chunk = archetype.Chunks[record.Chunk];
+	(Memory::PlacementNew<Ts>(GetColumn(archetype, chunk, GetComponentId<Ts>()) + uint64(record.Row) * sizeof(Ts), components), ...);
+	return entity;
+}
+
+template<typename... Ts>
+void EntityStore::CreateBatch(uint32 num, Array<EntityId>& outEntities)
+{
+	CreateBatch(MaskOf<Ts...>(), num, outEntities);
+}
+
+template<typename T>
+bool EntityStore::Has(EntityId entity) const
+{
+	return (GetComponents(entity) & MaskOf<T>()) != 0;
+}
+
+template<typename T>
+T* EntityStore::Get(EntityId entity)
+{
+	return static_cast<T*>(GetComponent(entity, GetComponentId<T>()));
+}
+
+template<typename T>
+const T* EntityStore::Get(EntityId entity) const
+{
+	return static_cast<const T*>(GetComponent(entity, GetComponentId<T>()));
+}
+
+template<typename... Ts>
+void EntityStore::AddComponents(EntityId entity)
+{
+	ChangeComponents(entity, MaskOf<Ts...>(), 0);
+}
+
+template<typename... Ts>
+void EntityStore::RemoveComponents(EntityId entity)
+{
+	ChangeComponents(entity, 0, MaskOf<Ts...>());
+}
+
+template<typename... Ts, typename F>
+void EntityStore::ForEachChunk(F&& visit)
+{
+	const ComponentMask required = MaskOf<Ts...>();
+	for (uint32 i = 0; i < Archetypes.Num(); ++i) {
+		const Archetype& archetype = *Archetypes[i];
+		if ((archetype.Mask & required) != required) {
+			continue;
+		}
+		for (uint32 c = 0; c < archetype.Chunks.Num(); ++c) {
+			uint8* chunk = archetype.Chunks[c];
+			visit(GetChunkNum(archetype, c), reinterpret_cast<const EntityId*>(chunk),
+				reinterpret_cast<Ts*>(GetColumn(archetype, chunk, GetComponentId<Ts>()))...);
+		}
+	}
+}
+
+template<typename... Ts, typename F>
+void EntityStore::ForEach(F&& visit)
+{
+	ForEachChunk<Ts...>([&visit](uint32 num, const EntityId*, Ts*... columns) {
+		for (uint32 i = 0; i < num; ++i) {
+			visit(columns[i]...);
+		}
+	});
+}
+
+template<typename T>
+void EntityStore::ConstructComponent(void* component)
+{
+	Memory::PlacementNew<T>(component);
+}
+
+template<typename T>
+void EntityStore::DestructComponent(void* component)
+{
+	static_cast<T*>(component)->~T();
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/FrozenHashMap.h"
+
+bool FrozenHashMapHeader::IsValid(uint32 keySize, uint32 valueSize, uint32 entrySize, uint64 size) const
+{
+	if (size < sizeof(FrozenHashMapHeader) || Magic != MagicValue || Version != CurrentVersion) {
+		return false;
+	}
+	if (KeySize != keySize || ValueSize != valueSize || EntrySize != entrySize) {
+		return false;
+	}
+	if (Capacity == 0 || (Capacity & (Capacity - 1)) != 0 || NumEntries >= Capacity) {
+		return false;
+	}
+	if (TotalSize > size || (HashesOffset & 3) != 0 || (EntriesOffset & 7) != 0) {
+		return false;
+	}
+	return HashesOffset >= sizeof(FrozenHashMapHeader)
+		&& HashesOffset + sizeof(uint32) * uint64(Capacity) <= TotalSize
+		&& EntriesOffset >= sizeof(FrozenHashMapHeader)
+		&& EntriesOffset + uint64(entrySize) * Capacity <= TotalSize;
+}
\ No newline at end of file
@@ -0,0 +1,201 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "HashMap.h"
+#include "File/File.h"
+
+// The fixed header at the start of a frozen hash map. Every offset is
+// relative to the start of the header, so the table can be loaded at
+// any address.
+struct FrozenHashMapHeader {
+	static constexpr uint32 MagicValue = 0x48464B48; // "HKFH"
+	static constexpr uint32 CurrentVersion = 1;
+	
+	uint32 Magic;
+	uint32 Version;
+	uint32 KeySize;
+	uint32 ValueSize;
+	uint32 EntrySize;
+	uint32 NumEntries;
+	// Always a power of two
+	uint32 Capacity;
+	uint32 Padding;
+	// uint32 per slot, 0 marks an empty slot
+	uint64 HashesOffset;
+	uint64 EntriesOffset;
+	uint64 TotalSize;
+	
+	// Checks the header and that every array fits in size bytes
+	bool IsValid(uint32 keySize, uint32 valueSize, uint32 entrySize, uint64 size) const;
+};
+
+// A read-only HashMap that is queried in place in a block of memory,
+// usually a MappedFile, so loading it takes no parsing and no copies.
+// Freeze writes the table from a HashMap, lookups then behave the same
+// as the HashMap they were frozen from.
+// Keys and values are stored as raw bytes in native byte order, so both
+// must be plain data without pointers.
+template<class TKey, class TValue>
+class FrozenHashMap {
+	static_assert(__is_trivially_copyable(TKey), "FrozenHashMap keys must be plain data");
+	static_assert(__is_trivially_copyable(TValue), "FrozenHashMap values must be plain data");
+public:
+	FrozenHashMap();
+	
+	// Points the map at a frozen table, which must be 8 byte aligned
+	// and outlive the map. Returns false if the data isn't a valid
+	// table for this key and value type.
+	bool Initialize(const void* data, uint64 size);
+	
+	const TValue* Find(const TKey& key) const;
+	const TValue& FindChecked(const TKey& key) const;
+	bool Contains(const TKey& key) const;
+	uint32 Num() const;
+	
+	// Replaces the contents of outData with the frozen table
+	static void Freeze(const HashMap<TKey, TValue>& map, Array<uint8>& outData);
+	static void Write(const HashMap<TKey, TValue>& map, File& file);
+	
+private:
+	struct Entry {
+		TKey Key;
+		TValue Value;
+	};
+	
+	static uint32 HashOf(const TKey& key);
+	
+	const FrozenHashMapHeader* Header;
+	const uint32* Hashes;
+	const Entry* Entries;
+};
+
+template<class TKey, class TValue>
+FrozenHashMap<TKey, TValue>::FrozenHashMap()
+	: Header(nullptr)
+	, Hashes(nullptr)
+	, Entries(nullptr)
+{
+}
+
+template<class TKey, class TValue>
+bool FrozenHashMap<TKey, TValue>::Initialize(const void* data, uint64 size)
+{
+	Header = nullptr;
+	Hashes = nullptr;
+	Entries = nullptr;
+	
+	if ((uintptr(data) & 7) != 0) {
+		return false;
+	}
+	const FrozenHashMapHeader* header = static_cast<const FrozenHashMapHeader*>(data);
+	if (!header->IsValid(sizeof(TKey), sizeof(TValue), sizeof(Entry), size)) {
+		return false;
+	}
+	
+	const uint8* bytes = static_cast<const uint8*>(data);
+	Header = header;
+	Hashes = reinterpret_cast<const uint32*>(bytes + header->HashesOffset);
+	Entries = reinterpret_cast<const Entry*>(bytes + header->EntriesOffset);
+	return true;
+}
+
+template<class TKey, class TValue>
+const TValue* FrozenHashMap<TKey, TValue>::Find(const TKey& key) const
+{
+	if (UNLIKELY(Header == nullptr)) {
+		return nullptr;
+	}
+	const uint32 hash = HashOf(key);
+	const uint32 mask = Header->Capacity - 1;
+	uint32 slot = hash & mask;
+	// A valid table always has an empty slot, the bound only stops a
+	// corrupt one from probing forever.
+	for (uint32 probe = 0; probe < Header->Capacity && Hashes[slot] != 0; ++probe) {
+		if (Hashes[slot] == hash && Entries[slot].Key == key) {
+			return &Entries[slot].Value;
+		}
+		slot = (slot + 1) & mask;
+	}
+	return nullptr;
+}
+
+template<class TKey, class TValue>
+const TValue& FrozenHashMap<TKey, TValue>::FindChecked(const TKey& key) const
+{
+	const TValue* value = Find(key);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<class TKey, class TValue>
+bool FrozenHashMap<TKey, TValue>::Contains(const TKey& key) const
+{
+	return Find(key) != nullptr;
+}
+
+template<class TKey, class TValue>
+uint32 FrozenHashMap<TKey, TValue>::Num() const
+{
+	return Header != nullptr ? Header->NumEntries : 0;
+}
+
+template<class TKey, class TValue>
+void FrozenHashMap<TKey, TValue>::Freeze(const HashMap<TKey, TValue>& map, Array<uint8>& outData)
+{
+	uint32 capacity = Math::NextPowerOfTwo(uint32(map.Num() / SetMaxLoadFactor) + 1);
+	if (capacity < 8) {
+		capacity = 8;
+	}
+	
+	FrozenHashMapHeader header;
+	Memory::FillZero(&header, sizeof(header));
+	header.Magic = FrozenHashMapHeader::MagicValue;
+	header.Version = FrozenHashMapHeader::CurrentVersion;
+	header.KeySize = sizeof(TKey);
+	header.ValueSize = sizeof(TValue);
+	header.EntrySize = sizeof(Entry);
+	header.NumEntries = map.Num();
+	header.Capacity = capacity;
+	header.HashesOffset = sizeof(FrozenHashMapHeader);
+	header.EntriesOffset = (header.HashesOffset + sizeof(uint32) * capacity + 7) & ~uint64(7);
+	header.TotalSize = header.EntriesOffset + sizeof(Entry) * uint64(capacity);
+	
+	// The header has to start the data for the offsets to line up.
+	// Zeroed so padding bytes are written deterministically.
+	outData.Reset();
+	uint8* data = outData.AddUninitialized(uint32(header.TotalSize));
+	Memory::FillZero(data, header.TotalSize);
+	Memory::Copy(&header, data, sizeof(header));
+	uint32* hashes = reinterpret_cast<uint32*>(data + header.HashesOffset);
+	Entry* entries = reinterpret_cast<Entry*>(data + header.EntriesOffset);
+	
+	const uint32 mask = capacity - 1;
+	map.ForEach([&](const TKey& key, const TValue& value) {
+		const uint32 hash = HashOf(key);
+		uint32 slot = hash & mask;
+		while (hashes[slot] != 0) {
+			slot = (slot + 1) & mask;
+		}
+		hashes[slot] = hash;
+		Memory::Copy(&key, &entries[slot].Key, sizeof(TKey));
+		Memory::Copy(&value, &entries[slot].Value, sizeof(TValue));
+	});
+}
+
+template<class TKey, class TValue>
+void FrozenHashMap<TKey, TValue>::Write(const HashMap<TKey, TValue>& map, File& file)
+{
+	Array<uint8> data;
+	Freeze(map, data);
+	file.Write(data.GetData(), data.Num());
+}
+
+template<class TKey, class TValue>
+uint32 FrozenHashMap<TKey, TValue>::HashOf(const TKey& key)
+{
+	// 0 is reserved for empty slots
+	const uint32 hash = Hasher::Hash<uint32>(key);
+	return hash != 0 ? hash : 1;
+}
\ No newline at end of file
@@ -23,6 +23,11 @@ struct HashMapEntry {
 	bool operator==(const HashMapEntry& other) const {
 		return Key == other.Key;
 	}
+	
+	template<typename K>
+	bool operator==(const K& key) const {
+		return Key == key;
+	}
 };
 
 template<class TKey, class TValue>
@@ -39,16 +44,48 @@ public:
 	HashMap& operator=(HashMap&& other);
 
 	TValue& Add(const TKey& key);
-	TValue& FindOrAdd(const TKey& key);
+	// Optionally reports in outAdded whether the key was newly added
+	TValue& FindOrAdd(const TKey& key, bool* outAdded = nullptr);
 	TValue* Find(const TKey& key);
 	const TValue* Find(const TKey& key) const;
 	TValue& FindChecked(const TKey& key);
 	const TValue& FindChecked(const TKey& key) const;
 
+	// Lookups with any key type K that hashes identically to TKey
+	// and compares to it with ==, e.g. a StringView for String keys.
+	// These never construct a TKey or TValue to probe with.
+	template<typename K>
+	TValue* FindAs(const K& key);
+	template<typename K>
+	const TValue* FindAs(const K& key) const;
+	template<typename K>
+	TValue& FindCheckedAs(const K& key);
+	template<typename K>
+	const TValue& FindCheckedAs(const K& key) const;
+
+	// Finds all keys at once, writing a pointer to the value or nullptr
+	// for every key. See Set::FindBatch.
+	void FindBatch(const ArrayView<TKey>& keys, Array<TValue*>& outValues);
+	void FindBatch(const ArrayView<TKey>& keys, Array<const TValue*>& outValues) const;
+
 	void Remove(const TKey& key);
+	template<typename K>
+	void RemoveAs(const K& key);
+	void Reserve(uint32 num);
 	void Clear();
 	
 	void GetItems(Array<HashMapEntry<TKey, TValue>>& items) const;
+	uint32 Num() const;
+	
+	// Calls f(key, value) for every entry, in table order.
+	template<typename F>
+	void ForEach(const F& f);
+	template<typename F>
+	void ForEach(const F& f) const;
+	
+#if HASH_TABLE_STATS
+	void GetStats(HashTableStats& outStats) const;
+#endif
 };
 
 template<class TKey, class TValue>
@@ -68,7 +105,7 @@ HashMap<TKey, TValue>::HashMap(const HashMap& copy)
 
 template<class TKey, class TValue>
 HashMap<TKey, TValue>::HashMap(HashMap&& move)
-	: Super(move)
+	: Super(Move(move))
 {}
 
 template<class TKey, class TValue>
@@ -85,40 +122,59 @@ HashMap<TKey, TValue>& HashMap<TKey, TValue>::operator=(const HashMap& other)
 template<class TKey, class TValue>
 HashMap<TKey, TValue>& HashMap<TKey, TValue>::operator=(HashMap&& other)
 {
-	Super::operator=(other);
+	Super::operator=(Move(other));
 	return *this;
 }
 
 template<class TKey, class TValue>
 TValue& HashMap<TKey, TValue>::Add(const TKey& key)
 {
-	HashMapEntry<TKey, TValue> entry;
-	entry.Key = key;
-	entry.Value = TValue();
-	Super::Add(entry);
-	uint32 index = Super::FindIndex(HashMapEntry<TKey, TValue>(key));
-	return Super::Entries[index].Item.Value;
+	return FindOrAdd(key);
 }
 
 template<class TKey, class TValue>
-TValue& HashMap<TKey, TValue>::FindOrAdd(const TKey& key)
+TValue& HashMap<TKey, TValue>::FindOrAdd(const TKey& key, bool* outAdded)
 {
-	int32 index = Super::FindIndex(HashMapEntry<TKey, TValue>(key));
-	if (index != -1) {
-		return Super::Entries[index].Item.Value;
+	bool bClaimed = false;
+	const uint32 index = Super::FindOrClaimIndex(key, Super::HashOf(key), bClaimed);
+	if (bClaimed) {
+		Memory::PlacementNew<HashMapEntry<TKey, TValue>>(&Super::Entries[index].Item, key);
 	}
-	
-	HashMapEntry<TKey, TValue> entry;
-	entry.Key = key;
-	entry.Value = TValue();
-	Super::Add(entry);
-	return Super::Entries[Super::FindIndex(HashMapEntry<TKey, TValue>(key))].Item.Value;
+	if (outAdded) {
+		*outAdded = bClaimed;
+	}
+	return Super::Entries[index].Item.Value;
 }
 
 template<class TKey, class TValue>
 TValue* HashMap<TKey, TValue>::Find(const TKey& key)
 {
-	int32 index = Super::FindIndex(HashMapEntry<TKey, TValue>(key));
+	return FindAs(key);
+}
+
+template<class TKey, class TValue>
+const TValue* HashMap<TKey, TValue>::Find(const TKey& key) const
+{
+	return FindAs(key);
+}
+
+template<class TKey, class TValue>
+TValue& HashMap<TKey, TValue>::FindChecked(const TKey& key)
+{
+	return FindCheckedAs(key);
+}
+
+template<class TKey, class TValue>
+const TValue& HashMap<TKey, TValue>::FindChecked(const TKey& key) const
+{
+	return FindCheckedAs(key);
+}
+
+template<class TKey, class TValue>
+template<typename K>
+TValue* HashMap<TKey, TValue>::FindAs(const K& key)
+{
+	int32 index = Super::FindIndexHashed(key, Super::HashOf(key));
 	if (index != -1) {
 		return &Super::Entries[index].Item.Value;
 	}
@@ -126,9 +182,10 @@ TValue* HashMap<TKey, TValue>::Find(const TKey& key)
 }
 
 template<class TKey, class TValue>
-const TValue* HashMap<TKey, TValue>::Find(const TKey& key) const
+template<typename K>
+const TValue* HashMap<TKey, TValue>::FindAs(const K& key) const
 {
-	int32 index = Super::FindIndex(HashMapEntry<TKey, TValue>(key));
+	int32 index = Super::FindIndexHashed(key, Super::HashOf(key));
 	if (index != -1) {
 		return &Super::Entries[index].Item.Value;
 	}
@@ -136,25 +193,63 @@ const TValue* HashMap<TKey, TValue>::Find(const TKey& key) const
 }
 
 template<class TKey, class TValue>
-TValue& HashMap<TKey, TValue>::FindChecked(const TKey& key)
+template<typename K>
+TValue& HashMap<TKey, TValue>::FindCheckedAs(const K& key)
 {
-	int32 index = Super::FindIndex(HashMapEntry<TKey, TValue>(key));
+	int32 index = Super::FindIndexHashed(key, Super::HashOf(key));
 	CHECK(index != -1);
 	return Super::Entries[index].Item.Value;
 }
 
 template<class TKey, class TValue>
-const TValue& HashMap<TKey, TValue>::FindChecked(const TKey& key) const
+template<typename K>
+const TValue& HashMap<TKey, TValue>::FindCheckedAs(const K& key) const
 {
-	int32 index = Super::FindIndex(HashMapEntry<TKey, TValue>(key));
+	int32 index = Super::FindIndexHashed(key, Super::HashOf(key));
 	CHECK(index != -1);
 	return Super::Entries[index].Item.Value;
 }
 
+template<class TKey, class TValue>
+void HashMap<TKey, TValue>::FindBatch(const ArrayView<TKey>& keys, Array<TValue*>& outValues)
+{
+	outValues.Reset();
+	TValue** out = outValues.AddUninitialized(keys.Size());
+	Super::FindIndexBatch(keys.ConstData(), keys.Size(), [&](uint32 keyIndex, int32 index) {
+		out[keyIndex] = index >= 0 ? &Super::Entries[index].Item.Value : nullptr;
+	});
+}
+
+template<class TKey, class TValue>
+void HashMap<TKey, TValue>::FindBatch(const ArrayView<TKey>& keys, Array<const TValue*>& outValues) const
+{
+	outValues.Reset();
+	const TValue** out = outValues.AddUninitialized(keys.Size());
+	Super::FindIndexBatch(keys.ConstData(), keys.Size(), [&](uint32 keyIndex, int32 index) {
+		out[keyIndex] = index >= 0 ? &Super::Entries[index].Item.Value : nullptr;
+	});
+}
+
 template<class TKey, class TValue>
 void HashMap<TKey, TValue>::Remove(const TKey& key)
 {
-	Super::Remove(HashMapEntry<TKey, TValue>(key));
+	RemoveAs(key);
+}
+
+template<class TKey, class TValue>
+template<typename K>
+void HashMap<TKey, TValue>::RemoveAs(const K& key)
+{
+	int32 index = Super::FindIndexHashed(key, Super::HashOf(key));
+	if (index != -1) {
+		Super::RemoveAtIndex(index);
+	}
+}
+
+template<class TKey, class TValue>
+void HashMap<TKey, TValue>::Reserve(uint32 num)
+{
+	Super::Reserve(num);
 }
 
 template<class TKey, class TValue>
@@ -167,4 +262,37 @@ template<class TKey, class TValue>
 void HashMap<TKey, TValue>::GetItems(Array<HashMapEntry<TKey, TValue>>& items) const
 {
 	Super::GetItems(items);
-}
\ No newline at end of file
+}
+
+template<class TKey, class TValue>
+uint32 HashMap<TKey, TValue>::Num() const
+{
+	return Super::Num();
+}
+
+template<class TKey, class TValue>
+template<typename F>
+void HashMap<TKey, TValue>::ForEach(const F& f)
+{
+	Super::ForEach([&](HashMapEntry<TKey, TValue>& entry) {
+		const TKey& key = entry.Key;
+		f(key, entry.Value);
+	});
+}
+
+template<class TKey, class TValue>
+template<typename F>
+void HashMap<TKey, TValue>::ForEach(const F& f) const
+{
+	Super::ForEach([&](const HashMapEntry<TKey, TValue>& entry) {
+		f(entry.Key, entry.Value);
+	});
+}
+
+#if HASH_TABLE_STATS
+template<class TKey, class TValue>
+void HashMap<TKey, TValue>::GetStats(HashTableStats& outStats) const
+{
+	Super::GetStats(outStats);
+}
+#endif
\ No newline at end of file
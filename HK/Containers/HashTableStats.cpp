@@ -0,0 +1,26 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/HashTableStats.h"
+
+#include "Util/Out.h"
+
+String HashTableStats::ToString() const
+{
+	String result = String::Format("entries {}, capacity {}, load {}, bytes/entry {}\n"_sv,
+		NumEntries, Capacity, LoadFactor, BytesPerEntry);
+	result += String::Format("probe length avg {}, max {}, displaced {}\n"_sv,
+		AverageProbeLength, MaxProbeLength, NumDisplaced);
+	result += String::Format("rehashes {}, hole moves {}\n"_sv,
+		Counters.NumRehashes, Counters.NumHoleMoves);
+	result += "probe length histogram:"_sv;
+	for (uint32 i = 0; i < HistogramSize; ++i) {
+		result += String::Format(" {}{}:{}"_sv, i + 1, i + 1 == HistogramSize ? "+" : "", ProbeLengthHistogram[i]);
+	}
+	return result;
+}
+
+void HashTableStats::Print(StringView name) const
+{
+	Out::WriteLine("{}: {}"_sv, name, ToString());
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Common/Types.h"
+
+class AnsiString;
+typedef AnsiString String;
+
+// Set and HashMap only track and report these stats when the whole
+// build is compiled with HASH_TABLE_STATS=1, see the HK_HASH_TABLE_STATS
+// CMake option. Otherwise the counters and GetStats compile out.
+#ifndef HASH_TABLE_STATS
+#define HASH_TABLE_STATS 0
+#endif
+
+// Counters a hash table keeps while it is mutated.
+struct HashTableCounters
+{
+	uint32 NumRehashes = 0;
+	// Entries moved by backward shifting after a removal
+	uint32 NumHoleMoves = 0;
+};
+
+// A snapshot of the layout of a hash table, gathered by scanning it.
+struct HashTableStats
+{
+	static constexpr uint32 HistogramSize = 16;
+	
+	uint32 NumEntries = 0;
+	uint32 Capacity = 0;
+	f32 LoadFactor = 0.f;
+	f32 BytesPerEntry = 0.f;
+	
+	// The probes a successful lookup takes, 1 for an entry in its ideal slot
+	f32 AverageProbeLength = 0.f;
+	uint32 MaxProbeLength = 0;
+	// Entries not in their ideal slot
+	uint32 NumDisplaced = 0;
+	// The number of entries found in i+1 probes, the last
+	// bucket counts all entries that take that many or more.
+	uint32 ProbeLengthHistogram[HistogramSize] = {};
+	
+	HashTableCounters Counters;
+	
+	String ToString() const;
+	void Print(StringView name) const;
+};
@@ -0,0 +1,209 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/HyperLogLog.h"
+
+#include "Common/Math.h"
+#include "File/File.h"
+
+static constexpr uint32 HyperLogLogMagic = 0x4C484B48; // "HKHL"
+
+struct HyperLogLogFileHeader {
+	uint32 Magic;
+	uint32 Precision;
+	// 0 when the registers follow densely
+	uint32 NumSparse;
+	uint32 Padding;
+};
+
+HyperLogLog::HyperLogLog(uint32 precision)
+	: Precision(precision)
+{
+	CHECK(precision >= MinPrecision && precision <= MaxPrecision);
+}
+
+void HyperLogLog::AddHash(uint64 hash)
+{
+	// The top bits pick the register, the rest gives the rank
+	const uint32 index = uint32(hash >> (64 - Precision));
+	const uint64 rest = hash << Precision;
+	const uint8 rank = rest != 0 ? uint8(Math::CountLeadingZeros(rest) + 1) : uint8(64 - Precision + 1);
+	SetRegister(index, rank);
+}
+
+uint64 HyperLogLog::Estimate() const
+{
+	const uint32 numRegisters = 1 << Precision;
+	f64 sum = 0.0;
+	uint32 numZero = 0;
+	if (IsSparse()) {
+		for (uint32 entry : Sparse) {
+			sum += 1.0 / f64(uint64(1) << (entry & 0xFF));
+		}
+		numZero = numRegisters - Sparse.Num();
+		sum += numZero;
+	} else {
+		for (uint8 rank : Registers) {
+			sum += 1.0 / f64(uint64(1) << rank);
+			numZero += rank == 0;
+		}
+	}
+	
+	const f64 m = numRegisters;
+	const f64 alpha = numRegisters == 16 ? 0.673
+		: numRegisters == 32 ? 0.697
+		: numRegisters == 64 ? 0.709
+		: 0.7213 / (1.0 + 1.079 / m);
+	f64 estimate = alpha * m * m / sum;
+	// Linear counting is more accurate while many registers are unset
+	if (estimate <= 2.5 * m && numZero > 0) {
+		estimate = m * Math::Log(m / f64(numZero));
+	}
+	return uint64(estimate + 0.5);
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other)
+{
+	CHECK(Precision == other.Precision);
+	if (other.IsSparse()) {
+		for (uint32 entry : other.Sparse) {
+			SetRegister(entry >> 8, uint8(entry & 0xFF));
+		}
+		return;
+	}
+	
+	ConvertToDense();
+	// A plain byte wise max, which compilers vectorize
+	uint8* RESTRICT(registers) = Registers.GetData();
+	const uint8* RESTRICT(otherRegisters) = other.Registers.GetData();
+	for (uint32 i = 0; i < Registers.Num(); ++i) {
+		registers[i] = registers[i] > otherRegisters[i] ? registers[i] : otherRegisters[i];
+	}
+}
+
+void HyperLogLog::Clear()
+{
+	Registers.Reset();
+	Sparse.Reset();
+}
+
+bool HyperLogLog::IsSparse() const
+{
+	return Registers.Num() == 0;
+}
+
+uint32 HyperLogLog::GetPrecision() const
+{
+	return Precision;
+}
+
+void HyperLogLog::Save(File& file) const
+{
+	HyperLogLogFileHeader header;
+	header.Magic = HyperLogLogMagic;
+	header.Precision = Precision;
+	header.NumSparse = IsSparse() ? Sparse.Num() : 0;
+	header.Padding = 0;
+	file.Write(&header, sizeof(header));
+	if (IsSparse()) {
+		file.Write(Sparse.GetData(), sizeof(uint32) * uint64(Sparse.Num()));
+	} else {
+		file.Write(Registers.GetData(), Registers.Num());
+	}
+}
+
+bool HyperLogLog::Load(File& file)
+{
+	Clear();
+	HyperLogLogFileHeader header;
+	if (file.Read(reinterpret_cast<uint8*>(&header), sizeof(header)) != sizeof(header) ||
+		header.Magic != HyperLogLogMagic ||
+		header.Precision < MinPrecision || header.Precision > MaxPrecision) {
+		return false;
+	}
+	
+	// The largest rank AddHash gives with this precision
+	const uint32 numRegisters = 1 << header.Precision;
+	const uint32 maxRank = 64 - header.Precision + 1;
+	if (header.NumSparse > 0) {
+		// SetRegister turns dense before the sparse entries outgrow the
+		// registers, so a longer list can't come from Save.
+		if (uint64(header.NumSparse) * sizeof(uint32) >= numRegisters) {
+			return false;
+		}
+		const uint64 numBytes = sizeof(uint32) * uint64(header.NumSparse);
+		const uint32* entries = Sparse.AddUninitialized(header.NumSparse);
+		bool bValid = file.Read(reinterpret_cast<uint8*>(Sparse.GetData()), numBytes) == numBytes;
+		for (uint32 i = 0; bValid && i < header.NumSparse; ++i) {
+			const uint32 index = entries[i] >> 8;
+			const uint32 rank = entries[i] & 0xFF;
+			bValid = index < numRegisters && rank > 0 && rank <= maxRank
+				&& (i == 0 || (entries[i - 1] >> 8) < index);
+		}
+		if (!bValid) {
+			Clear();
+			return false;
+		}
+	} else {
+		const uint8* registers = Registers.AddUninitialized(numRegisters);
+		bool bValid = file.Read(Registers.GetData(), numRegisters) == numRegisters;
+		for (uint32 i = 0; bValid && i < numRegisters; ++i) {
+			bValid = registers[i] <= maxRank;
+		}
+		if (!bValid) {
+			Clear();
+			return false;
+		}
+	}
+	Precision = header.Precision;
+	return true;
+}
+
+void HyperLogLog::SetRegister(uint32 index, uint8 rank)
+{
+	if (!IsSparse()) {
+		if (rank > Registers[index]) {
+			Registers[index] = rank;
+		}
+		return;
+	}
+	
+	// Binary search for the first entry at or after index
+	uint32 low = 0;
+	uint32 high = Sparse.Num();
+	while (low < high) {
+		const uint32 mid = (low + high) / 2;
+		if ((Sparse[mid] >> 8) < index) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	
+	const uint32 entry = (index << 8) | rank;
+	if (low < Sparse.Num() && (Sparse[low] >> 8) == index) {
+		if (rank > (Sparse[low] & 0xFF)) {
+			Sparse[low] = entry;
+		}
+		return;
+	}
+	Sparse.InsertAt(low, entry);
+	
+	// Four bytes per sparse entry against one per dense register
+	if (Sparse.Num() * sizeof(uint32) >= (1u << Precision)) {
+		ConvertToDense();
+	}
+}
+
+void HyperLogLog::ConvertToDense()
+{
+	if (!IsSparse()) {
+		return;
+	}
+	const uint32 numRegisters = 1 << Precision;
+	Memory::FillZero(Registers.AddUninitialized(numRegisters), numRegisters);
+	for (uint32 entry : Sparse) {
+		Registers[entry >> 8] = uint8(entry & 0xFF);
+	}
+	Sparse.Reset();
+}
\ No newline at end of file
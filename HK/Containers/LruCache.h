@@ -0,0 +1,322 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "HashMap.h"
+#include "Allocators/Pool.h"
+#include "Delegate.h"
+
+enum class ECachePolicy
+{
+	// Every hit moves the entry to the front, evicts the least
+	// recently used entry.
+	Lru,
+	// Every hit only marks the entry, eviction gives marked entries a
+	// second chance. Hits are cheaper, which pays off when most
+	// lookups hit.
+	Clock,
+};
+
+struct CacheStats {
+	uint64 NumHits;
+	uint64 NumMisses;
+	uint64 NumEvictions;
+};
+
+// A bounded cache that evicts entries once their total cost exceeds the
+// budget. Every entry costs 1 by default, which makes the budget an
+// entry count, or pass the size in bytes to Add for a byte budget.
+// Entries live in Pool allocated nodes on an intrusive recency list,
+// the HashMap only maps keys to nodes.
+template<class TKey, class TValue>
+class LruCache {
+public:
+	LruCache(uint64 budget, ECachePolicy policy = ECachePolicy::Lru);
+	~LruCache();
+	LruCache(const LruCache&) = delete;
+	LruCache& operator=(const LruCache&) = delete;
+	
+	// Returns nullptr on a miss. Counts as a use of the entry.
+	TValue* Find(const TKey& key);
+	// Doesn't count as a use of the entry or towards the stats
+	bool Contains(const TKey& key) const;
+	// Adds or replaces the entry, then evicts until the budget is met.
+	// The entry that was just added is never evicted, even if it is
+	// over budget on its own.
+	TValue& Add(const TKey& key, const TValue& value, uint64 cost = 1);
+	TValue& Add(const TKey& key, TValue&& value, uint64 cost = 1);
+	// Removes the entry without invoking OnEvict
+	bool Remove(const TKey& key);
+	// Removes every entry without invoking OnEvict
+	void Clear();
+	void SetBudget(uint64 budget);
+	
+	uint32 Num() const;
+	uint64 GetCost() const;
+	uint64 GetBudget() const;
+	const CacheStats& GetStats() const;
+	void ResetStats();
+	
+	// Invoked for every entry evicted to meet the budget. Callbacks can
+	// read the entry through GetEvictedKey and GetEvictedValue, and
+	// must not modify the cache.
+	Delegate OnEvict;
+	const TKey& GetEvictedKey() const;
+	TValue& GetEvictedValue() const;
+	
+private:
+	struct Node {
+		TKey Key;
+		TValue Value;
+		Node* Prev;
+		Node* Next;
+		uint64 Cost;
+		bool bReferenced;
+	};
+	
+	template<typename V>
+	TValue& AddImpl(const TKey& key, V&& value, uint64 cost);
+	void LinkFront(Node* node);
+	void Unlink(Node* node);
+	void EvictToBudget(const Node* keep);
+	void DestroyNode(Node* node);
+	
+	HashMap<TKey, Node*> Index;
+	Pool<Node> Nodes;
+	// Most recently used first
+	Node* Head;
+	Node* Tail;
+	Node* Evicted;
+	uint64 Cost;
+	uint64 Budget;
+	CacheStats Stats;
+	ECachePolicy Policy;
+};
+
+template<class TKey, class TValue>
+LruCache<TKey, TValue>::LruCache(uint64 budget, ECachePolicy policy)
+	: Head(nullptr)
+	, Tail(nullptr)
+	, Evicted(nullptr)
+	, Cost(0)
+	, Budget(budget)
+	, Policy(policy)
+{
+	ResetStats();
+}
+
+template<class TKey, class TValue>
+LruCache<TKey, TValue>::~LruCache()
+{
+	Clear();
+}
+
+template<class TKey, class TValue>
+TValue* LruCache<TKey, TValue>::Find(const TKey& key)
+{
+	Node** found = Index.Find(key);
+	if (found == nullptr) {
+		++Stats.NumMisses;
+		return nullptr;
+	}
+	++Stats.NumHits;
+	Node* node = *found;
+	if (Policy == ECachePolicy::Lru) {
+		if (node != Head) {
+			Unlink(node);
+			LinkFront(node);
+		}
+	} else {
+		node->bReferenced = true;
+	}
+	return &node->Value;
+}
+
+template<class TKey, class TValue>
+bool LruCache<TKey, TValue>::Contains(const TKey& key) const
+{
+	return Index.Find(key) != nullptr;
+}
+
+template<class TKey, class TValue>
+TValue& LruCache<TKey, TValue>::Add(const TKey& key, const TValue& value, uint64 cost)
+{
+	return AddImpl(key, value, cost);
+}
+
+template<class TKey, class TValue>
+TValue& LruCache<TKey, TValue>::Add(const TKey& key, TValue&& value, uint64 cost)
+{
+	return AddImpl(key, Move(value), cost);
+}
+
+template<class TKey, class TValue>
+bool LruCache<TKey, TValue>::Remove(const TKey& key)
+{
+	Node** found = Index.Find(key);
+	if (found == nullptr) {
+		return false;
+	}
+	Node* node = *found;
+	Index.Remove(key);
+	Cost -= node->Cost;
+	Unlink(node);
+	DestroyNode(node);
+	return true;
+}
+
+template<class TKey, class TValue>
+void LruCache<TKey, TValue>::Clear()
+{
+	Node* node = Head;
+	while (node != nullptr) {
+		Node* next = node->Next;
+		DestroyNode(node);
+		node = next;
+	}
+	Head = nullptr;
+	Tail = nullptr;
+	Cost = 0;
+	Index.Clear();
+}
+
+template<class TKey, class TValue>
+void LruCache<TKey, TValue>::SetBudget(uint64 budget)
+{
+	Budget = budget;
+	EvictToBudget(nullptr);
+}
+
+template<class TKey, class TValue>
+uint32 LruCache<TKey, TValue>::Num() const
+{
+	return Index.Num();
+}
+
+template<class TKey, class TValue>
+uint64 LruCache<TKey, TValue>::GetCost() const
+{
+	return Cost;
+}
+
+template<class TKey, class TValue>
+uint64 LruCache<TKey, TValue>::GetBudget() const
+{
+	return Budget;
+}
+
+template<class TKey, class TValue>
+const CacheStats& LruCache<TKey, TValue>::GetStats() const
+{
+	return Stats;
+}
+
+template<class TKey, class TValue>
+void LruCache<TKey, TValue>::ResetStats()
+{
+	Stats.NumHits = 0;
+	Stats.NumMisses = 0;
+	Stats.NumEvictions = 0;
+}
+
+template<class TKey, class TValue>
+const TKey& LruCache<TKey, TValue>::GetEvictedKey() const
+{
+	CHECK(Evicted != nullptr);
+	return Evicted->Key;
+}
+
+template<class TKey, class TValue>
+TValue& LruCache<TKey, TValue>::GetEvictedValue() const
+{
+	CHECK(Evicted != nullptr);
+	return Evicted->Value;
+}
+
+template<class TKey, class TValue>
+template<typename V>
+TValue& LruCache<TKey, TValue>::AddImpl(const TKey& key, V&& value, uint64 cost)
+{
+	bool bAdded = false;
+	Node*& slot = Index.FindOrAdd(key, &bAdded);
+	Node* node = slot;
+	if (bAdded) {
+		node = Nodes.Allocate();
+		Memory::PlacementNew<Node>(node);
+		node->Key = key;
+		slot = node;
+	} else {
+		Cost -= node->Cost;
+		Unlink(node);
+	}
+	node->Value = static_cast<V&&>(value);
+	node->Cost = cost;
+	node->bReferenced = false;
+	Cost += cost;
+	LinkFront(node);
+	
+	EvictToBudget(node);
+	return node->Value;
+}
+
+template<class TKey, class TValue>
+void LruCache<TKey, TValue>::LinkFront(Node* node)
+{
+	node->Prev = nullptr;
+	node->Next = Head;
+	if (Head != nullptr) {
+		Head->Prev = node;
+	} else {
+		Tail = node;
+	}
+	Head = node;
+}
+
+template<class TKey, class TValue>
+void LruCache<TKey, TValue>::Unlink(Node* node)
+{
+	if (node->Prev != nullptr) {
+		node->Prev->Next = node->Next;
+	} else {
+		Head = node->Next;
+	}
+	if (node->Next != nullptr) {
+		node->Next->Prev = node->Prev;
+	} else {
+		Tail = node->Prev;
+	}
+}
+
+template<class TKey, class TValue>
+void LruCache<TKey, TValue>::EvictToBudget(const Node* keep)
+{
+	while (Cost > Budget && Tail != nullptr) {
+		Node* node = Tail;
+		if (node == keep && node == Head) {
+			break;
+		}
+		Unlink(node);
+		if (node == keep || node->bReferenced) {
+			// Second chance, the mark is cleared as the hand passes
+			node->bReferenced = false;
+			LinkFront(node);
+			continue;
+		}
+		
+		Index.Remove(node->Key);
+		Cost -= node->Cost;
+		++Stats.NumEvictions;
+		Evicted = node;
+		OnEvict.Invoke();
+		Evicted = nullptr;
+		DestroyNode(node);
+	}
+}
+
+template<class TKey, class TValue>
+void LruCache<TKey, TValue>::DestroyNode(Node* node)
+{
+	node->~Node();
+	Nodes.Free(node);
+}
\ No newline at end of file
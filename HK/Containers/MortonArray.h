@@ -0,0 +1,278 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Array.h"
+#include "Common/Math.h"
+#include "Common/Morton.h"
+#include "Containers/View/ArrayView2D.h"
+#include "Containers/View/ArrayView3D.h"
+
+// A grid that stores its cells in Z-order instead of row by row, so a
+// cell's neighbours along every axis tend to share its cache lines and
+// pages. This pays off for lookups that don't sweep the grid in row
+// order, like queries around arbitrary points or passes along columns.
+// A pass that sweeps every row is faster on a row-major ArrayView2D,
+// whose inner loops vectorize and stream.
+// Cells are stored in square tiles whose size is the smallest power of
+// two that covers the shorter axis. Within a tile they are in Z-order,
+// and the tiles follow each other along the longer axis, so a grid
+// wastes at most the padding of the last tile and of the shorter axis
+// up to the tile size. A square power of two grid is a single tile.
+// Within a tile, neighbours of a cell can be reached from its index
+// without decoding, with Morton::Increment and Morton::Decrement on the
+// axis masks.
+template<typename T>
+class MortonArray2D {
+public:
+	MortonArray2D(uint32 width, uint32 height);
+
+	uint32 Width() const { return GridWidth; }
+	uint32 Height() const { return GridHeight; }
+	// The number of slots in storage, including padding
+	uint32 GetNumSlots() const { return Cells.Num(); }
+	uint32 GetTileSize() const { return 1 << TileBits; }
+	T* GetData() { return Cells.GetData(); }
+	const T* GetData() const { return Cells.GetData(); }
+
+	uint32 GetIndex(uint32 x, uint32 y) const;
+	T& operator()(uint32 x, uint32 y);
+	const T& operator()(uint32 x, uint32 y) const;
+
+	// Calls visit(uint32 x, uint32 y, T& cell) for every cell in storage
+	// order.
+	template<typename F>
+	void ForEach(F&& visit);
+	void CopyFrom(ArrayView2D<const T> source);
+	void CopyTo(ArrayView2D<T> destination) const;
+
+private:
+	Array<T> Cells;
+	uint32 GridWidth;
+	uint32 GridHeight;
+	uint32 TileBits;
+};
+
+// See MortonArray2D, the tiles are cubes that follow each other along x,
+// then y, then z. Coordinates are limited to 10 bits.
+template<typename T>
+class MortonArray3D {
+public:
+	MortonArray3D(uint32 width, uint32 height, uint32 depth);
+
+	uint32 Width() const { return GridWidth; }
+	uint32 Height() const { return GridHeight; }
+	uint32 Depth() const { return GridDepth; }
+	uint32 GetNumSlots() const { return Cells.Num(); }
+	uint32 GetTileSize() const { return 1 << TileBits; }
+	T* GetData() { return Cells.GetData(); }
+	const T* GetData() const { return Cells.GetData(); }
+
+	uint32 GetIndex(uint32 x, uint32 y, uint32 z) const;
+	T& operator()(uint32 x, uint32 y, uint32 z);
+	const T& operator()(uint32 x, uint32 y, uint32 z) const;
+
+	// Calls visit(uint32 x, uint32 y, uint32 z, T& cell) for every cell
+	// in storage order.
+	template<typename F>
+	void ForEach(F&& visit);
+	void CopyFrom(ArrayView3D<const T> source);
+	void CopyTo(ArrayView3D<T> destination) const;
+
+private:
+	Array<T> Cells;
+	uint32 GridWidth;
+	uint32 GridHeight;
+	uint32 GridDepth;
+	uint32 TileBits;
+	uint32 TilesX;
+	uint32 TilesY;
+};
+
+// The number of bits of a tile that covers size cells
+inline uint32 GetMortonTileBits(uint32 size)
+{
+	return size <= 1 ? 0 : 64 - Math::CountLeadingZeros(uint64(size - 1));
+}
+
+template<typename T>
+MortonArray2D<T>::MortonArray2D(uint32 width, uint32 height)
+	: GridWidth(width)
+	, GridHeight(height)
+	, TileBits(GetMortonTileBits(Math::Min(width, height)))
+{
+	CHECK(width < (1 << 16) && height < (1 << 16));
+	if (width > 0 && height > 0) {
+		const uint64 numTiles = ((uint64(Math::Max(width, height)) - 1) >> TileBits) + 1;
+		const uint64 num = numTiles << (2 * TileBits);
+		CHECK(num <= ~uint32(0));
+		Cells.Reserve(uint32(num));
+		for (uint32 i = 0; i < num; ++i) {
+			Cells.AddDefaulted();
+		}
+	}
+}
+
+template<typename T>
+uint32 MortonArray2D<T>::GetIndex(uint32 x, uint32 y) const
+{
+	// Only the longer axis reaches past the first tile
+	const uint32 mask = (1 << TileBits) - 1;
+	const uint32 tile = (x >> TileBits) + (y >> TileBits);
+	return (tile << (2 * TileBits)) | Morton::Encode2(x & mask, y & mask);
+}
+
+template<typename T>
+T& MortonArray2D<T>::operator()(uint32 x, uint32 y)
+{
+	CHECK(x < GridWidth && y < GridHeight);
+	return Cells.GetData()[GetIndex(x, y)];
+}
+
+template<typename T>
+const T& MortonArray2D<T>::operator()(uint32 x, uint32 y) const
+{
+	CHECK(x < GridWidth && y < GridHeight);
+	return Cells.GetData()[GetIndex(x, y)];
+}
+
+template<typename T>
+template<typename F>
+void MortonArray2D<T>::ForEach(F&& visit)
+{
+	T* cells = Cells.GetData();
+	const uint32 tileCells = 1 << (2 * TileBits);
+	const bool bTilesAlongX = GridWidth >= GridHeight;
+	for (uint32 i = 0; i < Cells.Num(); ++i) {
+		uint32 x, y;
+		Morton::Decode2(i & (tileCells - 1), x, y);
+		const uint32 tileStart = (i >> (2 * TileBits)) << TileBits;
+		x += bTilesAlongX ? tileStart : 0;
+		y += bTilesAlongX ? 0 : tileStart;
+		if (x < GridWidth && y < GridHeight) {
+			visit(x, y, cells[i]);
+		}
+	}
+}
+
+template<typename T>
+void MortonArray2D<T>::CopyFrom(ArrayView2D<const T> source)
+{
+	CHECK(source.Width() == GridWidth && source.Height() == GridHeight);
+	T* cells = Cells.GetData();
+	for (uint32 y = 0; y < GridHeight; ++y) {
+		const T* row = source.Row(y);
+		for (uint32 x = 0; x < GridWidth; ++x) {
+			cells[GetIndex(x, y)] = row[x];
+		}
+	}
+}
+
+template<typename T>
+void MortonArray2D<T>::CopyTo(ArrayView2D<T> destination) const
+{
+	CHECK(destination.Width() == GridWidth && destination.Height() == GridHeight);
+	const T* cells = Cells.GetData();
+	for (uint32 y = 0; y < GridHeight; ++y) {
+		T* row = destination.Row(y);
+		for (uint32 x = 0; x < GridWidth; ++x) {
+			row[x] = cells[GetIndex(x, y)];
+		}
+	}
+}
+
+template<typename T>
+MortonArray3D<T>::MortonArray3D(uint32 width, uint32 height, uint32 depth)
+	: GridWidth(width)
+	, GridHeight(height)
+	, GridDepth(depth)
+	, TileBits(GetMortonTileBits(Math::Min(width, Math::Min(height, depth))))
+	, TilesX(0)
+	, TilesY(0)
+{
+	CHECK(width <= (1 << 10) && height <= (1 << 10) && depth <= (1 << 10));
+	if (width > 0 && height > 0 && depth > 0) {
+		// Every axis rounds up to a multiple of a tile that is at most
+		// 2^10, so storage stays within 2^30 slots
+		TilesX = ((width - 1) >> TileBits) + 1;
+		TilesY = ((height - 1) >> TileBits) + 1;
+		const uint32 tilesZ = ((depth - 1) >> TileBits) + 1;
+		const uint32 num = (TilesX * TilesY * tilesZ) << (3 * TileBits);
+		Cells.Reserve(num);
+		for (uint32 i = 0; i < num; ++i) {
+			Cells.AddDefaulted();
+		}
+	}
+}
+
+template<typename T>
+uint32 MortonArray3D<T>::GetIndex(uint32 x, uint32 y, uint32 z) const
+{
+	const uint32 mask = (1 << TileBits) - 1;
+	const uint32 tile = ((z >> TileBits) * TilesY + (y >> TileBits)) * TilesX + (x >> TileBits);
+	return (tile << (3 * TileBits)) | Morton::Encode3(x & mask, y & mask, z & mask);
+}
+
+template<typename T>
+T& MortonArray3D<T>::operator()(uint32 x, uint32 y, uint32 z)
+{
+	CHECK(x < GridWidth && y < GridHeight && z < GridDepth);
+	return Cells.GetData()[GetIndex(x, y, z)];
+}
+
+template<typename T>
+const T& MortonArray3D<T>::operator()(uint32 x, uint32 y, uint32 z) const
+{
+	CHECK(x < GridWidth && y < GridHeight && z < GridDepth);
+	return Cells.GetData()[GetIndex(x, y, z)];
+}
+
+template<typename T>
+template<typename F>
+void MortonArray3D<T>::ForEach(F&& visit)
+{
+	T* cells = Cells.GetData();
+	const uint32 tileCells = 1 << (3 * TileBits);
+	for (uint32 i = 0; i < Cells.Num(); ++i) {
+		uint32 x, y, z;
+		Morton::Decode3(i & (tileCells - 1), x, y, z);
+		const uint32 tile = i >> (3 * TileBits);
+		x += (tile % TilesX) << TileBits;
+		y += (tile / TilesX % TilesY) << TileBits;
+		z += (tile / TilesX / TilesY) << TileBits;
+		if (x < GridWidth && y < GridHeight && z < GridDepth) {
+			visit(x, y, z, cells[i]);
+		}
+	}
+}
+
+template<typename T>
+void MortonArray3D<T>::CopyFrom(ArrayView3D<const T> source)
+{
+	CHECK(source.Width() == GridWidth && source.Height() == GridHeight && source.Depth() == GridDepth);
+	T* cells = Cells.GetData();
+	for (uint32 z = 0; z < GridDepth; ++z) {
+		for (uint32 y = 0; y < GridHeight; ++y) {
+			const T* row = source.Row(y, z);
+			for (uint32 x = 0; x < GridWidth; ++x) {
+				cells[GetIndex(x, y, z)] = row[x];
+			}
+		}
+	}
+}
+
+template<typename T>
+void MortonArray3D<T>::CopyTo(ArrayView3D<T> destination) const
+{
+	CHECK(destination.Width() == GridWidth && destination.Height() == GridHeight && destination.Depth() == GridDepth);
+	const T* cells = Cells.GetData();
+	for (uint32 z = 0; z < GridDepth; ++z) {
+		for (uint32 y = 0; y < GridHeight; ++y) {
+			T* row = destination.Row(y, z);
+			for (uint32 x = 0; x < GridWidth; ++x) {
+				row[x] = cells[GetIndex(x, y, z)];
+			}
+		}
+	}
+}
\ No newline at end of file
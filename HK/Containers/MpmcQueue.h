@@ -0,0 +1,198 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Allocators/Memory.h"
+#include "Common/Math.h"
+#include "Containers/View/ArrayView.h"
+#include "Util/Atomic.h"
+
+// A bounded lock-free queue for any number of producer and consumer
+// threads. Every slot of the power of two ring has a sequence number
+// that says whose turn it is: a slot at position pos is free for the
+// producer claiming pos when its sequence is pos, and filled for the
+// consumer claiming pos when it is pos + 1. Producers and consumers
+// only contend on their own counter, and never on the same slot.
+template<typename T>
+class MpmcQueue {
+public:
+	// The capacity is rounded up to a power of two
+	MpmcQueue(uint32 capacity);
+	MpmcQueue(const MpmcQueue&) = delete;
+	MpmcQueue& operator=(const MpmcQueue&) = delete;
+	~MpmcQueue();
+	
+	// Returns false if the queue is full
+	bool Push(const T& item);
+	bool Push(T&& item);
+	// Claims a run of free slots with a single compare exchange, pushes
+	// as many items as fit and returns how many
+	uint32 PushN(const ArrayView<T>& items);
+	
+	// Returns false if the queue is empty
+	bool Pop(T& outItem);
+	// Pops up to maxItems in order and returns how many
+	uint32 PopN(T* outItems, uint32 maxItems);
+	
+	// Only a snapshot while other threads push or pop
+	uint32 Num() const;
+	uint32 GetCapacity() const { return Mask + 1; }
+	
+protected:
+	struct Slot {
+		Atomic<uint32> Sequence;
+		alignas(T) uint8 Storage[sizeof(T)];
+		
+		T* GetItem() { return reinterpret_cast<T*>(Storage); }
+	};
+	
+	// Claims up to maxItems consecutive slots whose sequence is offset
+	// ahead of the position, and returns the first position of the run
+	uint32 Claim(Atomic<uint32>& position, uint32 offset, uint32 maxItems, uint32& outNum);
+	
+	alignas(CACHE_LINE_SIZE) Atomic<uint32> EnqueuePosition;
+	alignas(CACHE_LINE_SIZE) Atomic<uint32> DequeuePosition;
+	alignas(CACHE_LINE_SIZE) Slot* Slots;
+	uint32 Mask;
+};
+
+template<typename T>
+MpmcQueue<T>::MpmcQueue(uint32 capacity)
+	: EnqueuePosition(0)
+	, DequeuePosition(0)
+{
+	CHECK(capacity > 0 && capacity <= (1u << 31));
+	capacity = Math::NextPowerOfTwo(capacity);
+	Slots = Memory::Allocate<Slot>(capacity);
+	Mask = capacity - 1;
+	for (uint32 i = 0; i < capacity; ++i) {
+		Memory::PlacementNew<Atomic<uint32>>(&Slots[i].Sequence, i);
+	}
+}
+
+template<typename T>
+MpmcQueue<T>::~MpmcQueue()
+{
+	const uint32 end = EnqueuePosition.Load(EMemoryOrder::Relaxed);
+	for (uint32 i = DequeuePosition.Load(EMemoryOrder::Relaxed); i != end; ++i) {
+		Slots[i & Mask].GetItem()->~T();
+	}
+	Memory::Free(Slots, sizeof(Slot) * uint64(Mask + 1));
+}
+
+template<typename T>
+bool MpmcQueue<T>::Push(const T& item)
+{
+	uint32 num;
+	const uint32 position = Claim(EnqueuePosition, 0, 1, num);
+	if (num == 0) {
+		return false;
+	}
+	Slot& slot = Slots[position & Mask];
+	Memory::PlacementNew<T>(slot.GetItem(), item);
+	slot.Sequence.Store(position + 1, EMemoryOrder::Release);
+	return true;
+}
+
+template<typename T>
+bool MpmcQueue<T>::Push(T&& item)
+{
+	uint32 num;
+	const uint32 position = Claim(EnqueuePosition, 0, 1, num);
+	if (num == 0) {
+		return false;
+	}
+	Slot& slot = Slots[position & Mask];
+	Memory::PlacementNew<T>(slot.GetItem(), Move(item));
+	slot.Sequence.Store(position + 1, EMemoryOrder::Release);
+	return true;
+}
+
+template<typename T>
+uint32 MpmcQueue<T>::PushN(const ArrayView<T>& items)
+{
+	uint32 num;
+	const uint32 position = Claim(EnqueuePosition, 0, items.Size(), num);
+	const T* source = items.ConstData();
+	for (uint32 i = 0; i < num; ++i) {
+		Slot& slot = Slots[(position + i) & Mask];
+		Memory::PlacementNew<T>(slot.GetItem(), source[i]);
+		slot.Sequence.Store(position + i + 1, EMemoryOrder::Release);
+	}
+	return num;
+}
+
+template<typename T>
+bool MpmcQueue<T>::Pop(T& outItem)
+{
+	uint32 num;
+	const uint32 position = Claim(DequeuePosition, 1, 1, num);
+	if (num == 0) {
+		return false;
+	}
+	Slot& slot = Slots[position & Mask];
+	outItem = Move(*slot.GetItem());
+	slot.GetItem()->~T();
+	// Free the slot for the producer that comes around the ring next
+	slot.Sequence.Store(position + Mask + 1, EMemoryOrder::Release);
+	return true;
+}
+
+template<typename T>
+uint32 MpmcQueue<T>::PopN(T* outItems, uint32 maxItems)
+{
+	uint32 num;
+	const uint32 position = Claim(DequeuePosition, 1, maxItems, num);
+	for (uint32 i = 0; i < num; ++i) {
+		Slot& slot = Slots[(position + i) & Mask];
+		outItems[i] = Move(*slot.GetItem());
+		slot.GetItem()->~T();
+		slot.Sequence.Store(position + i + Mask + 1, EMemoryOrder::Release);
+	}
+	return num;
+}
+
+template<typename T>
+uint32 MpmcQueue<T>::Num() const
+{
+	const uint32 dequeue = DequeuePosition.Load(EMemoryOrder::Acquire);
+	const uint32 enqueue = EnqueuePosition.Load(EMemoryOrder::Acquire);
+	return int32(enqueue - dequeue) > 0 ? enqueue - dequeue : 0;
+}
+
+template<typename T>
+uint32 MpmcQueue<T>::Claim(Atomic<uint32>& position, uint32 offset, uint32 maxItems, uint32& outNum)
+{
+	uint32 start = position.Load(EMemoryOrder::Relaxed);
+	while (true) {
+		// Count the slots from start that are ready, only the first one
+		// tells whether another thread got ahead of us
+		uint32 num = 0;
+		while (num < maxItems && num <= Mask) {
+			const uint32 sequence = Slots[(start + num) & Mask].Sequence.Load(EMemoryOrder::Acquire);
+			const int32 diff = int32(sequence - (start + num + offset));
+			if (diff != 0) {
+				if (num == 0 && diff > 0) {
+					// Another thread claimed start already
+					num = INVALID_INDEX;
+				}
+				break;
+			}
+			++num;
+		}
+		if (num == INVALID_INDEX) {
+			start = position.Load(EMemoryOrder::Relaxed);
+			continue;
+		}
+		if (num == 0) {
+			outNum = 0;
+			return start;
+		}
+		// On failure start is reloaded with the current position
+		if (position.CompareExchange(start, start + num, EMemoryOrder::Relaxed)) {
+			outNum = num;
+			return start;
+		}
+	}
+}
\ No newline at end of file
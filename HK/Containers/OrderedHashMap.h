@@ -0,0 +1,374 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "HashMap.h"
+
+// A hash map that stores its entries densely in insertion order, with a
+// separate open addressing table of uint32 indices into the entries.
+// Iterating touches only live entries and never copies them, at the
+// cost of one extra indirection per lookup.
+// Removal moves the last entry into the hole and patches its index, so
+// it is O(1) but does not preserve the order of that last entry.
+template<class TKey, class TValue>
+class OrderedHashMap {
+public:
+	typedef Hasher HasherType;
+	typedef HashMapEntry<TKey, TValue> EntryType;
+
+	OrderedHashMap();
+	OrderedHashMap(uint32 initialSize);
+	OrderedHashMap(const OrderedHashMap& copy);
+	OrderedHashMap(OrderedHashMap&& move);
+	~OrderedHashMap();
+
+	OrderedHashMap& operator=(const OrderedHashMap& other);
+	OrderedHashMap& operator=(OrderedHashMap&& other);
+
+	TValue& Add(const TKey& key);
+	TValue& FindOrAdd(const TKey& key);
+	TValue* Find(const TKey& key);
+	const TValue* Find(const TKey& key) const;
+	TValue& FindChecked(const TKey& key);
+	const TValue& FindChecked(const TKey& key) const;
+
+	// See HashMap::FindAs.
+	template<typename K>
+	TValue* FindAs(const K& key);
+	template<typename K>
+	const TValue* FindAs(const K& key) const;
+
+	void Remove(const TKey& key);
+	template<typename K>
+	void RemoveAs(const K& key);
+	void Reserve(uint32 num);
+	void Clear();
+
+	uint32 Num() const;
+	ArrayView<EntryType> View() const;
+
+	EntryType* begin() { return Entries.begin(); }
+	EntryType* end() { return Entries.end(); }
+	const EntryType* begin() const { return Entries.begin(); }
+	const EntryType* end() const { return Entries.end(); }
+
+protected:
+	template<typename K>
+	int32 FindEntryIndex(const K& key, uint32 hash) const;
+	// Returns the slot in the index table that points at entryIndex.
+	uint32 FindSlot(uint32 entryIndex) const;
+	void RemoveAtEntryIndex(uint32 entryIndex);
+
+private:
+	void Rehash(uint32 newCapacity);
+	void FreeIndices();
+
+protected:
+	Array<EntryType> Entries;
+	// The hash of every entry, parallel to Entries
+	Array<uint32> Hashes;
+	// Open addressing table of indices into Entries,
+	// INVALID_INDEX marks an empty slot.
+	uint32* Indices;
+	uint32 Capacity;
+};
+
+template<class TKey, class TValue>
+OrderedHashMap<TKey, TValue>::OrderedHashMap()
+{
+	Indices = nullptr;
+	Capacity = 0;
+}
+
+template<class TKey, class TValue>
+OrderedHashMap<TKey, TValue>::OrderedHashMap(uint32 initialSize)
+{
+	Indices = nullptr;
+	Capacity = 0;
+	if (initialSize > 0) {
+		Reserve(initialSize);
+	}
+}
+
+template<class TKey, class TValue>
+OrderedHashMap<TKey, TValue>::OrderedHashMap(const OrderedHashMap& copy)
+	: Entries(copy.Entries)
+	, Hashes(copy.Hashes)
+{
+	Indices = nullptr;
+	Capacity = 0;
+	if (copy.Indices != nullptr) {
+		Capacity = copy.Capacity;
+		Indices = Memory::Allocate<uint32>(Capacity);
+		Memory::Copy(copy.Indices, Indices, sizeof(uint32) * Capacity);
+	}
+}
+
+template<class TKey, class TValue>
+OrderedHashMap<TKey, TValue>::OrderedHashMap(OrderedHashMap&& move)
+	: Entries(Move(move.Entries))
+	, Hashes(Move(move.Hashes))
+{
+	Indices = move.Indices;
+	Capacity = move.Capacity;
+	move.Indices = nullptr;
+	move.Capacity = 0;
+}
+
+template<class TKey, class TValue>
+OrderedHashMap<TKey, TValue>::~OrderedHashMap()
+{
+	FreeIndices();
+}
+
+template<class TKey, class TValue>
+OrderedHashMap<TKey, TValue>& OrderedHashMap<TKey, TValue>::operator=(const OrderedHashMap& other)
+{
+	CHECK(this != &other);
+	Clear();
+	Entries = other.Entries;
+	Hashes = other.Hashes;
+	if (other.Indices != nullptr) {
+		Capacity = other.Capacity;
+		Indices = Memory::Allocate<uint32>(Capacity);
+		Memory::Copy(other.Indices, Indices, sizeof(uint32) * Capacity);
+	}
+	return *this;
+}
+
+template<class TKey, class TValue>
+OrderedHashMap<TKey, TValue>& OrderedHashMap<TKey, TValue>::operator=(OrderedHashMap&& other)
+{
+	CHECK(this != &other);
+	Clear();
+	Entries = Move(other.Entries);
+	Hashes = Move(other.Hashes);
+	Indices = other.Indices;
+	Capacity = other.Capacity;
+	other.Indices = nullptr;
+	other.Capacity = 0;
+	return *this;
+}
+
+template<class TKey, class TValue>
+TValue& OrderedHashMap<TKey, TValue>::Add(const TKey& key)
+{
+	return FindOrAdd(key);
+}
+
+template<class TKey, class TValue>
+TValue& OrderedHashMap<TKey, TValue>::FindOrAdd(const TKey& key)
+{
+	if (UNLIKELY(Entries.Num() >= SetMaxLoadFactor * Capacity)) {
+		Rehash(Capacity * 2);
+	}
+	const uint32 hash = HasherType::Hash<uint32>(key);
+	const uint32 mask = Capacity - 1;
+	uint32 slot = hash & mask;
+	while (Indices[slot] != INVALID_INDEX) {
+		const uint32 entryIndex = Indices[slot];
+		if (Hashes[entryIndex] == hash && Entries[entryIndex].Key == key) {
+			return Entries[entryIndex].Value;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	Indices[slot] = Entries.Num();
+	Hashes.Add(hash);
+	return Entries.AddRef(EntryType(key)).Value;
+}
+
+template<class TKey, class TValue>
+TValue* OrderedHashMap<TKey, TValue>::Find(const TKey& key)
+{
+	return FindAs(key);
+}
+
+template<class TKey, class TValue>
+const TValue* OrderedHashMap<TKey, TValue>::Find(const TKey& key) const
+{
+	return FindAs(key);
+}
+
+template<class TKey, class TValue>
+TValue& OrderedHashMap<TKey, TValue>::FindChecked(const TKey& key)
+{
+	TValue* value = FindAs(key);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<class TKey, class TValue>
+const TValue& OrderedHashMap<TKey, TValue>::FindChecked(const TKey& key) const
+{
+	const TValue* value = FindAs(key);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<class TKey, class TValue>
+template<typename K>
+TValue* OrderedHashMap<TKey, TValue>::FindAs(const K& key)
+{
+	const int32 entryIndex = FindEntryIndex(key, HasherType::Hash<uint32>(key));
+	if (entryIndex != -1) {
+		return &Entries[entryIndex].Value;
+	}
+	return nullptr;
+}
+
+template<class TKey, class TValue>
+template<typename K>
+const TValue* OrderedHashMap<TKey, TValue>::FindAs(const K& key) const
+{
+	const int32 entryIndex = FindEntryIndex(key, HasherType::Hash<uint32>(key));
+	if (entryIndex != -1) {
+		return &Entries[entryIndex].Value;
+	}
+	return nullptr;
+}
+
+template<class TKey, class TValue>
+void OrderedHashMap<TKey, TValue>::Remove(const TKey& key)
+{
+	RemoveAs(key);
+}
+
+template<class TKey, class TValue>
+template<typename K>
+void OrderedHashMap<TKey, TValue>::RemoveAs(const K& key)
+{
+	const int32 entryIndex = FindEntryIndex(key, HasherType::Hash<uint32>(key));
+	if (entryIndex != -1) {
+		RemoveAtEntryIndex(entryIndex);
+	}
+}
+
+template<class TKey, class TValue>
+void OrderedHashMap<TKey, TValue>::Reserve(uint32 num)
+{
+	const uint32 required = uint32((Entries.Num() + num) / SetMaxLoadFactor) + 1;
+	if (required > Capacity) {
+		Rehash(required);
+	}
+	Entries.Reserve(num);
+	Hashes.Reserve(num);
+}
+
+template<class TKey, class TValue>
+void OrderedHashMap<TKey, TValue>::Clear()
+{
+	Entries.Reset();
+	Hashes.Reset();
+	FreeIndices();
+}
+
+template<class TKey, class TValue>
+uint32 OrderedHashMap<TKey, TValue>::Num() const
+{
+	return Entries.Num();
+}
+
+template<class TKey, class TValue>
+ArrayView<HashMapEntry<TKey, TValue>> OrderedHashMap<TKey, TValue>::View() const
+{
+	return Entries.View();
+}
+
+template<class TKey, class TValue>
+template<typename K>
+int32 OrderedHashMap<TKey, TValue>::FindEntryIndex(const K& key, uint32 hash) const
+{
+	if (UNLIKELY(Indices == nullptr)) {
+		return -1;
+	}
+	const uint32 mask = Capacity - 1;
+	uint32 slot = hash & mask;
+	while (Indices[slot] != INVALID_INDEX) {
+		const uint32 entryIndex = Indices[slot];
+		if (Hashes[entryIndex] == hash && Entries[entryIndex].Key == key) {
+			return entryIndex;
+		}
+		slot = (slot + 1) & mask;
+	}
+	return -1;
+}
+
+template<class TKey, class TValue>
+uint32 OrderedHashMap<TKey, TValue>::FindSlot(uint32 entryIndex) const
+{
+	const uint32 mask = Capacity - 1;
+	uint32 slot = Hashes[entryIndex] & mask;
+	while (Indices[slot] != entryIndex) {
+		CHECK(Indices[slot] != INVALID_INDEX);
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+template<class TKey, class TValue>
+void OrderedHashMap<TKey, TValue>::RemoveAtEntryIndex(uint32 entryIndex)
+{
+	const uint32 mask = Capacity - 1;
+
+	// Backward shift deletion, pull every following index of the
+	// cluster that may live in the hole into it.
+	uint32 hole = FindSlot(entryIndex);
+	uint32 slot = (hole + 1) & mask;
+	while (Indices[slot] != INVALID_INDEX) {
+		const uint32 home = Hashes[Indices[slot]] & mask;
+		if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+			Indices[hole] = Indices[slot];
+			hole = slot;
+		}
+		slot = (slot + 1) & mask;
+	}
+	Indices[hole] = INVALID_INDEX;
+
+	// Swap the last entry into the gap and patch the index pointing at it
+	const uint32 lastIndex = Entries.Num() - 1;
+	if (entryIndex != lastIndex) {
+		Indices[FindSlot(lastIndex)] = entryIndex;
+		Entries[entryIndex] = Move(Entries[lastIndex]);
+		Hashes[entryIndex] = Hashes[lastIndex];
+	}
+	Entries.RemoveAt(lastIndex);
+	Hashes.RemoveAt(lastIndex);
+}
+
+template<class TKey, class TValue>
+void OrderedHashMap<TKey, TValue>::Rehash(uint32 newCapacity)
+{
+	if (UNLIKELY(newCapacity < 8)) {
+		newCapacity = 8;
+	}
+	newCapacity = Math::NextPowerOfTwo(newCapacity);
+	if (UNLIKELY(newCapacity == Capacity)) {
+		return;
+	}
+
+	FreeIndices();
+	Capacity = newCapacity;
+	Indices = Memory::Allocate<uint32>(Capacity);
+	Memory::FillByte(Indices, sizeof(uint32) * Capacity, 0xFF);
+
+	const uint32 mask = Capacity - 1;
+	for (uint32 i = 0; i < Hashes.Num(); ++i) {
+		uint32 slot = Hashes[i] & mask;
+		while (Indices[slot] != INVALID_INDEX) {
+			slot = (slot + 1) & mask;
+		}
+		Indices[slot] = i;
+	}
+}
+
+template<class TKey, class TValue>
+void OrderedHashMap<TKey, TValue>::FreeIndices()
+{
+	if (Indices != nullptr) {
+		Memory::Free(Indices, sizeof(uint32) * Capacity);
+	}
+	Indices = nullptr;
+	Capacity = 0;
+}
\ No newline at end of file
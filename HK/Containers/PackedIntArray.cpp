@@ -0,0 +1,146 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/PackedIntArray.h"
+
+#define PACKED_INT_WIDTHS(X) \
+	X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) \
+	X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16) \
+	X(17) X(18) X(19) X(20) X(21) X(22) X(23) X(24) \
+	X(25) X(26) X(27) X(28) X(29) X(30) X(31) X(32)
+
+void PackedInt::Unpack(const uint64* words, uint32 first, uint32 count, uint32 bits, uint32* outValues)
+{
+	switch (bits) {
+#define PACKED_INT_UNPACK(N) case N: Unpack<N>(words, first, count, outValues); break;
+	PACKED_INT_WIDTHS(PACKED_INT_UNPACK)
+#undef PACKED_INT_UNPACK
+	default: CHECK(false);
+	}
+}
+
+void PackedInt::Pack(uint64* words, uint32 first, uint32 count, uint32 bits, const uint32* values)
+{
+	switch (bits) {
+#define PACKED_INT_PACK(N) case N: Pack<N>(words, first, count, values); break;
+	PACKED_INT_WIDTHS(PACKED_INT_PACK)
+#undef PACKED_INT_PACK
+	default: CHECK(false);
+	}
+}
+
+GPackedIntArray::GPackedIntArray()
+	: ValueNum(0)
+{
+}
+
+GPackedIntArray::GPackedIntArray(const GPackedIntArray& other)
+	: Array<uint64>(other)
+	, ValueNum(other.ValueNum)
+{
+}
+
+GPackedIntArray::GPackedIntArray(GPackedIntArray&& other)
+	: Array<uint64>(Move(other))
+	, ValueNum(other.ValueNum)
+{
+	other.ValueNum = 0;
+}
+
+GPackedIntArray& GPackedIntArray::operator=(const GPackedIntArray& other)
+{
+	Array<uint64>::operator=(other);
+	ValueNum = other.ValueNum;
+	return *this;
+}
+
+GPackedIntArray& GPackedIntArray::operator=(GPackedIntArray&& other)
+{
+	Array<uint64>::operator=(Move(other));
+	ValueNum = other.ValueNum;
+	other.ValueNum = 0;
+	return *this;
+}
+
+void GPackedIntArray::Reset()
+{
+	Array<uint64>::Reset();
+	ValueNum = 0;
+}
+
+void GPackedIntArray::ReserveValues(uint32 num, uint32 bits)
+{
+	RequireArrayMax(PackedInt::GetWordCount(ValueNum + num, bits));
+}
+
+void GPackedIntArray::SetValueNum(uint32 num, uint32 bits)
+{
+	if (num >= ValueNum) {
+		AddValues(num - ValueNum, bits);
+		return;
+	}
+	
+	// Drop the words past the new end and clear the bits of the dropped
+	// values, growing again relies on them being zero
+	ArrayNum = PackedInt::GetWordCount(num, bits);
+	const uint64 bit = uint64(num) * bits;
+	Data[bit / 64] &= bit % 64 != 0 ? (uint64(1) << (bit % 64)) - 1 : 0;
+	Data[ArrayNum - 1] = 0;
+	ValueNum = num;
+}
+
+DynamicPackedIntArray::DynamicPackedIntArray()
+	: BitWidth(PackedInt::MaxBits)
+{
+}
+
+DynamicPackedIntArray::DynamicPackedIntArray(uint32 bitWidth, uint32 buffer)
+	: BitWidth(bitWidth)
+{
+	CHECK(bitWidth > 0 && bitWidth <= PackedInt::MaxBits);
+	if (buffer > 0) {
+		ReserveValues(buffer, BitWidth);
+	}
+}
+
+void DynamicPackedIntArray::SetBitWidth(uint32 bitWidth)
+{
+	CHECK(ValueNum == 0 && bitWidth > 0 && bitWidth <= PackedInt::MaxBits);
+	BitWidth = bitWidth;
+}
+
+void DynamicPackedIntArray::Add(uint32 value)
+{
+	CHECK(value <= GetMaxValue());
+	PackedInt::Set(Data, AddValues(1, BitWidth), BitWidth, value);
+}
+
+void DynamicPackedIntArray::AddRange(const ArrayView<uint32>& values)
+{
+	const uint32 first = AddValues(values.Size(), BitWidth);
+	Pack(first, values);
+}
+
+void DynamicPackedIntArray::Set(uint32 index, uint32 value)
+{
+	CHECK(IsValidIndex(index) && value <= GetMaxValue());
+	PackedInt::Set(Data, index, BitWidth, value);
+}
+
+void DynamicPackedIntArray::Unpack(uint32 first, uint32 count, Array<uint32>& outValues) const
+{
+	CHECK(uint64(first) + count <= ValueNum);
+	outValues.Reset();
+	PackedInt::Unpack(Data, first, count, BitWidth, outValues.AddUninitialized(count));
+}
+
+void DynamicPackedIntArray::Pack(uint32 first, const ArrayView<uint32>& values)
+{
+	CHECK(uint64(first) + values.Size() <= ValueNum);
+	uint32 combined = 0;
+	for (uint32 i = 0; i < values.Size(); ++i) {
+		combined |= values.ConstData()[i];
+	}
+	CHECK(combined <= GetMaxValue());
+	PackedInt::Pack(Data, first, values.Size(), BitWidth, values.ConstData());
+}
\ No newline at end of file
@@ -0,0 +1,337 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Containers/Array.h"
+
+// AVX2 is only used when the build targets it, other builds use the
+// width specialized scalar kernels
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PACKED_INT_AVX2 1
+#else
+#define PACKED_INT_AVX2 0
+#endif
+
+// Reads and writes of integers of 1 to 32 bits packed back to back into
+// uint64 words. The words always end in a padding word, so a value that
+// straddles two words is read with two loads and no branch.
+namespace PackedInt
+{
+	constexpr uint32 MaxBits = 32;
+	
+	// The words holding num values, including the padding word
+	constexpr uint32 GetWordCount(uint32 num, uint32 bits)
+	{
+		return uint32((uint64(num) * bits + 63) / 64) + 1;
+	}
+	
+	// Returns the smallest width that holds maxValue
+	constexpr uint32 GetBitsFor(uint32 maxValue)
+	{
+		uint32 bits = 1;
+		while (bits < MaxBits && (maxValue >> bits) != 0) {
+			++bits;
+		}
+		return bits;
+	}
+	
+	inline uint32 Get(const uint64* words, uint32 index, uint32 bits)
+	{
+		const uint64 bit = uint64(index) * bits;
+		const uint64* word = words + bit / 64;
+		const uint32 offset = bit % 64;
+		// The double shift moves the next word out entirely when offset is 0
+		const uint64 value = (word[0] >> offset) | ((word[1] << 1) << (63 - offset));
+		return uint32(value & ((uint64(1) << bits) - 1));
+	}
+	
+	inline void Set(uint64* words, uint32 index, uint32 bits, uint32 value)
+	{
+		const uint64 bit = uint64(index) * bits;
+		uint64* word = words + bit / 64;
+		const uint32 offset = bit % 64;
+		const uint64 mask = (uint64(1) << bits) - 1;
+		word[0] = (word[0] & ~(mask << offset)) | (uint64(value) << offset);
+		word[1] = (word[1] & ~((mask >> 1) >> (63 - offset))) | ((uint64(value) >> 1) >> (63 - offset));
+	}
+	
+	// Unpack and Pack move values in blocks of 8, which take exactly bits
+	// bytes and so always start on a byte. Within a block every shift is
+	// a constant of the width, the values around the blocks are moved one
+	// at a time. Bytes are read and written in little endian order.
+	
+	// Decodes the 8 values of the block at bytes. Every value is read with
+	// one unaligned load at its first byte, which holds at least 57 of its
+	// bits, so no value needs a second load.
+	template<uint32 Bits>
+	inline void UnpackBlock(const uint8* bytes, uint32* outValues)
+	{
+		constexpr uint64 mask = (uint64(1) << Bits) - 1;
+		for (uint32 i = 0; i < 8; ++i) {
+			const uint64 word = *reinterpret_cast<const uint64*>(bytes + i * Bits / 8);
+			outValues[i] = uint32((word >> (i * Bits % 8)) & mask);
+		}
+	}
+	
+	// Encodes 8 values into the block at bytes. The values are combined at
+	// constant shifts in registers and stored a word at a time.
+	template<uint32 Bits>
+	inline void PackBlock(uint8* bytes, const uint32* values)
+	{
+		uint64 block[4] = {};
+		for (uint32 i = 0; i < 8; ++i) {
+			const uint32 bit = i * Bits;
+			block[bit / 64] |= uint64(values[i]) << (bit % 64);
+			if (bit % 64 + Bits > 64) {
+				block[bit / 64 + 1] |= uint64(values[i]) >> (64 - bit % 64);
+			}
+		}
+		for (uint32 w = 0; w < Bits / 8; ++w) {
+			*reinterpret_cast<uint64*>(bytes + w * 8) = block[w];
+		}
+		for (uint32 b = Bits / 8 * 8; b < Bits; ++b) {
+			bytes[b] = uint8(block[b / 8] >> (b % 8 * 8));
+		}
+	}
+	
+#if PACKED_INT_AVX2
+	// Decodes blocks of up to 25 bit values with one shuffle, shift and
+	// mask. Each 128 bit lane loads the bytes of 4 values and shuffles the
+	// 4 bytes from the first byte of every value into its element.
+	struct UnpackerAvx2
+	{
+		__m256i Shuffle;
+		__m256i Shifts;
+		__m256i Mask;
+		// The first byte of the upper lane's values
+		uint32 HighOffset;
+		
+		explicit UnpackerAvx2(uint32 bits)
+		{
+			alignas(32) uint8 shuffle[32];
+			alignas(32) uint32 shifts[8];
+			HighOffset = 4 * bits / 8;
+			for (uint32 i = 0; i < 8; ++i) {
+				const uint32 bit = i * bits - (i < 4 ? 0 : 8 * HighOffset);
+				for (uint32 b = 0; b < 4; ++b) {
+					shuffle[i * 4 + b] = uint8(bit / 8 + b);
+				}
+				shifts[i] = bit % 8;
+			}
+			Shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle));
+			Shifts = _mm256_load_si256(reinterpret_cast<const __m256i*>(shifts));
+			Mask = _mm256_set1_epi32(int32((uint32(1) << bits) - 1));
+		}
+		
+		// Reads HighOffset + 16 bytes
+		void Unpack(const uint8* bytes, uint32* outValues) const
+		{
+			const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+			const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + HighOffset));
+			const __m256i data = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+			const __m256i values = _mm256_and_si256(_mm256_srlv_epi32(_mm256_shuffle_epi8(data, Shuffle), Shifts), Mask);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(outValues), values);
+		}
+	};
+#endif
+	
+	// Decodes count values starting at first
+	template<uint32 Bits>
+	void Unpack(const uint64* words, uint32 first, uint32 count, uint32* outValues)
+	{
+		uint32 i = 0;
+		for (; i < count && (first + i) % 8 != 0; ++i) {
+			outValues[i] = Get(words, first + i, Bits);
+		}
+		const uint8* bytes = reinterpret_cast<const uint8*>(words) + uint64(first + i) / 8 * Bits;
+#if PACKED_INT_AVX2
+		if constexpr (Bits <= 25) {
+			// Stops while the loads past the block stay within the values
+			// and the padding word
+			const UnpackerAvx2 unpacker(Bits);
+			for (; i + 8 <= count && uint64(count - i) * Bits >= 4 * Bits + 64; i += 8, bytes += Bits) {
+				unpacker.Unpack(bytes, outValues + i);
+			}
+		}
+#endif
+		for (; i + 8 <= count; i += 8, bytes += Bits) {
+			UnpackBlock<Bits>(bytes, outValues + i);
+		}
+		for (; i < count; ++i) {
+			outValues[i] = Get(words, first + i, Bits);
+		}
+	}
+	
+	// Encodes count values starting at first, which must all fit in Bits
+	template<uint32 Bits>
+	void Pack(uint64* words, uint32 first, uint32 count, const uint32* values)
+	{
+		uint32 i = 0;
+		for (; i < count && (first + i) % 8 != 0; ++i) {
+			Set(words, first + i, Bits, values[i]);
+		}
+		uint8* bytes = reinterpret_cast<uint8*>(words) + uint64(first + i) / 8 * Bits;
+		for (; i + 8 <= count; i += 8, bytes += Bits) {
+			PackBlock<Bits>(bytes, values + i);
+		}
+		for (; i < count; ++i) {
+			Set(words, first + i, Bits, values[i]);
+		}
+	}
+	
+	// Unpack and Pack for a width chosen at runtime, which dispatch to the
+	// kernels of that width
+	void Unpack(const uint64* words, uint32 first, uint32 count, uint32 bits, uint32* outValues);
+	void Pack(uint64* words, uint32 first, uint32 count, uint32 bits, const uint32* values);
+}
+
+// The storage shared by PackedIntArray and DynamicPackedIntArray. The
+// width is passed in by the derived classes, bits past the last value
+// are always clear.
+class GPackedIntArray : protected Array<uint64> {
+public:
+	uint32 Num() const { return ValueNum; }
+	bool IsValidIndex(uint32 index) const { return index < ValueNum; }
+	// The memory used by the words
+	uint64 GetNumBytes() const { return sizeof(uint64) * uint64(ArrayNum); }
+	const uint64* GetWords() const { return Data; }
+	void Reset();
+	
+protected:
+	GPackedIntArray();
+	GPackedIntArray(const GPackedIntArray& other);
+	GPackedIntArray(GPackedIntArray&& other);
+	GPackedIntArray& operator=(const GPackedIntArray& other);
+	GPackedIntArray& operator=(GPackedIntArray&& other);
+	
+	void ReserveValues(uint32 num, uint32 bits);
+	// Grows with zeroed values, or shrinks to num values
+	void SetValueNum(uint32 num, uint32 bits);
+	// Makes room for count more values and returns the first new index
+	inline uint32 AddValues(uint32 count, uint32 bits);
+	
+	uint32 ValueNum;
+};
+
+inline uint32 GPackedIntArray::AddValues(uint32 count, uint32 bits)
+{
+	const uint32 first = ValueNum;
+	const uint32 wordCount = PackedInt::GetWordCount(first + count, bits);
+	if (wordCount > ArrayNum) {
+		const uint32 numNew = wordCount - ArrayNum;
+		Memory::FillZero(AddUninitialized(numNew), sizeof(uint64) * numNew);
+	}
+	ValueNum += count;
+	return first;
+}
+
+// An array of unsigned integers of Bits bits each. Every operation is
+// compiled for the width, so accesses reduce to shifts and masks.
+template<uint32 Bits>
+class PackedIntArray : public GPackedIntArray {
+	STATIC_CHECK(Bits > 0 && Bits <= PackedInt::MaxBits);
+public:
+	static constexpr uint32 BitWidth = Bits;
+	static constexpr uint32 MaxValue = uint32((uint64(1) << Bits) - 1);
+	
+	PackedIntArray() = default;
+	PackedIntArray(uint32 buffer) { ReserveValues(buffer, Bits); }
+	
+	void Add(uint32 value);
+	// Appends all values, see PackedInt::Pack
+	void AddRange(const ArrayView<uint32>& values);
+	uint32 Get(uint32 index) const;
+	void Set(uint32 index, uint32 value);
+	uint32 operator[](uint32 index) const { return Get(index); }
+	
+	// Replaces the contents of outValues with count values from first
+	void Unpack(uint32 first, uint32 count, Array<uint32>& outValues) const;
+	// Overwrites the values from first with values
+	void Pack(uint32 first, const ArrayView<uint32>& values);
+	
+	void Reserve(uint32 num) { ReserveValues(num, Bits); }
+	void SetNum(uint32 num) { SetValueNum(num, Bits); }
+};
+
+// A PackedIntArray whose width is chosen at runtime
+class DynamicPackedIntArray : public GPackedIntArray {
+public:
+	DynamicPackedIntArray();
+	DynamicPackedIntArray(uint32 bitWidth, uint32 buffer = 0);
+	
+	// Changes the width of an empty array
+	void SetBitWidth(uint32 bitWidth);
+	uint32 GetBitWidth() const { return BitWidth; }
+	uint32 GetMaxValue() const { return uint32((uint64(1) << BitWidth) - 1); }
+	
+	void Add(uint32 value);
+	void AddRange(const ArrayView<uint32>& values);
+	uint32 Get(uint32 index) const;
+	void Set(uint32 index, uint32 value);
+	uint32 operator[](uint32 index) const { return Get(index); }
+	
+	void Unpack(uint32 first, uint32 count, Array<uint32>& outValues) const;
+	void Pack(uint32 first, const ArrayView<uint32>& values);
+	
+	void Reserve(uint32 num) { ReserveValues(num, BitWidth); }
+	void SetNum(uint32 num) { SetValueNum(num, BitWidth); }
+	
+protected:
+	uint32 BitWidth;
+};
+
+inline uint32 DynamicPackedIntArray::Get(uint32 index) const
+{
+	CHECK(IsValidIndex(index));
+	return PackedInt::Get(Data, index, BitWidth);
+}
+
+template<uint32 Bits>
+void PackedIntArray<Bits>::Add(uint32 value)
+{
+	CHECK(value <= MaxValue);
+	PackedInt::Set(Data, AddValues(1, Bits), Bits, value);
+}
+
+template<uint32 Bits>
+void PackedIntArray<Bits>::AddRange(const ArrayView<uint32>& values)
+{
+	const uint32 first = AddValues(values.Size(), Bits);
+	Pack(first, values);
+}
+
+template<uint32 Bits>
+uint32 PackedIntArray<Bits>::Get(uint32 index) const
+{
+	CHECK(IsValidIndex(index));
+	return PackedInt::Get(Data, index, Bits);
+}
+
+template<uint32 Bits>
+void PackedIntArray<Bits>::Set(uint32 index, uint32 value)
+{
+	CHECK(IsValidIndex(index) && value <= MaxValue);
+	PackedInt::Set(Data, index, Bits, value);
+}
+
+template<uint32 Bits>
+void PackedIntArray<Bits>::Unpack(uint32 first, uint32 count, Array<uint32>& outValues) const
+{
+	CHECK(uint64(first) + count <= ValueNum);
+	outValues.Reset();
+	PackedInt::Unpack<Bits>(Data, first, count, outValues.AddUninitialized(count));
+}
+
+template<uint32 Bits>
+void PackedIntArray<Bits>::Pack(uint32 first, const ArrayView<uint32>& values)
+{
+	CHECK(uint64(first) + values.Size() <= ValueNum);
+	uint32 combined = 0;
+	for (uint32 i = 0; i < values.Size(); ++i) {
+		combined |= values.ConstData()[i];
+	}
+	CHECK(combined <= MaxValue);
+	PackedInt::Pack<Bits>(Data, first, values.Size(), values.ConstData());
+}
\ No newline at end of file
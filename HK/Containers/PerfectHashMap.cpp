@@ -0,0 +1,89 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/PerfectHashMap.h"
+
+void PerfectHash::Build(const uint64* hashes, uint32 numKeys, uint32* outDisplacements, uint32* outSlots)
+{
+	const uint32 numBuckets = GetNumBuckets(numKeys);
+	
+	// Group the keys by bucket with a counting sort
+	Array<uint32> bucketStart(numBuckets + 1);
+	Memory::FillZero(bucketStart.AddUninitialized(numBuckets + 1), sizeof(uint32) * (numBuckets + 1));
+	uint32 maxBucketSize = 0;
+	for (uint32 i = 0; i < numKeys; ++i) {
+		const uint32 size = ++bucketStart[GetBucket(hashes[i], numBuckets) + 1];
+		maxBucketSize = size > maxBucketSize ? size : maxBucketSize;
+	}
+	for (uint32 b = 0; b < numBuckets; ++b) {
+		bucketStart[b + 1] += bucketStart[b];
+	}
+	Array<uint32> keys(numKeys);
+	keys.AddUninitialized(numKeys);
+	{
+		Array<uint32> cursor(bucketStart);
+		for (uint32 i = 0; i < numKeys; ++i) {
+			keys[cursor[GetBucket(hashes[i], numBuckets)]++] = i;
+		}
+	}
+	
+	// Order the buckets from largest to smallest, the large ones are
+	// placed while the table is still mostly empty.
+	Array<uint32> sizeStart(maxBucketSize + 2);
+	Memory::FillZero(sizeStart.AddUninitialized(maxBucketSize + 2), sizeof(uint32) * (maxBucketSize + 2));
+	for (uint32 b = 0; b < numBuckets; ++b) {
+		++sizeStart[maxBucketSize - (bucketStart[b + 1] - bucketStart[b]) + 1];
+	}
+	for (uint32 s = 0; s <= maxBucketSize; ++s) {
+		sizeStart[s + 1] += sizeStart[s];
+	}
+	Array<uint32> bucketOrder(numBuckets);
+	bucketOrder.AddUninitialized(numBuckets);
+	for (uint32 b = 0; b < numBuckets; ++b) {
+		bucketOrder[sizeStart[maxBucketSize - (bucketStart[b + 1] - bucketStart[b])]++] = b;
+	}
+	
+	Array<uint8> taken(numKeys);
+	Memory::FillZero(taken.AddUninitialized(numKeys), numKeys);
+	Array<uint32> bucketSlots(maxBucketSize);
+	bucketSlots.AddUninitialized(maxBucketSize);
+	
+	for (uint32 order = 0; order < numBuckets; ++order) {
+		const uint32 bucket = bucketOrder[order];
+		const uint32 first = bucketStart[bucket];
+		const uint32 size = bucketStart[bucket + 1] - first;
+		outDisplacements[bucket] = 0;
+		if (size == 0) {
+			continue;
+		}
+		
+		// Keys with the same hash can never be separated
+		for (uint32 i = 0; i < size; ++i) {
+			for (uint32 j = i + 1; j < size; ++j) {
+				CHECK(hashes[keys[first + i]] != hashes[keys[first + j]]);
+			}
+		}
+		
+		for (uint32 displacement = 0;; ++displacement) {
+			bool bFits = true;
+			for (uint32 i = 0; i < size && bFits; ++i) {
+				const uint32 slot = GetSlot(hashes[keys[first + i]], displacement, numKeys);
+				bFits = taken[slot] == 0;
+				for (uint32 j = 0; j < i && bFits; ++j) {
+					bFits = bucketSlots[j] != slot;
+				}
+				bucketSlots[i] = slot;
+			}
+			if (bFits) {
+				outDisplacements[bucket] = displacement;
+				break;
+			}
+			CHECK(displacement != Traits::Limits<uint32>::Max);
+		}
+		
+		for (uint32 i = 0; i < size; ++i) {
+			taken[bucketSlots[i]] = 1;
+			outSlots[keys[first + i]] = bucketSlots[i];
+		}
+	}
+}
\ No newline at end of file
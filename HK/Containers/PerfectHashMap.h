@@ -0,0 +1,309 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "HashMap.h"
+#include "View/StringView.h"
+
+// Hash and displace construction of minimal perfect hash functions.
+// Keys are hashed once and grouped into buckets of about KeysPerBucket
+// keys. Buckets are placed largest first, each trying displacements
+// until all of its keys land in free slots, so the final table has
+// exactly one slot per key and every lookup probes a single slot.
+namespace PerfectHash {
+	constexpr uint32 KeysPerBucket = 4;
+	
+	constexpr uint32 GetNumBuckets(uint32 numKeys)
+	{
+		return numKeys / KeysPerBucket + 1;
+	}
+	
+	constexpr uint32 GetBucket(uint64 hash, uint32 numBuckets)
+	{
+		return uint32((uint64(uint32(hash >> 32)) * numBuckets) >> 32);
+	}
+	
+	constexpr uint32 GetSlot(uint64 hash, uint32 displacement, uint32 numKeys)
+	{
+		const uint64 mixed = Hasher::Mix(hash + uint64(displacement) * 0x9E3779B97F4A7C15ULL);
+		return uint32((uint64(uint32(mixed >> 32)) * numKeys) >> 32);
+	}
+	
+	// FNV-1a, usable at compile time for StaticStringSwitch
+	constexpr uint64 HashString(const char8* data, uint32 size)
+	{
+		uint64 hash = 0xCBF29CE484222325ULL;
+		for (uint32 i = 0; i < size; ++i) {
+			hash ^= uint8(data[i]);
+			hash *= 0x100000001B3ULL;
+		}
+		return Hasher::Mix(hash);
+	}
+	
+	// Places numKeys unique hashes, filling outDisplacements with
+	// GetNumBuckets(numKeys) entries and outSlots with the slot of
+	// every hash.
+	void Build(const uint64* hashes, uint32 numKeys, uint32* outDisplacements, uint32* outSlots);
+}
+
+// A read-only hash map over a fixed set of keys, built once with a
+// minimal perfect hash function. A lookup is one hash and one compare,
+// and the table holds no empty slots.
+// Use it for tables whose keys are all known up front, such as
+// keyword or enum name tables.
+template<class TKey, class TValue>
+class PerfectHashMap {
+public:
+	typedef HashMapEntry<TKey, TValue> EntryType;
+	
+	PerfectHashMap();
+	// The keys must be unique, the values are default constructed
+	PerfectHashMap(const ArrayView<TKey>& keys);
+	PerfectHashMap(const ArrayView<TKey>& keys, const ArrayView<TValue>& values);
+	
+	TValue* Find(const TKey& key);
+	const TValue* Find(const TKey& key) const;
+	TValue& FindChecked(const TKey& key);
+	const TValue& FindChecked(const TKey& key) const;
+	
+	// See HashMap::FindAs.
+	template<typename K>
+	TValue* FindAs(const K& key);
+	template<typename K>
+	const TValue* FindAs(const K& key) const;
+	
+	uint32 Num() const;
+	// The entries in slot order, not in the order they were given in
+	ArrayView<EntryType> View() const;
+	
+	EntryType* begin() { return Entries.begin(); }
+	EntryType* end() { return Entries.end(); }
+	const EntryType* begin() const { return Entries.begin(); }
+	const EntryType* end() const { return Entries.end(); }
+	
+protected:
+	void Build(const ArrayView<TKey>& keys);
+	template<typename K>
+	int32 FindSlot(const K& key) const;
+	
+	Array<uint32> Displacements;
+	Array<EntryType> Entries;
+};
+
+// A compile time perfect hash over string literals that maps a
+// StringView to the index of the matching literal, or -1. Switching on
+// the result replaces a chain of string compares with one hash, one
+// compare and a jump table.
+//
+//	constexpr auto Keywords = MakeStringSwitch("if", "else", "while");
+//	switch (Keywords.Find(token)) {
+//		case 0: ...
+//	}
+template<uint32 N>
+class StaticStringSwitch {
+	static_assert(N > 0, "StaticStringSwitch needs at least one key");
+public:
+	static constexpr uint32 NumBuckets = PerfectHash::GetNumBuckets(N);
+	
+	constexpr StaticStringSwitch(const char8* const* keys, const uint32* sizes);
+	
+	int32 Find(const StringView& key) const;
+	constexpr uint32 Num() const { return N; }
+	
+private:
+	const char8* Keys[N] = {};
+	uint32 Sizes[N] = {};
+	// The index of the literal stored in each slot
+	uint32 Indices[N] = {};
+	uint32 Displacements[NumBuckets] = {};
+};
+
+template<typename... Ts>
+constexpr StaticStringSwitch<sizeof...(Ts)> MakeStringSwitch(const Ts&... keys)
+{
+	const char8* const data[] = { keys... };
+	const uint32 sizes[] = { uint32(sizeof(Ts) - 1)... };
+	return StaticStringSwitch<sizeof...(Ts)>(data, sizes);
+}
+
+template<class TKey, class TValue>
+PerfectHashMap<TKey, TValue>::PerfectHashMap()
+{
+}
+
+template<class TKey, class TValue>
+PerfectHashMap<TKey, TValue>::PerfectHashMap(const ArrayView<TKey>& keys)
+{
+	Build(keys);
+}
+
+template<class TKey, class TValue>
+PerfectHashMap<TKey, TValue>::PerfectHashMap(const ArrayView<TKey>& keys, const ArrayView<TValue>& values)
+{
+	CHECK(keys.Size() == values.Size());
+	Build(keys);
+	for (uint32 i = 0; i < keys.Size(); ++i) {
+		Entries[FindSlot(keys[i])].Value = values[i];
+	}
+}
+
+template<class TKey, class TValue>
+TValue* PerfectHashMap<TKey, TValue>::Find(const TKey& key)
+{
+	return FindAs(key);
+}
+
+template<class TKey, class TValue>
+const TValue* PerfectHashMap<TKey, TValue>::Find(const TKey& key) const
+{
+	return FindAs(key);
+}
+
+template<class TKey, class TValue>
+TValue& PerfectHashMap<TKey, TValue>::FindChecked(const TKey& key)
+{
+	TValue* value = FindAs(key);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<class TKey, class TValue>
+const TValue& PerfectHashMap<TKey, TValue>::FindChecked(const TKey& key) const
+{
+	const TValue* value = FindAs(key);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<class TKey, class TValue>
+template<typename K>
+TValue* PerfectHashMap<TKey, TValue>::FindAs(const K& key)
+{
+	const int32 slot = FindSlot(key);
+	return slot != -1 ? &Entries[slot].Value : nullptr;
+}
+
+template<class TKey, class TValue>
+template<typename K>
+const TValue* PerfectHashMap<TKey, TValue>::FindAs(const K& key) const
+{
+	const int32 slot = FindSlot(key);
+	return slot != -1 ? &Entries[slot].Value : nullptr;
+}
+
+template<class TKey, class TValue>
+uint32 PerfectHashMap<TKey, TValue>::Num() const
+{
+	return Entries.Num();
+}
+
+template<class TKey, class TValue>
+ArrayView<HashMapEntry<TKey, TValue>> PerfectHashMap<TKey, TValue>::View() const
+{
+	return Entries.View();
+}
+
+template<class TKey, class TValue>
+void PerfectHashMap<TKey, TValue>::Build(const ArrayView<TKey>& keys)
+{
+	const uint32 numKeys = keys.Size();
+	if (numKeys == 0) {
+		return;
+	}
+	
+	Array<uint64> hashes(numKeys);
+	for (uint32 i = 0; i < numKeys; ++i) {
+		hashes.Add(Hasher::Mix(Hasher::Hash<uint64>(keys[i])));
+	}
+	
+	Array<uint32> slots(numKeys);
+	slots.AddUninitialized(numKeys);
+	Displacements.AddUninitialized(PerfectHash::GetNumBuckets(numKeys));
+	PerfectHash::Build(hashes.GetData(), numKeys, Displacements.GetData(), slots.GetData());
+	
+	EntryType* entries = Entries.AddUninitialized(numKeys);
+	for (uint32 i = 0; i < numKeys; ++i) {
+		Memory::PlacementNew<EntryType>(&entries[slots[i]], keys[i]);
+	}
+}
+
+template<class TKey, class TValue>
+template<typename K>
+int32 PerfectHashMap<TKey, TValue>::FindSlot(const K& key) const
+{
+	const uint32 numKeys = Entries.Num();
+	if (UNLIKELY(numKeys == 0)) {
+		return -1;
+	}
+	const uint64 hash = Hasher::Mix(Hasher::Hash<uint64>(key));
+	const uint32 displacement = Displacements[PerfectHash::GetBucket(hash, Displacements.Num())];
+	const uint32 slot = PerfectHash::GetSlot(hash, displacement, numKeys);
+	return Entries[slot].Key == key ? int32(slot) : -1;
+}
+
+template<uint32 N>
+constexpr StaticStringSwitch<N>::StaticStringSwitch(const char8* const* keys, const uint32* sizes)
+{
+	uint64 hashes[N] = {};
+	uint32 bucketSizes[NumBuckets] = {};
+	for (uint32 i = 0; i < N; ++i) {
+		hashes[i] = PerfectHash::HashString(keys[i], sizes[i]);
+		++bucketSizes[PerfectHash::GetBucket(hashes[i], NumBuckets)];
+	}
+	
+	bool taken[N] = {};
+	bool placed[NumBuckets] = {};
+	uint32 bucketSlots[N] = {};
+	for (uint32 round = 0; round < NumBuckets; ++round) {
+		// Place the largest remaining bucket
+		uint32 bucket = 0;
+		for (uint32 b = 0; b < NumBuckets; ++b) {
+			if (!placed[b] && (placed[bucket] || bucketSizes[b] > bucketSizes[bucket])) {
+				bucket = b;
+			}
+		}
+		placed[bucket] = true;
+		
+		for (uint32 displacement = 0; bucketSizes[bucket] > 0; ++displacement) {
+			uint32 numPlaced = 0;
+			bool bFits = true;
+			for (uint32 i = 0; i < N && bFits; ++i) {
+				if (PerfectHash::GetBucket(hashes[i], NumBuckets) != bucket) {
+					continue;
+				}
+				const uint32 slot = PerfectHash::GetSlot(hashes[i], displacement, N);
+				bFits = !taken[slot];
+				for (uint32 j = 0; j < numPlaced && bFits; ++j) {
+					bFits = bucketSlots[j] != slot;
+				}
+				bucketSlots[numPlaced++] = slot;
+			}
+			if (bFits) {
+				Displacements[bucket] = displacement;
+				break;
+			}
+		}
+		
+		for (uint32 i = 0; i < N; ++i) {
+			if (bucketSizes[bucket] > 0 && PerfectHash::GetBucket(hashes[i], NumBuckets) == bucket) {
+				const uint32 slot = PerfectHash::GetSlot(hashes[i], Displacements[bucket], N);
+				taken[slot] = true;
+				Keys[slot] = keys[i];
+				Sizes[slot] = sizes[i];
+				Indices[slot] = i;
+			}
+		}
+	}
+}
+
+template<uint32 N>
+int32 StaticStringSwitch<N>::Find(const StringView& key) const
+{
+	const uint64 hash = PerfectHash::HashString(key.Data(), key.Size());
+	const uint32 slot = PerfectHash::GetSlot(hash, Displacements[PerfectHash::GetBucket(hash, NumBuckets)], N);
+	if (Sizes[slot] != key.Size() || !Memory::StringEquals(Keys[slot], key.Data(), key.Size())) {
+		return -1;
+	}
+	return int32(Indices[slot]);
+}
\ No newline at end of file
@@ -0,0 +1,347 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Common/Meta.h"
+
+// Refers to one element of a PolyArray. Stays valid until that element
+// is removed, after which its slot may be handed out again.
+struct PolyHandle {
+	uint32 Type = INVALID_INDEX;
+	uint32 Slot = INVALID_INDEX;
+};
+
+// The elements of one type of a PolyArray
+template<typename T>
+struct PolyArrayBucket {
+	Array<T> Items;
+	// The slot of every item, parallel to Items
+	Array<uint32> ItemSlots;
+	// The item of every slot, INVALID_INDEX if the slot is free
+	Array<uint32> SlotItems;
+	Array<uint32> FreeSlots;
+	// The position in the insertion order of every slot
+	Array<uint32> SlotOrder;
+};
+
+template<typename... Types>
+struct PolyArrayBuckets : public PolyArrayBucket<Types>... {
+};
+
+// A container for values of several types that keeps one dense array
+// per type, instead of an Array of TaggedUnion that pads every element
+// to the largest type and branches on the tag for every visit.
+// ForEach visits each type's array in one loop. Adding and removing
+// are O(1), removal swaps the last element of the type into the hole.
+// The insertion order across types is only kept when requested, it
+// costs an extra index per element and ForEachInOrder dispatches on
+// the type of every element.
+template<typename... Types>
+class PolyArray {
+	static_assert(Meta::GetNumTypes<Types...>() > 0, "At least one type must be provided");
+public:
+	PolyArray(bool bKeepOrder = false);
+	
+	template<typename U>
+	PolyHandle Add(U value);
+	void Remove(PolyHandle handle);
+	void Clear();
+	
+	bool IsValid(PolyHandle handle) const;
+	// Returns nullptr if the handle doesn't refer to a U
+	template<typename U>
+	U* Find(PolyHandle handle);
+	template<typename U>
+	const U* Find(PolyHandle handle) const;
+	template<typename U>
+	U& FindChecked(PolyHandle handle);
+	template<typename U>
+	const U& FindChecked(PolyHandle handle) const;
+	
+	// The elements of type U, densely packed in no particular order
+	template<typename U>
+	ArrayView<U> View() const;
+	template<typename U>
+	uint32 Num() const;
+	// The number of elements of all types
+	uint32 Num() const;
+	
+	// Calls f(U&) for every element, one type after the other. f is
+	// usually a generic lambda, or a type with an overload per type.
+	template<typename F>
+	void ForEach(const F& f);
+	template<typename F>
+	void ForEach(const F& f) const;
+	// Calls f(U&) for every element in the order they were added,
+	// requires the order to be kept
+	template<typename F>
+	void ForEachInOrder(const F& f);
+	
+	template<typename U>
+	static constexpr uint32 GetTag();
+	
+protected:
+	template<typename U>
+	PolyArrayBucket<U>& GetBucket() { return static_cast<PolyArrayBucket<U>&>(Buckets); }
+	template<typename U>
+	const PolyArrayBucket<U>& GetBucket() const { return static_cast<const PolyArrayBucket<U>&>(Buckets); }
+	
+	template<typename U>
+	void RemoveFromBucket(uint32 slot);
+	template<typename U>
+	void ClearBucket();
+	template<typename U>
+	uint32 GetSlotItem(PolyHandle handle) const;
+	template<typename U, typename F>
+	void VisitInOrder(PolyHandle handle, const F& f);
+	template<typename U>
+	void SetSlotOrder(PolyHandle handle, uint32 position);
+	// Drops the removed entries from the order once they are the majority
+	void CompactOrder();
+	
+	PolyArrayBuckets<Types...> Buckets;
+	// Every element in the order it was added, removed ones have an
+	// invalid type until the order is compacted
+	Array<PolyHandle> Order;
+	uint32 NumRemovedFromOrder;
+	bool bKeepOrder;
+};
+
+template<typename... Types>
+PolyArray<Types...>::PolyArray(bool bKeepOrder)
+	: NumRemovedFromOrder(0)
+	, bKeepOrder(bKeepOrder)
+{
+}
+
+template<typename... Types>
+template<typename U>
+PolyHandle PolyArray<Types...>::Add(U value)
+{
+	PolyArrayBucket<U>& bucket = GetBucket<U>();
+	PolyHandle handle;
+	handle.Type = GetTag<U>();
+	if (bucket.FreeSlots.Num() > 0) {
+		handle.Slot = bucket.FreeSlots.Pop();
+		bucket.SlotItems[handle.Slot] = bucket.Items.Num();
+	} else {
+		handle.Slot = bucket.SlotItems.Num();
+		bucket.SlotItems.Add(bucket.Items.Num());
+		if (bKeepOrder) {
+			bucket.SlotOrder.Add(INVALID_INDEX);
+		}
+	}
+	Memory::PlacementNew<U>(bucket.Items.AddUninitialized(1), Move(value));
+	bucket.ItemSlots.Add(handle.Slot);
+	if (bKeepOrder) {
+		bucket.SlotOrder[handle.Slot] = Order.Num();
+		Order.Add(handle);
+	}
+	return handle;
+}
+
+template<typename... Types>
+void PolyArray<Types...>::Remove(PolyHandle handle)
+{
+	CHECK(IsValid(handle));
+	// Only the matching type removes, the others compile to nothing
+	((handle.Type == GetTag<Types>() ? RemoveFromBucket<Types>(handle.Slot) : void()), ...);
+}
+
+template<typename... Types>
+void PolyArray<Types...>::Clear()
+{
+	(ClearBucket<Types>(), ...);
+	Order.Reset();
+	NumRemovedFromOrder = 0;
+}
+
+template<typename... Types>
+bool PolyArray<Types...>::IsValid(PolyHandle handle) const
+{
+	bool bValid = false;
+	((bValid |= handle.Type == GetTag<Types>() && GetSlotItem<Types>(handle) != INVALID_INDEX), ...);
+	return bValid;
+}
+
+template<typename... Types>
+template<typename U>
+U* PolyArray<Types...>::Find(PolyHandle handle)
+{
+	const uint32 item = handle.Type == GetTag<U>() ? GetSlotItem<U>(handle) : INVALID_INDEX;
+	return item != INVALID_INDEX ? &GetBucket<U>().Items[item] : nullptr;
+}
+
+template<typename... Types>
+template<typename U>
+const U* PolyArray<Types...>::Find(PolyHandle handle) const
+{
+	const uint32 item = handle.Type == GetTag<U>() ? GetSlotItem<U>(handle) : INVALID_INDEX;
+	return item != INVALID_INDEX ? &GetBucket<U>().Items[item] : nullptr;
+}
+
+template<typename... Types>
+template<typename U>
+U& PolyArray<Types...>::FindChecked(PolyHandle handle)
+{
+	U* value = Find<U>(handle);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<typename... Types>
+template<typename U>
+const U& PolyArray<Types...>::FindChecked(PolyHandle handle) const
+{
+	const U* value = Find<U>(handle);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<typename... Types>
+template<typename U>
+ArrayView<U> PolyArray<Types...>::View() const
+{
+	return GetBucket<U>().Items.View();
+}
+
+template<typename... Types>
+template<typename U>
+uint32 PolyArray<Types...>::Num() const
+{
+	return GetBucket<U>().Items.Num();
+}
+
+template<typename... Types>
+uint32 PolyArray<Types...>::Num() const
+{
+	return (GetBucket<Types>().Items.Num() + ...);
+}
+
+template<typename... Types>
+template<typename F>
+void PolyArray<Types...>::ForEach(const F& f)
+{
+	([&]() {
+		for (Types& item : GetBucket<Types>().Items) {
+			f(item);
+		}
+	}(), ...);
+}
+
+template<typename... Types>
+template<typename F>
+void PolyArray<Types...>::ForEach(const F& f) const
+{
+	([&]() {
+		for (const Types& item : GetBucket<Types>().Items) {
+			f(item);
+		}
+	}(), ...);
+}
+
+template<typename... Types>
+template<typename F>
+void PolyArray<Types...>::ForEachInOrder(const F& f)
+{
+	CHECK(bKeepOrder);
+	for (uint32 i = 0; i < Order.Num(); ++i) {
+		const PolyHandle handle = Order[i];
+		(VisitInOrder<Types>(handle, f), ...);
+	}
+}
+
+template<typename... Types>
+template<typename U>
+constexpr uint32 PolyArray<Types...>::GetTag()
+{
+	constexpr int32 index = Meta::GetIndex<U, Types...>();
+	static_assert(index != -1, "Type not supported");
+	return uint32(index);
+}
+
+template<typename... Types>
+template<typename U>
+void PolyArray<Types...>::RemoveFromBucket(uint32 slot)
+{
+	PolyArrayBucket<U>& bucket = GetBucket<U>();
+	const uint32 item = bucket.SlotItems[slot];
+	const uint32 lastItem = bucket.Items.Num() - 1;
+	if (item != lastItem) {
+		bucket.Items[item] = Move(bucket.Items[lastItem]);
+		bucket.ItemSlots[item] = bucket.ItemSlots[lastItem];
+		bucket.SlotItems[bucket.ItemSlots[item]] = item;
+	}
+	bucket.Items.RemoveAt(lastItem);
+	bucket.ItemSlots.RemoveAt(lastItem);
+	bucket.SlotItems[slot] = INVALID_INDEX;
+	bucket.FreeSlots.Add(slot);
+	
+	if (bKeepOrder) {
+		Order[bucket.SlotOrder[slot]].Type = INVALID_INDEX;
+		bucket.SlotOrder[slot] = INVALID_INDEX;
+		++NumRemovedFromOrder;
+		CompactOrder();
+	}
+}
+
+template<typename... Types>
+template<typename U>
+void PolyArray<Types...>::ClearBucket()
+{
+	PolyArrayBucket<U>& bucket = GetBucket<U>();
+	bucket.Items.Reset();
+	bucket.ItemSlots.Reset();
+	bucket.SlotItems.Reset();
+	bucket.FreeSlots.Reset();
+	bucket.SlotOrder.Reset();
+}
+
+template<typename... Types>
+template<typename U>
+uint32 PolyArray<Types...>::GetSlotItem(PolyHandle handle) const
+{
+	const PolyArrayBucket<U>& bucket = GetBucket<U>();
+	return handle.Slot < bucket.SlotItems.Num() ? bucket.SlotItems[handle.Slot] : INVALID_INDEX;
+}
+
+template<typename... Types>
+template<typename U, typename F>
+void PolyArray<Types...>::VisitInOrder(PolyHandle handle, const F& f)
+{
+	if (handle.Type == GetTag<U>()) {
+		PolyArrayBucket<U>& bucket = GetBucket<U>();
+		f(bucket.Items[bucket.SlotItems[handle.Slot]]);
+	}
+}
+
+template<typename... Types>
+template<typename U>
+void PolyArray<Types...>::SetSlotOrder(PolyHandle handle, uint32 position)
+{
+	if (handle.Type == GetTag<U>()) {
+		GetBucket<U>().SlotOrder[handle.Slot] = position;
+	}
+}
+
+template<typename... Types>
+void PolyArray<Types...>::CompactOrder()
+{
+	if (NumRemovedFromOrder * 2 < Order.Num()) {
+		return;
+	}
+	uint32 num = 0;
+	for (uint32 i = 0; i < Order.Num(); ++i) {
+		const PolyHandle handle = Order[i];
+		if (handle.Type != INVALID_INDEX) {
+			(SetSlotOrder<Types>(handle, num), ...);
+			Order[num++] = handle;
+		}
+	}
+	while (Order.Num() > num) {
+		Order.RemoveAt(Order.Num() - 1);
+	}
+	NumRemovedFromOrder = 0;
+}
\ No newline at end of file
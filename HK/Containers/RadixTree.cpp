@@ -0,0 +1,621 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/RadixTree.h"
+
+#include "Common/Math.h"
+
+// SSE2 is part of every x86-64 CPU, MSVC doesn't define __SSE2__ there
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RADIX_SSE2 1
+#else
+#define RADIX_SSE2 0
+#endif
+
+static bool IsLeaf(const void* child)
+{
+	return (uintptr(child) & 1) != 0;
+}
+
+static RadixLeaf* ToLeaf(const void* child)
+{
+	return reinterpret_cast<RadixLeaf*>(uintptr(child) & ~uintptr(1));
+}
+
+static void* FromLeaf(RadixLeaf* leaf)
+{
+	return reinterpret_cast<void*>(uintptr(leaf) | 1);
+}
+
+static uint8 KeyByte(StringView key, uint32 index)
+{
+	return uint8(key.Data()[index]);
+}
+
+static uint32 GetMaxChildren(ERadixNodeType type)
+{
+	switch (type) {
+	case ERadixNodeType::Node4: return 4;
+	case ERadixNodeType::Node16: return 16;
+	case ERadixNodeType::Node48: return 48;
+	default: return 256;
+	}
+}
+
+// Returns the index of byte in the 16 sorted keys, or INVALID_INDEX.
+// With SSE2 all 16 keys are compared in one instruction and the match
+// is read from the byte mask. Otherwise the keys are compared eight at
+// a time inside a uint64, a byte that equals byte becomes zero and the
+// lowest zero byte is found with the usual has-zero-byte trick. That
+// trick can only flag bytes above a real zero byte, so the lowest
+// flagged byte is always a real match.
+static uint32 FindKey16(const uint8* keys, uint32 num, uint8 byte)
+{
+#if RADIX_SSE2
+	const __m128i matches = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)keys), _mm_set1_epi8(char(byte)));
+	const uint32 mask = uint32(_mm_movemask_epi8(matches)) & ((1u << num) - 1);
+	return mask != 0 ? Math::CountTrailingZeros(mask) : INVALID_INDEX;
+#else
+	const uint64 ones = 0x0101010101010101;
+	const uint64 highs = 0x8080808080808080;
+	const uint64 pattern = ones * byte;
+	for (uint32 half = 0; half < 2; ++half) {
+		uint64 word;
+		Memory::Copy(keys + half * 8, &word, sizeof(word));
+		const uint64 diff = word ^ pattern;
+		const uint64 zeros = (diff - ones) & ~diff & highs;
+		if (zeros != 0) {
+			const uint32 index = half * 8 + Math::CountTrailingZeros(zeros) / 8;
+			return index < num ? index : INVALID_INDEX;
+		}
+	}
+	return INVALID_INDEX;
+#endif
+}
+
+static void** FindChild(const RadixNode* node, uint8 byte)
+{
+	switch (node->Type) {
+	case ERadixNodeType::Node4: {
+		RadixNode4* n = (RadixNode4*)node;
+		for (uint32 i = 0; i < n->NumChildren; ++i) {
+			if (n->Keys[i] == byte) {
+				return &n->Children[i];
+			}
+		}
+		return nullptr;
+	}
+	case ERadixNodeType::Node16: {
+		RadixNode16* n = (RadixNode16*)node;
+		const uint32 index = FindKey16(n->Keys, n->NumChildren, byte);
+		return index != INVALID_INDEX ? &n->Children[index] : nullptr;
+	}
+	case ERadixNodeType::Node48: {
+		RadixNode48* n = (RadixNode48*)node;
+		const uint32 index = n->ChildIndex[byte];
+		return index != 0 ? &n->Children[index - 1] : nullptr;
+	}
+	default: {
+		RadixNode256* n = (RadixNode256*)node;
+		return n->Children[byte] != nullptr ? &n->Children[byte] : nullptr;
+	}
+	}
+}
+
+// Calls f(uint8 byte, void* child) for every child in byte order
+template<typename F>
+static void ForEachChild(const RadixNode* node, const F& f)
+{
+	switch (node->Type) {
+	case ERadixNodeType::Node4: {
+		const RadixNode4* n = (const RadixNode4*)node;
+		for (uint32 i = 0; i < n->NumChildren; ++i) {
+			f(n->Keys[i], n->Children[i]);
+		}
+		break;
+	}
+	case ERadixNodeType::Node16: {
+		const RadixNode16* n = (const RadixNode16*)node;
+		for (uint32 i = 0; i < n->NumChildren; ++i) {
+			f(n->Keys[i], n->Children[i]);
+		}
+		break;
+	}
+	case ERadixNodeType::Node48: {
+		const RadixNode48* n = (const RadixNode48*)node;
+		for (uint32 byte = 0; byte < 256; ++byte) {
+			if (n->ChildIndex[byte] != 0) {
+				f(uint8(byte), n->Children[n->ChildIndex[byte] - 1]);
+			}
+		}
+		break;
+	}
+	default: {
+		const RadixNode256* n = (const RadixNode256*)node;
+		for (uint32 byte = 0; byte < 256; ++byte) {
+			if (n->Children[byte] != nullptr) {
+				f(uint8(byte), n->Children[byte]);
+			}
+		}
+		break;
+	}
+	}
+}
+
+// Any leaf below a node, they all share the full prefix of the node
+static RadixLeaf* FindAnyLeaf(const void* child)
+{
+	while (!IsLeaf(child)) {
+		const RadixNode* node = (const RadixNode*)child;
+		if (node->Terminal != nullptr) {
+			return node->Terminal;
+		}
+		switch (node->Type) {
+		case ERadixNodeType::Node4: child = ((const RadixNode4*)node)->Children[0]; break;
+		case ERadixNodeType::Node16: child = ((const RadixNode16*)node)->Children[0]; break;
+		case ERadixNodeType::Node48: child = ((const RadixNode48*)node)->Children[0]; break;
+		default: {
+			const RadixNode256* n = (const RadixNode256*)node;
+			uint32 byte = 0;
+			while (n->Children[byte] == nullptr) {
+				++byte;
+			}
+			child = n->Children[byte];
+			break;
+		}
+		}
+	}
+	return ToLeaf(child);
+}
+
+// Returns how many bytes of the prefix of node match key from depth,
+// checking the bytes that aren't stored against a leaf
+static uint32 MatchPrefix(const RadixNode* node, StringView key, uint32 depth)
+{
+	const uint32 max = Math::Min(node->PrefixLength, key.Size() - depth);
+	const uint32 stored = Math::Min(max, RadixMaxPrefix);
+	uint32 i = 0;
+	for (; i < stored; ++i) {
+		if (node->Prefix[i] != KeyByte(key, depth + i)) {
+			return i;
+		}
+	}
+	if (i < max) {
+		const RadixLeaf* leaf = FindAnyLeaf(node);
+		for (; i < max; ++i) {
+			if (KeyByte(leaf->Key, depth + i) != KeyByte(key, depth + i)) {
+				return i;
+			}
+		}
+	}
+	return i;
+}
+
+static void SetPrefix(RadixNode* node, StringView key, uint32 start, uint32 length)
+{
+	node->PrefixLength = length;
+	Memory::Copy(key.Data() + start, node->Prefix, Math::Min(length, RadixMaxPrefix));
+}
+
+static void VisitSubtree(const void* child, void(*visit)(RadixLeaf*, void*), void* context)
+{
+	if (IsLeaf(child)) {
+		visit(ToLeaf(child), context);
+		return;
+	}
+	const RadixNode* node = (const RadixNode*)child;
+	if (node->Terminal != nullptr) {
+		visit(node->Terminal, context);
+	}
+	ForEachChild(node, [visit, context](uint8, void* grandChild) {
+		VisitSubtree(grandChild, visit, context);
+	});
+}
+
+GRadixTree::GRadixTree()
+	: Root(nullptr)
+	, NumLeaves(0)
+{
+}
+
+GRadixTree::~GRadixTree()
+{
+	FreeNodes();
+}
+
+RadixLeaf* GRadixTree::FindLeaf(StringView key) const
+{
+	const void* child = Root;
+	uint32 depth = 0;
+	while (child != nullptr) {
+		if (IsLeaf(child)) {
+			RadixLeaf* leaf = ToLeaf(child);
+			return leaf->Key == key ? leaf : nullptr;
+		}
+
+		const RadixNode* node = (const RadixNode*)child;
+		if (node->PrefixLength > 0) {
+			if (key.Size() - depth < node->PrefixLength) {
+				return nullptr;
+			}
+			// Optimistic, the bytes past the stored ones are checked at the leaf
+			const uint32 stored = Math::Min(node->PrefixLength, RadixMaxPrefix);
+			for (uint32 i = 0; i < stored; ++i) {
+				if (node->Prefix[i] != KeyByte(key, depth + i)) {
+					return nullptr;
+				}
+			}
+			depth += node->PrefixLength;
+		}
+		if (depth == key.Size()) {
+			RadixLeaf* leaf = node->Terminal;
+			return leaf != nullptr && leaf->Key == key ? leaf : nullptr;
+		}
+
+		void** next = FindChild(node, KeyByte(key, depth));
+		child = next != nullptr ? *next : nullptr;
+		++depth;
+	}
+	return nullptr;
+}
+
+RadixLeaf* GRadixTree::InsertLeaf(RadixLeaf* leaf)
+{
+	const StringView key = leaf->Key;
+	void** ref = &Root;
+	uint32 depth = 0;
+	while (true) {
+		void* child = *ref;
+		if (child == nullptr) {
+			*ref = FromLeaf(leaf);
+			++NumLeaves;
+			return nullptr;
+		}
+
+		if (IsLeaf(child)) {
+			RadixLeaf* existing = ToLeaf(child);
+			if (existing->Key == key) {
+				return existing;
+			}
+			// Split into a node holding both leaves below their common prefix
+			const StringView other = existing->Key;
+			const uint32 max = Math::Min(key.Size(), other.Size());
+			uint32 common = depth;
+			while (common < max && KeyByte(key, common) == KeyByte(other, common)) {
+				++common;
+			}
+			RadixNode* node = AllocateNode(ERadixNodeType::Node4);
+			SetPrefix(node, key, depth, common - depth);
+			*ref = node;
+			RadixLeaf* const added[] = { existing, leaf };
+			for (RadixLeaf* addedLeaf : added) {
+				if (addedLeaf->Key.Size() == common) {
+					node->Terminal = addedLeaf;
+				} else {
+					AddChild(ref, node, KeyByte(addedLeaf->Key, common), FromLeaf(addedLeaf));
+				}
+			}
+			++NumLeaves;
+			return nullptr;
+		}
+
+		RadixNode* node = (RadixNode*)child;
+		if (node->PrefixLength > 0) {
+			const uint32 matched = MatchPrefix(node, key, depth);
+			if (matched < node->PrefixLength) {
+				// Split the prefix, a new node takes the matching part and
+				// the old node keeps what follows the first mismatch
+				const RadixLeaf* any = node->PrefixLength > RadixMaxPrefix ? FindAnyLeaf(node) : nullptr;
+				const uint8 oldByte = matched < RadixMaxPrefix ? node->Prefix[matched] : KeyByte(any->Key, depth + matched);
+
+				RadixNode* parent = AllocateNode(ERadixNodeType::Node4);
+				SetPrefix(parent, key, depth, matched);
+				*ref = parent;
+
+				const uint32 remaining = node->PrefixLength - matched - 1;
+				if (any == nullptr) {
+					Memory::Move(node->Prefix + matched + 1, node->Prefix, remaining);
+					node->PrefixLength = remaining;
+				} else {
+					SetPrefix(node, any->Key, depth + matched + 1, remaining);
+				}
+				AddChild(ref, parent, oldByte, node);
+
+				if (key.Size() == depth + matched) {
+					parent->Terminal = leaf;
+				} else {
+					AddChild(ref, parent, KeyByte(key, depth + matched), FromLeaf(leaf));
+				}
+				++NumLeaves;
+				return nullptr;
+			}
+			depth += node->PrefixLength;
+		}
+
+		if (depth == key.Size()) {
+			if (node->Terminal != nullptr) {
+				CHECK(node->Terminal->Key == key);
+				return node->Terminal;
+			}
+			node->Terminal = leaf;
+			++NumLeaves;
+			return nullptr;
+		}
+
+		const uint8 byte = KeyByte(key, depth);
+		void** next = FindChild(node, byte);
+		if (next == nullptr) {
+			AddChild(ref, node, byte, FromLeaf(leaf));
+			++NumLeaves;
+			return nullptr;
+		}
+		ref = next;
+		++depth;
+	}
+}
+
+RadixLeaf* GRadixTree::RemoveLeaf(StringView key)
+{
+	void** ref = &Root;
+	void** parentRef = nullptr;
+	RadixNode* parent = nullptr;
+	uint32 depth = 0;
+	while (*ref != nullptr) {
+		void* child = *ref;
+		if (IsLeaf(child)) {
+			RadixLeaf* leaf = ToLeaf(child);
+			if (!(leaf->Key == key)) {
+				return nullptr;
+			}
+			if (parent == nullptr) {
+				*ref = nullptr;
+			} else {
+				RemoveChild(parentRef, parent, KeyByte(key, depth - 1));
+			}
+			--NumLeaves;
+			return leaf;
+		}
+
+		RadixNode* node = (RadixNode*)child;
+		if (node->PrefixLength > 0) {
+			if (MatchPrefix(node, key, depth) != node->PrefixLength) {
+				return nullptr;
+			}
+			depth += node->PrefixLength;
+		}
+		if (depth == key.Size()) {
+			RadixLeaf* leaf = node->Terminal;
+			if (leaf == nullptr || !(leaf->Key == key)) {
+				return nullptr;
+			}
+			node->Terminal = nullptr;
+			Collapse(ref, node);
+			--NumLeaves;
+			return leaf;
+		}
+
+		void** next = FindChild(node, KeyByte(key, depth));
+		if (next == nullptr) {
+			return nullptr;
+		}
+		parentRef = ref;
+		parent = node;
+		ref = next;
+		++depth;
+	}
+	return nullptr;
+}
+
+void GRadixTree::VisitLeaves(StringView prefix, void(*visit)(RadixLeaf*, void*), void* context) const
+{
+	const void* child = Root;
+	uint32 depth = 0;
+	while (child != nullptr) {
+		if (IsLeaf(child)) {
+			if (ToLeaf(child)->Key.StartsWith(prefix)) {
+				visit(ToLeaf(child), context);
+			}
+			return;
+		}
+
+		const RadixNode* node = (const RadixNode*)child;
+		const uint32 left = prefix.Size() - depth;
+		const uint32 stored = Math::Min(Math::Min(node->PrefixLength, RadixMaxPrefix), left);
+		for (uint32 i = 0; i < stored; ++i) {
+			if (node->Prefix[i] != KeyByte(prefix, depth + i)) {
+				return;
+			}
+		}
+		if (node->PrefixLength >= left) {
+			// The prefix ends inside this node, every key below it matches
+			// once the bytes that weren't compared above do
+			if (FindAnyLeaf(node)->Key.StartsWith(prefix)) {
+				VisitSubtree(node, visit, context);
+			}
+			return;
+		}
+		depth += node->PrefixLength;
+
+		void** next = FindChild(node, KeyByte(prefix, depth));
+		child = next != nullptr ? *next : nullptr;
+		++depth;
+	}
+}
+
+void GRadixTree::FreeNodes()
+{
+	if (Root != nullptr) {
+		FreeNodeRecursive(Root);
+	}
+	Root = nullptr;
+	NumLeaves = 0;
+}
+
+RadixNode* GRadixTree::AllocateNode(ERadixNodeType type)
+{
+	RadixNode* node;
+	switch (type) {
+	case ERadixNodeType::Node4: node = Node4Pool.Allocate(); Memory::FillZero(node, sizeof(RadixNode4)); break;
+	case ERadixNodeType::Node16: node = Node16Pool.Allocate(); Memory::FillZero(node, sizeof(RadixNode16)); break;
+	case ERadixNodeType::Node48: node = Node48Pool.Allocate(); Memory::FillZero(node, sizeof(RadixNode48)); break;
+	default: node = Node256Pool.Allocate(); Memory::FillZero(node, sizeof(RadixNode256)); break;
+	}
+	node->Type = type;
+	return node;
+}
+
+void GRadixTree::FreeNode(RadixNode* node)
+{
+	switch (node->Type) {
+	case ERadixNodeType::Node4: Node4Pool.Free((RadixNode4*)node); break;
+	case ERadixNodeType::Node16: Node16Pool.Free((RadixNode16*)node); break;
+	case ERadixNodeType::Node48: Node48Pool.Free((RadixNode48*)node); break;
+	default: Node256Pool.Free((RadixNode256*)node); break;
+	}
+}
+
+void GRadixTree::FreeNodeRecursive(void* child)
+{
+	if (IsLeaf(child)) {
+		return;
+	}
+	RadixNode* node = (RadixNode*)child;
+	ForEachChild(node, [this](uint8, void* grandChild) {
+		FreeNodeRecursive(grandChild);
+	});
+	FreeNode(node);
+}
+
+void GRadixTree::AddChild(void** nodeRef, RadixNode* node, uint8 byte, void* child)
+{
+	if (node->NumChildren == GetMaxChildren(node->Type)) {
+		ResizeNode(nodeRef, node, ERadixNodeType(uint8(node->Type) + 1));
+		node = (RadixNode*)*nodeRef;
+	}
+
+	switch (node->Type) {
+	case ERadixNodeType::Node4:
+	case ERadixNodeType::Node16: {
+		uint8* keys = node->Type == ERadixNodeType::Node4 ? ((RadixNode4*)node)->Keys : ((RadixNode16*)node)->Keys;
+		void** children = node->Type == ERadixNodeType::Node4 ? ((RadixNode4*)node)->Children : ((RadixNode16*)node)->Children;
+		uint32 index = 0;
+		while (index < node->NumChildren && keys[index] < byte) {
+			++index;
+		}
+		const uint32 numAfter = node->NumChildren - index;
+		Memory::Move(keys + index, keys + index + 1, numAfter);
+		Memory::Move(children + index, children + index + 1, sizeof(void*) * numAfter);
+		keys[index] = byte;
+		children[index] = child;
+		break;
+	}
+	case ERadixNodeType::Node48: {
+		RadixNode48* n = (RadixNode48*)node;
+		n->Children[n->NumChildren] = child;
+		n->ChildIndex[byte] = uint8(n->NumChildren + 1);
+		break;
+	}
+	default:
+		((RadixNode256*)node)->Children[byte] = child;
+		break;
+	}
+	++node->NumChildren;
+}
+
+void GRadixTree::RemoveChild(void** nodeRef, RadixNode* node, uint8 byte)
+{
+	switch (node->Type) {
+	case ERadixNodeType::Node4:
+	case ERadixNodeType::Node16: {
+		uint8* keys = node->Type == ERadixNodeType::Node4 ? ((RadixNode4*)node)->Keys : ((RadixNode16*)node)->Keys;
+		void** children = node->Type == ERadixNodeType::Node4 ? ((RadixNode4*)node)->Children : ((RadixNode16*)node)->Children;
+		uint32 index = 0;
+		while (keys[index] != byte) {
+			++index;
+		}
+		const uint32 numAfter = node->NumChildren - index - 1;
+		Memory::Move(keys + index + 1, keys + index, numAfter);
+		Memory::Move(children + index + 1, children + index, sizeof(void*) * numAfter);
+		break;
+	}
+	case ERadixNodeType::Node48: {
+		// Keep the children dense, the last one moves into the hole
+		RadixNode48* n = (RadixNode48*)node;
+		const uint32 index = n->ChildIndex[byte] - 1;
+		const uint32 last = n->NumChildren - 1;
+		if (index != last) {
+			uint32 lastByte = 0;
+			while (n->ChildIndex[lastByte] != last + 1) {
+				++lastByte;
+			}
+			n->Children[index] = n->Children[last];
+			n->ChildIndex[lastByte] = uint8(index + 1);
+		}
+		n->ChildIndex[byte] = 0;
+		break;
+	}
+	default:
+		((RadixNode256*)node)->Children[byte] = nullptr;
+		break;
+	}
+	--node->NumChildren;
+
+	// Shrink with some slack so alternating adds and removes don't resize every time
+	const uint32 numChildren = node->NumChildren;
+	if ((node->Type == ERadixNodeType::Node256 && numChildren <= 36) ||
+		(node->Type == ERadixNodeType::Node48 && numChildren <= 12) ||
+		(node->Type == ERadixNodeType::Node16 && numChildren <= 3)) {
+		ResizeNode(nodeRef, node, ERadixNodeType(uint8(node->Type) - 1));
+		return;
+	}
+	Collapse(nodeRef, node);
+}
+
+void GRadixTree::Collapse(void** nodeRef, RadixNode* node)
+{
+	if (node->NumChildren + (node->Terminal != nullptr ? 1 : 0) != 1) {
+		return;
+	}
+	if (node->Terminal != nullptr) {
+		*nodeRef = FromLeaf(node->Terminal);
+		FreeNode(node);
+		return;
+	}
+
+	uint8 byte = 0;
+	void* child = nullptr;
+	ForEachChild(node, [&byte, &child](uint8 childByte, void* onlyChild) {
+		byte = childByte;
+		child = onlyChild;
+	});
+	if (!IsLeaf(child)) {
+		// Prepend the prefix of node and the byte leading to the child
+		RadixNode* childNode = (RadixNode*)child;
+		uint8 prefix[RadixMaxPrefix];
+		uint32 length = Math::Min(node->PrefixLength, RadixMaxPrefix);
+		Memory::Copy(node->Prefix, prefix, length);
+		if (length < RadixMaxPrefix) {
+			prefix[length++] = byte;
+		}
+		const uint32 fromChild = Math::Min(childNode->PrefixLength, RadixMaxPrefix - length);
+		Memory::Copy(childNode->Prefix, prefix + length, fromChild);
+		Memory::Copy(prefix, childNode->Prefix, length + fromChild);
+		childNode->PrefixLength += node->PrefixLength + 1;
+	}
+	*nodeRef = child;
+	FreeNode(node);
+}
+
+void GRadixTree::ResizeNode(void** nodeRef, RadixNode* node, ERadixNodeType type)
+{
+	RadixNode* resized = AllocateNode(type);
+	resized->PrefixLength = node->PrefixLength;
+	Memory::Copy(node->Prefix, resized->Prefix, RadixMaxPrefix);
+	resized->Terminal = node->Terminal;
+	*nodeRef = resized;
+	ForEachChild(node, [this, nodeRef, resized](uint8 byte, void* child) {
+		AddChild(nodeRef, resized, byte, child);
+	});
+	FreeNode(node);
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Allocators/Pool.h"
+#include "Containers/View/StringView.h"
+
+constexpr uint32 RadixMaxPrefix = 8;
+
+// Every key is stored in a leaf, typed trees extend it with the value
+struct RadixLeaf {
+	StringView Key;
+};
+
+enum class ERadixNodeType : uint8
+{
+	Node4,
+	Node16,
+	Node48,
+	Node256,
+};
+
+// Inner nodes. A child is either a node or a leaf with its lowest
+// pointer bit set. Only the first RadixMaxPrefix bytes of a longer
+// prefix are stored, lookups skip the rest and compare the whole key
+// at the leaf.
+struct RadixNode {
+	ERadixNodeType Type;
+	uint8 Padding;
+	uint16 NumChildren;
+	uint32 PrefixLength;
+	uint8 Prefix[RadixMaxPrefix];
+	// The leaf of the key that ends at this node
+	RadixLeaf* Terminal;
+};
+
+struct RadixNode4 : public RadixNode {
+	// Sorted
+	uint8 Keys[4];
+	void* Children[4];
+};
+
+struct RadixNode16 : public RadixNode {
+	// Sorted
+	uint8 Keys[16];
+	void* Children[16];
+};
+
+struct RadixNode48 : public RadixNode {
+	// One more than the index into Children, 0 if there is no child
+	uint8 ChildIndex[256];
+	void* Children[48];
+};
+
+struct RadixNode256 : public RadixNode {
+	void* Children[256];
+};
+
+// The untyped part of RadixTree, it owns the inner nodes and links
+// leaves that are allocated by the typed tree.
+class GRadixTree {
+public:
+	uint32 Num() const { return NumLeaves; }
+	
+protected:
+	GRadixTree();
+	GRadixTree(const GRadixTree&) = delete;
+	GRadixTree& operator=(const GRadixTree&) = delete;
+	~GRadixTree();
+	
+	RadixLeaf* FindLeaf(StringView key) const;
+	// Links the leaf into the tree, or returns the leaf that already has its key
+	RadixLeaf* InsertLeaf(RadixLeaf* leaf);
+	// Unlinks and returns the leaf with the key, or returns nullptr
+	RadixLeaf* RemoveLeaf(StringView key);
+	// Calls visit for every leaf whose key starts with prefix, in key order
+	void VisitLeaves(StringView prefix, void(*visit)(RadixLeaf*, void*), void* context) const;
+	// Frees every node, the leaves are left to the caller
+	void FreeNodes();
+	
+private:
+	RadixNode* AllocateNode(ERadixNodeType type);
+	void FreeNode(RadixNode* node);
+	void FreeNodeRecursive(void* child);
+	
+	// Adds a child, growing the node and updating nodeRef if it is full
+	void AddChild(void** nodeRef, RadixNode* node, uint8 byte, void* child);
+	void RemoveChild(void** nodeRef, RadixNode* node, uint8 byte);
+	// Replaces a node with one child and no terminal by that child
+	void Collapse(void** nodeRef, RadixNode* node);
+	void ResizeNode(void** nodeRef, RadixNode* node, ERadixNodeType type);
+	
+	void* Root;
+	uint32 NumLeaves;
+	Pool<RadixNode4> Node4Pool;
+	Pool<RadixNode16> Node16Pool;
+	Pool<RadixNode48> Node48Pool;
+	Pool<RadixNode256> Node256Pool;
+};
+
+// An adaptive radix tree mapping StringView keys to values. Inner nodes
+// have room for 4, 16, 48 or 256 children and grow or shrink between
+// those sizes, and chains of single children are compressed into node
+// prefixes. Keys are visited in byte order, and every key starting with
+// a prefix can be visited without looking at any other key.
+// The tree doesn't copy the keys, they need to outlive it, for example
+// by living in a StringPool.
+template<typename TValue>
+class RadixTree : public GRadixTree {
+public:
+	RadixTree() = default;
+	~RadixTree();
+	
+	TValue& Add(StringView key);
+	TValue& FindOrAdd(StringView key);
+	TValue* Find(StringView key);
+	const TValue* Find(StringView key) const;
+	TValue& FindChecked(StringView key);
+	const TValue& FindChecked(StringView key) const;
+	bool Contains(StringView key) const;
+	// Returns false if the key wasn't in the tree
+	bool Remove(StringView key);
+	void Clear();
+	
+	// Calls f(StringView key, TValue& value) for every key in byte order
+	template<typename F>
+	void ForEach(const F& f);
+	template<typename F>
+	void ForEach(const F& f) const;
+	// Calls f(StringView key, TValue& value) for every key starting with
+	// prefix in byte order
+	template<typename F>
+	void ForEachWithPrefix(StringView prefix, const F& f);
+	template<typename F>
+	void ForEachWithPrefix(StringView prefix, const F& f) const;
+	
+protected:
+	struct Leaf : public RadixLeaf {
+		TValue Value;
+	};
+	
+	template<typename V, typename F>
+	static void Visit(RadixLeaf* leaf, void* context);
+	
+	Pool<Leaf> LeafPool;
+};
+
+template<typename TValue>
+RadixTree<TValue>::~RadixTree()
+{
+	Clear();
+}
+
+template<typename TValue>
+TValue& RadixTree<TValue>::Add(StringView key)
+{
+	return FindOrAdd(key);
+}
+
+template<typename TValue>
+TValue& RadixTree<TValue>::FindOrAdd(StringView key)
+{
+	Leaf* leaf = static_cast<Leaf*>(FindLeaf(key));
+	if (leaf != nullptr) {
+		return leaf->Value;
+	}
+	leaf = Memory::PlacementNew<Leaf>(LeafPool.Allocate());
+	leaf->Key = key;
+	InsertLeaf(leaf);
+	return leaf->Value;
+}
+
+template<typename TValue>
+TValue* RadixTree<TValue>::Find(StringView key)
+{
+	Leaf* leaf = static_cast<Leaf*>(FindLeaf(key));
+	return leaf != nullptr ? &leaf->Value : nullptr;
+}
+
+template<typename TValue>
+const TValue* RadixTree<TValue>::Find(StringView key) const
+{
+	const Leaf* leaf = static_cast<const Leaf*>(FindLeaf(key));
+	return leaf != nullptr ? &leaf->Value : nullptr;
+}
+
+template<typename TValue>
+TValue& RadixTree<TValue>::FindChecked(StringView key)
+{
+	TValue* value = Find(key);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<typename TValue>
+const TValue& RadixTree<TValue>::FindChecked(StringView key) const
+{
+	const TValue* value = Find(key);
+	CHECK(value != nullptr);
+	return *value;
+}
+
+template<typename TValue>
+bool RadixTree<TValue>::Contains(StringView key) const
+{
+	return FindLeaf(key) != nullptr;
+}
+
+template<typename TValue>
+bool RadixTree<TValue>::Remove(StringView key)
+{
+	Leaf* leaf = static_cast<Leaf*>(RemoveLeaf(key));
+	if (leaf == nullptr) {
+		return false;
+	}
+	leaf->~Leaf();
+	LeafPool.Free(leaf);
+	return true;
+}
+
+template<typename TValue>
+void RadixTree<TValue>::Clear()
+{
+	VisitLeaves(StringView(), [](RadixLeaf* leaf, void* context) {
+		static_cast<Leaf*>(leaf)->~Leaf();
+		static_cast<Pool<Leaf>*>(context)->Free(static_cast<Leaf*>(leaf));
+	}, &LeafPool);
+	FreeNodes();
+}
+
+template<typename TValue>
+template<typename F>
+void RadixTree<TValue>::ForEach(const F& f)
+{
+	VisitLeaves(StringView(), &Visit<TValue, F>, const_cast<F*>(&f));
+}
+
+template<typename TValue>
+template<typename F>
+void RadixTree<TValue>::ForEach(const F& f) const
+{
+	VisitLeaves(StringView(), &Visit<const TValue, F>, const_cast<F*>(&f));
+}
+
+template<typename TValue>
+template<typename F>
+void RadixTree<TValue>::ForEachWithPrefix(StringView prefix, const F& f)
+{
+	VisitLeaves(prefix, &Visit<TValue, F>, const_cast<F*>(&f));
+}
+
+template<typename TValue>
+template<typename F>
+void RadixTree<TValue>::ForEachWithPrefix(StringView prefix, const F& f) const
+{
+	VisitLeaves(prefix, &Visit<const TValue, F>, const_cast<F*>(&f));
+}
+
+template<typename TValue>
+template<typename V, typename F>
+void RadixTree<TValue>::Visit(RadixLeaf* leaf, void* context)
+{
+	V& value = static_cast<Leaf*>(leaf)->Value;
+	(*static_cast<const F*>(context))(leaf->Key, value);
+}
\ No newline at end of file
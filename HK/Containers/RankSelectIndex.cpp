@@ -0,0 +1,155 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/RankSelectIndex.h"
+
+#include "Common/Math.h"
+
+static constexpr uint32 WordsPerBlock = RankSelectIndex::BlockBits / 64;
+static constexpr uint32 WordsPerSubBlock = RankSelectIndex::SubBlockBits / 64;
+
+static uint32 GetSubBlockCount(uint64 entry, uint32 subBlock)
+{
+	return uint32(entry >> (32 + 10 * subBlock)) & 0x3FF;
+}
+
+// The position of the rank-th set bit of word
+static uint32 SelectInWord(uint64 word, uint32 rank)
+{
+	uint32 shift = 0;
+	while (true) {
+		const uint32 count = Math::PopCount((word >> shift) & 0xFF);
+		if (rank < count) {
+			break;
+		}
+		rank -= count;
+		shift += 8;
+	}
+	word >>= shift;
+	for (; rank > 0; --rank) {
+		word &= word - 1;
+	}
+	return shift + Math::CountTrailingZeros(word);
+}
+
+RankSelectIndex::RankSelectIndex()
+	: Bits(nullptr)
+	, NumSetBits(0)
+{
+}
+
+RankSelectIndex::RankSelectIndex(const BitArray& bits)
+	: RankSelectIndex()
+{
+	Build(bits);
+}
+
+void RankSelectIndex::Build(const BitArray& bits)
+{
+	Bits = &bits;
+	Blocks.Reset();
+	SelectSamples.Reset();
+	
+	const uint64* words = bits.GetWords();
+	const uint32 numWords = bits.GetWordCount();
+	const uint32 numBlocks = (numWords + WordsPerBlock - 1) / WordsPerBlock;
+	Blocks.Reserve(numBlocks + 1);
+	
+	uint32 total = 0;
+	for (uint32 block = 0; block < numBlocks; ++block) {
+		uint64 entry = total;
+		uint32 blockCount = 0;
+		for (uint32 sub = 0; sub < 4; ++sub) {
+			uint32 subCount = 0;
+			const uint32 first = block * WordsPerBlock + sub * WordsPerSubBlock;
+			for (uint32 w = first; w < first + WordsPerSubBlock && w < numWords; ++w) {
+				subCount += Math::PopCount(words[w]);
+			}
+			if (sub < 3) {
+				entry |= uint64(subCount) << (32 + 10 * sub);
+			}
+			blockCount += subCount;
+		}
+		
+		while (SelectSamples.Num() * uint64(SelectSampleRate) < uint64(total) + blockCount) {
+			SelectSamples.Add(block);
+		}
+		Blocks.Add(entry);
+		total += blockCount;
+	}
+	Blocks.Add(total);
+	NumSetBits = total;
+}
+
+uint32 RankSelectIndex::Rank(uint32 index) const
+{
+	CHECK(Bits != nullptr && index <= Bits->GetBitCount());
+	const uint64* words = Bits->GetWords();
+	const uint64 entry = Blocks[index / BlockBits];
+	
+	uint32 rank = uint32(entry);
+	const uint32 subBlock = (index / SubBlockBits) % 4;
+	for (uint32 sub = 0; sub < subBlock; ++sub) {
+		rank += GetSubBlockCount(entry, sub);
+	}
+	
+	const uint32 lastWord = index / 64;
+	for (uint32 w = index / SubBlockBits * WordsPerSubBlock; w < lastWord; ++w) {
+		rank += Math::PopCount(words[w]);
+	}
+	if (index % 64 != 0) {
+		rank += Math::PopCount(words[lastWord] & ((uint64(1) << (index % 64)) - 1));
+	}
+	return rank;
+}
+
+uint32 RankSelectIndex::Select(uint32 k) const
+{
+	CHECK(k < NumSetBits);
+	const uint64* words = Bits->GetWords();
+	
+	// Find the last block with at most k set bits before it
+	const uint32 sample = k / SelectSampleRate;
+	uint32 low = SelectSamples[sample];
+	uint32 high = sample + 1 < SelectSamples.Num() ? SelectSamples[sample + 1] + 1 : Blocks.Num() - 1;
+	while (high - low > 1) {
+		const uint32 mid = (low + high) / 2;
+		if (uint32(Blocks[mid]) <= k) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+	
+	const uint64 entry = Blocks[low];
+	uint32 remaining = k - uint32(entry);
+	uint32 word = low * WordsPerBlock;
+	for (uint32 sub = 0; sub < 3; ++sub) {
+		const uint32 count = GetSubBlockCount(entry, sub);
+		if (remaining < count) {
+			break;
+		}
+		remaining -= count;
+		word += WordsPerSubBlock;
+	}
+	
+	while (true) {
+		const uint32 count = Math::PopCount(words[word]);
+		if (remaining < count) {
+			break;
+		}
+		remaining -= count;
+		++word;
+	}
+	return word * 64 + SelectInWord(words[word], remaining);
+}
+
+uint32 RankSelectIndex::GetNumSetBits() const
+{
+	return NumSetBits;
+}
+
+uint64 RankSelectIndex::GetNumBytes() const
+{
+	return sizeof(uint64) * uint64(Blocks.Num()) + sizeof(uint32) * uint64(SelectSamples.Num());
+}
\ No newline at end of file
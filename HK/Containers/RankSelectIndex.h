@@ -0,0 +1,47 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Containers/BitArray.h"
+
+// Answers rank (set bits before a position) and select (position of
+// the k-th set bit) over a BitArray in constant time.
+// Every 2048 bit block has one uint64 holding the set bits before it
+// and the counts of its first three 512 bit sub-blocks, so a rank reads
+// that entry and popcounts at most eight words. Select samples the
+// block of every 8192nd set bit and searches between samples.
+// Together that takes a little over 3% of the size of the bits.
+// The index refers to the BitArray, which must not change or move
+// while the index is used.
+class RankSelectIndex {
+public:
+	static constexpr uint32 BlockBits = 2048;
+	static constexpr uint32 SubBlockBits = 512;
+	static constexpr uint32 SelectSampleRate = 8192;
+	
+	RankSelectIndex();
+	RankSelectIndex(const BitArray& bits);
+	
+	void Build(const BitArray& bits);
+	
+	// The number of set bits before index, index may be the bit count
+	uint32 Rank(uint32 index) const;
+	// The position of the k-th set bit counting from 0, k must be
+	// smaller than GetNumSetBits.
+	uint32 Select(uint32 k) const;
+	
+	uint32 GetNumSetBits() const;
+	// The memory used by the index, not counting the bits
+	uint64 GetNumBytes() const;
+	
+private:
+	const BitArray* Bits;
+	// The set bits before every block in the low 32 bits and the counts
+	// of its first three sub-blocks in 10 bits each above that, with
+	// one extra entry past the end.
+	Array<uint64> Blocks;
+	// The block holding every SelectSampleRate-th set bit
+	Array<uint32> SelectSamples;
+	uint32 NumSetBits;
+};
\ No newline at end of file
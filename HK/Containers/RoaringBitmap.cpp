@@ -0,0 +1,895 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/RoaringBitmap.h"
+
+#include "File/File.h"
+
+// SSE2 is part of every x86-64 CPU, MSVC doesn't define __SSE2__ there
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ROARING_SSE2 1
+#else
+#define ROARING_SSE2 0
+#endif
+
+static constexpr uint32 RoaringBitmapMagic = 0x42524B48; // "HKRB"
+static constexpr uint32 BitmapWords = RoaringBitmap::BitmapWords;
+static constexpr uint32 MaxArrayCardinality = RoaringBitmap::MaxArrayCardinality;
+
+struct RoaringBitmapFileHeader {
+	uint32 Magic;
+	uint32 NumContainers;
+};
+
+struct RoaringContainerFileHeader {
+	uint16 Key;
+	uint8 Type;
+	uint8 Padding;
+	uint32 Cardinality;
+	// The number of uint16 values or uint64 words that follow
+	uint32 NumElements;
+};
+
+enum class ERoaringOp
+{
+	Or,
+	And,
+	AndNot,
+};
+
+static bool TestBit(const uint64* words, uint32 bit)
+{
+	return (words[bit / 64] & (uint64(1) << (bit % 64))) != 0;
+}
+
+// Returns the index of the first of the sorted values not below value
+static uint32 LowerBound(const uint16* values, uint32 num, uint16 value)
+{
+	// Branchless, the loop only depends on num
+	const uint16* base = values;
+	while (num > 1) {
+		const uint32 half = num / 2;
+		base += (base[half - 1] < value) * half;
+		num -= half;
+	}
+	return uint32(base - values) + (num == 1 && *base < value ? 1 : 0);
+}
+
+static uint32 CountBits(const uint64* words)
+{
+	uint32 count = 0;
+	for (uint32 i = 0; i < BitmapWords; ++i) {
+		count += Math::PopCount(words[i]);
+	}
+	return count;
+}
+
+static void SetRun(uint64* words, uint32 start, uint32 end)
+{
+	// Sets the bits [start, end]
+	const uint32 first = start / 64;
+	const uint32 last = end / 64;
+	const uint64 firstMask = ~uint64(0) << (start % 64);
+	const uint64 lastMask = ~uint64(0) >> (63 - end % 64);
+	if (first == last) {
+		words[first] |= firstMask & lastMask;
+		return;
+	}
+	words[first] |= firstMask;
+	for (uint32 i = first + 1; i < last; ++i) {
+		words[i] = ~uint64(0);
+	}
+	words[last] |= lastMask;
+}
+
+static void MakeBitmap(RoaringContainer& container)
+{
+	if (container.Type == ERoaringContainerType::Bitmap) {
+		return;
+	}
+	Array<uint64> words(BitmapWords);
+	uint64* data = words.AddUninitialized(BitmapWords);
+	Memory::FillZero(data, sizeof(uint64) * BitmapWords);
+	if (container.Type == ERoaringContainerType::Array) {
+		for (uint16 value : container.Values) {
+			data[value / 64] |= uint64(1) << (value % 64);
+		}
+	} else {
+		for (uint32 r = 0; r < container.Values.Num(); r += 2) {
+			SetRun(data, container.Values[r], container.Values[r] + container.Values[r + 1]);
+		}
+	}
+	container.Type = ERoaringContainerType::Bitmap;
+	container.Values = Array<uint16>();
+	container.Words = Move(words);
+}
+
+static void MakeArray(RoaringContainer& container)
+{
+	if (container.Type == ERoaringContainerType::Array) {
+		return;
+	}
+	CHECK(container.Cardinality <= MaxArrayCardinality);
+	Array<uint16> values(container.Cardinality);
+	if (container.Type == ERoaringContainerType::Bitmap) {
+		for (uint32 w = 0; w < BitmapWords; ++w) {
+			uint64 word = container.Words[w];
+			while (word != 0) {
+				values.Add(uint16(w * 64 + Math::CountTrailingZeros(word)));
+				word &= word - 1;
+			}
+		}
+	} else {
+		for (uint32 r = 0; r < container.Values.Num(); r += 2) {
+			const uint32 start = container.Values[r];
+			const uint32 end = start + container.Values[r + 1];
+			for (uint32 value = start; value <= end; ++value) {
+				values.Add(uint16(value));
+			}
+		}
+	}
+	container.Type = ERoaringContainerType::Array;
+	container.Values = Move(values);
+	container.Words = Array<uint64>();
+}
+
+// Picks the array or bitmap representation for the cardinality
+static void Normalize(RoaringContainer& container)
+{
+	if (container.Cardinality > MaxArrayCardinality) {
+		MakeBitmap(container);
+	} else {
+		MakeArray(container);
+	}
+}
+
+// Returns a container that isn't a run container, using scratch if
+// the container has to be converted
+static const RoaringContainer& Materialize(const RoaringContainer& container, RoaringContainer& scratch)
+{
+	if (container.Type != ERoaringContainerType::Run) {
+		return container;
+	}
+	scratch = container;
+	Normalize(scratch);
+	return scratch;
+}
+
+static uint32 CountRuns(const RoaringContainer& container)
+{
+	if (container.Type == ERoaringContainerType::Run) {
+		return container.Values.Num() / 2;
+	}
+	uint32 runs = 0;
+	if (container.Type == ERoaringContainerType::Array) {
+		for (uint32 i = 0; i < container.Values.Num(); ++i) {
+			if (i == 0 || container.Values[i] != container.Values[i - 1] + 1) {
+				++runs;
+			}
+		}
+		return runs;
+	}
+	// Every run starts at a set bit whose lower neighbour is clear
+	uint64 carry = 0;
+	for (uint32 w = 0; w < BitmapWords; ++w) {
+		const uint64 word = container.Words[w];
+		runs += Math::PopCount(word & ~((word << 1) | carry));
+		carry = word >> 63;
+	}
+	return runs;
+}
+
+static void MakeRun(RoaringContainer& container)
+{
+	if (container.Type == ERoaringContainerType::Run) {
+		return;
+	}
+	Array<uint16> runs(CountRuns(container) * 2);
+	const uint32 cardinality = container.Cardinality;
+	uint32 start = 0;
+	uint32 previous = 0;
+	bool bInRun = false;
+	auto addValue = [&](uint32 value) {
+		if (bInRun && value == previous + 1) {
+			previous = value;
+			return;
+		}
+		if (bInRun) {
+			runs.Add(uint16(start));
+			runs.Add(uint16(previous - start));
+		}
+		start = previous = value;
+		bInRun = true;
+	};
+	if (container.Type == ERoaringContainerType::Array) {
+		for (uint16 value : container.Values) {
+			addValue(value);
+		}
+	} else {
+		for (uint32 w = 0; w < BitmapWords; ++w) {
+			uint64 word = container.Words[w];
+			while (word != 0) {
+				addValue(w * 64 + Math::CountTrailingZeros(word));
+				word &= word - 1;
+			}
+		}
+	}
+	if (bInRun) {
+		runs.Add(uint16(start));
+		runs.Add(uint16(previous - start));
+	}
+	container.Type = ERoaringContainerType::Run;
+	container.Cardinality = cardinality;
+	container.Values = Move(runs);
+	container.Words = Array<uint64>();
+}
+
+static uint64 GetContainerBytes(const RoaringContainer& container)
+{
+	return sizeof(uint16) * uint64(container.Values.Num()) + sizeof(uint64) * uint64(container.Words.Num());
+}
+
+static bool ContainerContains(const RoaringContainer& container, uint16 value)
+{
+	if (container.Type == ERoaringContainerType::Bitmap) {
+		return TestBit(container.Words.GetData(), value);
+	}
+	if (container.Type == ERoaringContainerType::Array) {
+		const uint32 index = LowerBound(container.Values.GetData(), container.Values.Num(), value);
+		return index < container.Values.Num() && container.Values[index] == value;
+	}
+	// Find the last run starting at or before value
+	uint32 begin = 0;
+	uint32 end = container.Values.Num() / 2;
+	while (begin < end) {
+		const uint32 mid = (begin + end) / 2;
+		if (container.Values[mid * 2] <= value) {
+			begin = mid + 1;
+		} else {
+			end = mid;
+		}
+	}
+	if (begin == 0) {
+		return false;
+	}
+	const uint32 run = (begin - 1) * 2;
+	return uint32(value) - container.Values[run] <= container.Values[run + 1];
+}
+
+static void BitmapOp(RoaringContainer& result, const RoaringContainer& a, const RoaringContainer& b, ERoaringOp op)
+{
+	// Plain word loops over restrict pointers, the compiler vectorizes these
+	uint64* RESTRICT(out) = result.Words.AddUninitialized(BitmapWords);
+	const uint64* RESTRICT(x) = a.Words.GetData();
+	const uint64* RESTRICT(y) = b.Words.GetData();
+	if (op == ERoaringOp::Or) {
+		for (uint32 i = 0; i < BitmapWords; ++i) {
+			out[i] = x[i] | y[i];
+		}
+	} else if (op == ERoaringOp::And) {
+		for (uint32 i = 0; i < BitmapWords; ++i) {
+			out[i] = x[i] & y[i];
+		}
+	} else {
+		for (uint32 i = 0; i < BitmapWords; ++i) {
+			out[i] = x[i] & ~y[i];
+		}
+	}
+	result.Type = ERoaringContainerType::Bitmap;
+	result.Cardinality = CountBits(out);
+}
+
+// Returns the index of the first value not below value, searching from
+// first with steps that double until they pass it
+static uint32 Gallop(const uint16* values, uint32 num, uint32 first, uint16 value)
+{
+	uint32 step = 1;
+	uint32 low = first;
+	while (low + step < num && values[low + step] < value) {
+		low += step;
+		step *= 2;
+	}
+	const uint32 high = Math::Min(low + step + 1, num);
+	return low + LowerBound(values + low, high - low, value);
+}
+
+// Intersects by searching every value of the smaller array in the
+// larger one, for arrays of very different sizes
+static uint32 IntersectGallop(const uint16* small, uint32 numSmall, const uint16* large, uint32 numLarge, uint16* out)
+{
+	uint32 num = 0;
+	uint32 j = 0;
+	for (uint32 i = 0; i < numSmall && j < numLarge; ++i) {
+		j = Gallop(large, numLarge, j, small[i]);
+		if (j < numLarge && large[j] == small[i]) {
+			out[num++] = small[i];
+		}
+	}
+	return num;
+}
+
+static uint32 IntersectMerge(const uint16* x, uint32 numX, const uint16* y, uint32 numY, uint32 i, uint32 j, uint16* out, uint32 num)
+{
+	while (i < numX && j < numY) {
+		if (x[i] < y[j]) {
+			++i;
+		} else if (y[j] < x[i]) {
+			++j;
+		} else {
+			out[num++] = x[i];
+			++i;
+			++j;
+		}
+	}
+	return num;
+}
+
+#if ROARING_SSE2
+template<int Lanes>
+static __m128i RotateLanes(__m128i v)
+{
+	return _mm_or_si128(_mm_srli_si128(v, Lanes * 2), _mm_slli_si128(v, 16 - Lanes * 2));
+}
+
+// Compares blocks of 8 values of both arrays, every value of one block
+// against every rotation of the other, and advances the block with the
+// smaller last value. A value can only match inside the blocks it is
+// compared with, since both arrays are sorted and have no duplicates.
+static uint32 IntersectSse2(const uint16* x, uint32 numX, const uint16* y, uint32 numY, uint16* out)
+{
+	uint32 i = 0;
+	uint32 j = 0;
+	uint32 num = 0;
+	while (i + 8 <= numX && j + 8 <= numY) {
+		const __m128i a = _mm_loadu_si128((const __m128i*)(x + i));
+		const __m128i b = _mm_loadu_si128((const __m128i*)(y + j));
+		__m128i matches = _mm_cmpeq_epi16(a, b);
+		matches = _mm_or_si128(matches, _mm_cmpeq_epi16(a, RotateLanes<1>(b)));
+		matches = _mm_or_si128(matches, _mm_cmpeq_epi16(a, RotateLanes<2>(b)));
+		matches = _mm_or_si128(matches, _mm_cmpeq_epi16(a, RotateLanes<3>(b)));
+		matches = _mm_or_si128(matches, _mm_cmpeq_epi16(a, RotateLanes<4>(b)));
+		matches = _mm_or_si128(matches, _mm_cmpeq_epi16(a, RotateLanes<5>(b)));
+		matches = _mm_or_si128(matches, _mm_cmpeq_epi16(a, RotateLanes<6>(b)));
+		matches = _mm_or_si128(matches, _mm_cmpeq_epi16(a, RotateLanes<7>(b)));
+		// Two mask bits per lane
+		uint32 mask = uint32(_mm_movemask_epi8(matches)) & 0x5555;
+		while (mask != 0) {
+			out[num++] = x[i + Math::CountTrailingZeros(mask) / 2];
+			mask &= mask - 1;
+		}
+		const uint16 lastX = x[i + 7];
+		const uint16 lastY = y[j + 7];
+		i += lastX <= lastY ? 8 : 0;
+		j += lastY <= lastX ? 8 : 0;
+	}
+	return IntersectMerge(x, numX, y, numY, i, j, out, num);
+}
+#endif
+
+// Arrays this many times larger than the other are galloped through
+static constexpr uint32 GallopRatio = 32;
+
+static uint32 IntersectArrays(const uint16* x, uint32 numX, const uint16* y, uint32 numY, uint16* out)
+{
+	if (uint64(numX) * GallopRatio < numY) {
+		return IntersectGallop(x, numX, y, numY, out);
+	}
+	if (uint64(numY) * GallopRatio < numX) {
+		return IntersectGallop(y, numY, x, numX, out);
+	}
+#if ROARING_SSE2
+	return IntersectSse2(x, numX, y, numY, out);
+#else
+	return IntersectMerge(x, numX, y, numY, 0, 0, out, 0);
+#endif
+}
+
+// The values of x that aren't in y, galloping through a much larger y
+static uint32 SubtractArrays(const uint16* x, uint32 numX, const uint16* y, uint32 numY, uint16* out)
+{
+	const bool bGallop = uint64(numX) * GallopRatio < numY;
+	uint32 num = 0;
+	uint32 j = 0;
+	for (uint32 i = 0; i < numX; ++i) {
+		if (bGallop) {
+			j = Gallop(y, numY, j, x[i]);
+		} else {
+			while (j < numY && y[j] < x[i]) {
+				++j;
+			}
+		}
+		if (j == numY || y[j] != x[i]) {
+			out[num++] = x[i];
+		}
+	}
+	return num;
+}
+
+static uint32 UniteArrays(const uint16* x, uint32 numX, const uint16* y, uint32 numY, uint16* out)
+{
+	uint32 i = 0;
+	uint32 j = 0;
+	uint32 num = 0;
+	while (i < numX && j < numY) {
+		const uint16 a = x[i];
+		const uint16 b = y[j];
+		out[num++] = a < b ? a : b;
+		i += a <= b ? 1 : 0;
+		j += b <= a ? 1 : 0;
+	}
+	while (i < numX) {
+		out[num++] = x[i++];
+	}
+	while (j < numY) {
+		out[num++] = y[j++];
+	}
+	return num;
+}
+
+static void ArrayOp(RoaringContainer& result, const RoaringContainer& a, const RoaringContainer& b, ERoaringOp op)
+{
+	const uint32 numA = a.Values.Num();
+	const uint32 numB = b.Values.Num();
+	const uint32 maxResult = op == ERoaringOp::Or ? numA + numB : numA;
+	uint16* out = result.Values.AddUninitialized(maxResult);
+	const uint16* x = a.Values.GetData();
+	const uint16* y = b.Values.GetData();
+	uint32 num;
+	if (op == ERoaringOp::Or) {
+		num = UniteArrays(x, numA, y, numB, out);
+	} else if (op == ERoaringOp::And) {
+		num = IntersectArrays(x, numA, y, numB, out);
+	} else {
+		num = SubtractArrays(x, numA, y, numB, out);
+	}
+	
+	result.Type = ERoaringContainerType::Array;
+	result.Cardinality = num;
+	if (num < maxResult) {
+		Array<uint16> values(num);
+		Memory::Copy(out, values.AddUninitialized(num), sizeof(uint16) * num);
+		result.Values = Move(values);
+	}
+}
+
+// Mixed array and bitmap operands
+static void MixedOp(RoaringContainer& result, const RoaringContainer& a, const RoaringContainer& b, ERoaringOp op)
+{
+	const bool bArrayFirst = a.Type == ERoaringContainerType::Array;
+	const RoaringContainer& array = bArrayFirst ? a : b;
+	const RoaringContainer& bitmap = bArrayFirst ? b : a;
+	
+	if (op == ERoaringOp::Or || (op == ERoaringOp::AndNot && !bArrayFirst)) {
+		result.Type = ERoaringContainerType::Bitmap;
+		result.Words = bitmap.Words;
+		uint64* words = result.Words.GetData();
+		uint32 cardinality = bitmap.Cardinality;
+		for (uint16 value : array.Values) {
+			const uint64 bit = uint64(1) << (value % 64);
+			const uint64 old = words[value / 64];
+			if (op == ERoaringOp::Or) {
+				words[value / 64] = old | bit;
+				cardinality += (old & bit) == 0 ? 1 : 0;
+			} else {
+				words[value / 64] = old & ~bit;
+				cardinality -= (old & bit) != 0 ? 1 : 0;
+			}
+		}
+		result.Cardinality = cardinality;
+		return;
+	}
+	
+	// And, or the array minus the bitmap, both filter the array
+	const bool bKeep = op == ERoaringOp::And;
+	const uint64* words = bitmap.Words.GetData();
+	uint32 num = 0;
+	for (uint16 value : array.Values) {
+		num += TestBit(words, value) == bKeep ? 1 : 0;
+	}
+	result.Type = ERoaringContainerType::Array;
+	result.Cardinality = num;
+	result.Values = Array<uint16>(num);
+	for (uint16 value : array.Values) {
+		if (TestBit(words, value) == bKeep) {
+			result.Values.Add(value);
+		}
+	}
+}
+
+static void ContainerOp(RoaringContainer& result, const RoaringContainer& a, const RoaringContainer& b, ERoaringOp op)
+{
+	RoaringContainer scratchA;
+	RoaringContainer scratchB;
+	const RoaringContainer& x = Materialize(a, scratchA);
+	const RoaringContainer& y = Materialize(b, scratchB);
+	if (x.Type == ERoaringContainerType::Bitmap && y.Type == ERoaringContainerType::Bitmap) {
+		BitmapOp(result, x, y, op);
+	} else if (x.Type == ERoaringContainerType::Array && y.Type == ERoaringContainerType::Array) {
+		ArrayOp(result, x, y, op);
+	} else {
+		MixedOp(result, x, y, op);
+	}
+	Normalize(result);
+}
+
+// Checks a container read from a file, whose values must be what the
+// operations produce, and counts its values. Returns 0 when the values
+// are out of order or the container is empty.
+static uint32 CountLoadedValues(const RoaringContainer& container)
+{
+	const uint16* values = container.Values.GetData();
+	const uint32 num = container.Values.Num();
+	if (container.Type == ERoaringContainerType::Bitmap) {
+		return CountBits(container.Words.GetData());
+	}
+	if (container.Type == ERoaringContainerType::Array) {
+		if (num > MaxArrayCardinality) {
+			return 0;
+		}
+		for (uint32 i = 1; i < num; ++i) {
+			if (values[i] <= values[i - 1]) {
+				return 0;
+			}
+		}
+		return num;
+	}
+	uint32 cardinality = 0;
+	uint32 end = 0;
+	for (uint32 r = 0; r < num; r += 2) {
+		const uint32 start = values[r];
+		if ((r > 0 && start <= end) || start + values[r + 1] > 0xFFFF) {
+			return 0;
+		}
+		end = start + values[r + 1];
+		cardinality += values[r + 1] + 1;
+	}
+	return cardinality;
+}
+
+// Appends a container by moving it, Array::Add would copy it
+static void AddContainer(Array<uint16>& keys, Array<RoaringContainer>& containers, uint16 key, RoaringContainer&& container)
+{
+	keys.Add(key);
+	Memory::PlacementNew<RoaringContainer>(containers.AddUninitialized(1), Move(container));
+}
+
+RoaringBitmap::RoaringBitmap()
+{
+}
+
+RoaringBitmap::RoaringBitmap(const RoaringBitmap& other)
+	: Keys(other.Keys)
+{
+	// The array copy is bitwise, copy every container on its own
+	Containers.Reserve(other.Containers.Num());
+	for (const RoaringContainer& container : other.Containers) {
+		Memory::PlacementNew<RoaringContainer>(Containers.AddUninitialized(1), container);
+	}
+}
+
+RoaringBitmap::RoaringBitmap(RoaringBitmap&& other)
+	: Keys(Move(other.Keys))
+	, Containers(Move(other.Containers))
+{
+}
+
+RoaringBitmap::~RoaringBitmap()
+{
+}
+
+RoaringBitmap& RoaringBitmap::operator=(const RoaringBitmap& other)
+{
+	CHECK(this != &other);
+	Clear();
+	Keys = other.Keys;
+	Containers.Reserve(other.Containers.Num());
+	for (const RoaringContainer& container : other.Containers) {
+		Memory::PlacementNew<RoaringContainer>(Containers.AddUninitialized(1), container);
+	}
+	return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator=(RoaringBitmap&& other)
+{
+	CHECK(this != &other);
+	Keys = Move(other.Keys);
+	Containers = Move(other.Containers);
+	return *this;
+}
+
+bool RoaringBitmap::Add(uint32 value)
+{
+	const uint16 key = uint16(value >> 16);
+	const uint16 low = uint16(value);
+	bool bFound;
+	const uint32 index = FindContainer(key, bFound);
+	if (!bFound) {
+		RoaringContainer container;
+		container.Values.Add(low);
+		container.Cardinality = 1;
+		Keys.InsertAt(index, key);
+		Containers.InsertAt(index, Move(container));
+		return true;
+	}
+	
+	RoaringContainer& container = Containers[index];
+	if (container.Type == ERoaringContainerType::Run) {
+		if (ContainerContains(container, low)) {
+			return false;
+		}
+		Normalize(container);
+	}
+	if (container.Type == ERoaringContainerType::Bitmap) {
+		uint64& word = container.Words[low / 64];
+		const uint64 bit = uint64(1) << (low % 64);
+		if ((word & bit) != 0) {
+			return false;
+		}
+		word |= bit;
+		++container.Cardinality;
+		return true;
+	}
+	
+	const uint32 position = LowerBound(container.Values.GetData(), container.Values.Num(), low);
+	if (position < container.Values.Num() && container.Values[position] == low) {
+		return false;
+	}
+	container.Values.InsertAt(position, low);
+	++container.Cardinality;
+	if (container.Cardinality > MaxArrayCardinality) {
+		MakeBitmap(container);
+	}
+	return true;
+}
+
+bool RoaringBitmap::Remove(uint32 value)
+{
+	const uint16 key = uint16(value >> 16);
+	const uint16 low = uint16(value);
+	bool bFound;
+	const uint32 index = FindContainer(key, bFound);
+	if (!bFound) {
+		return false;
+	}
+	
+	RoaringContainer& container = Containers[index];
+	if (!ContainerContains(container, low)) {
+		return false;
+	}
+	if (container.Type == ERoaringContainerType::Run) {
+		Normalize(container);
+	}
+	--container.Cardinality;
+	if (container.Type == ERoaringContainerType::Bitmap) {
+		container.Words[low / 64] &= ~(uint64(1) << (low % 64));
+		if (container.Cardinality <= MaxArrayCardinality) {
+			MakeArray(container);
+		}
+	} else {
+		container.Values.RemoveAt(LowerBound(container.Values.GetData(), container.Values.Num(), low));
+	}
+	if (container.Cardinality == 0) {
+		Keys.RemoveAt(index);
+		Containers.RemoveAt(index);
+	}
+	return true;
+}
+
+bool RoaringBitmap::Contains(uint32 value) const
+{
+	bool bFound;
+	const uint32 index = FindContainer(uint16(value >> 16), bFound);
+	return bFound && ContainerContains(Containers[index], uint16(value));
+}
+
+void RoaringBitmap::Clear()
+{
+	Keys.Reset();
+	Containers.Reset();
+}
+
+void RoaringBitmap::Or(const RoaringBitmap& other)
+{
+	Array<uint16> keys(Keys.Num() + other.Keys.Num());
+	Array<RoaringContainer> containers(Keys.Num() + other.Keys.Num());
+	uint32 i = 0;
+	uint32 j = 0;
+	while (i < Keys.Num() || j < other.Keys.Num()) {
+		if (j == other.Keys.Num() || (i < Keys.Num() && Keys[i] < other.Keys[j])) {
+			AddContainer(keys, containers, Keys[i], Move(Containers[i]));
+			++i;
+		} else if (i == Keys.Num() || other.Keys[j] < Keys[i]) {
+			RoaringContainer copy = other.Containers[j];
+			AddContainer(keys, containers, other.Keys[j], Move(copy));
+			++j;
+		} else {
+			RoaringContainer result;
+			ContainerOp(result, Containers[i], other.Containers[j], ERoaringOp::Or);
+			AddContainer(keys, containers, Keys[i], Move(result));
+			++i;
+			++j;
+		}
+	}
+	Keys = Move(keys);
+	Containers = Move(containers);
+}
+
+void RoaringBitmap::And(const RoaringBitmap& other)
+{
+	Array<uint16> keys(Math::Min(Keys.Num(), other.Keys.Num()));
+	Array<RoaringContainer> containers(Math::Min(Keys.Num(), other.Keys.Num()));
+	uint32 i = 0;
+	uint32 j = 0;
+	while (i < Keys.Num() && j < other.Keys.Num()) {
+		if (Keys[i] < other.Keys[j]) {
+			++i;
+		} else if (other.Keys[j] < Keys[i]) {
+			++j;
+		} else {
+			RoaringContainer result;
+			ContainerOp(result, Containers[i], other.Containers[j], ERoaringOp::And);
+			if (result.Cardinality > 0) {
+				AddContainer(keys, containers, Keys[i], Move(result));
+			}
+			++i;
+			++j;
+		}
+	}
+	Keys = Move(keys);
+	Containers = Move(containers);
+}
+
+void RoaringBitmap::AndNot(const RoaringBitmap& other)
+{
+	Array<uint16> keys(Keys.Num());
+	Array<RoaringContainer> containers(Keys.Num());
+	uint32 j = 0;
+	for (uint32 i = 0; i < Keys.Num(); ++i) {
+		while (j < other.Keys.Num() && other.Keys[j] < Keys[i]) {
+			++j;
+		}
+		if (j == other.Keys.Num() || other.Keys[j] != Keys[i]) {
+			AddContainer(keys, containers, Keys[i], Move(Containers[i]));
+			continue;
+		}
+		RoaringContainer result;
+		ContainerOp(result, Containers[i], other.Containers[j], ERoaringOp::AndNot);
+		if (result.Cardinality > 0) {
+			AddContainer(keys, containers, Keys[i], Move(result));
+		}
+	}
+	Keys = Move(keys);
+	Containers = Move(containers);
+}
+
+void RoaringBitmap::Optimize()
+{
+	for (RoaringContainer& container : Containers) {
+		// A run costs two values, an array one per value and a bitmap 8 KiB
+		const uint64 runBytes = sizeof(uint16) * 2 * uint64(CountRuns(container));
+		const uint64 arrayBytes = container.Cardinality <= MaxArrayCardinality
+			? sizeof(uint16) * uint64(container.Cardinality) : Traits::Limits<uint64>::Max;
+		const uint64 bitmapBytes = sizeof(uint64) * BitmapWords;
+		if (runBytes < arrayBytes && runBytes < bitmapBytes) {
+			MakeRun(container);
+		} else {
+			Normalize(container);
+		}
+	}
+}
+
+uint64 RoaringBitmap::GetCardinality() const
+{
+	uint64 cardinality = 0;
+	for (const RoaringContainer& container : Containers) {
+		cardinality += container.Cardinality;
+	}
+	return cardinality;
+}
+
+bool RoaringBitmap::IsEmpty() const
+{
+	return Containers.Num() == 0;
+}
+
+uint64 RoaringBitmap::GetNumBytes() const
+{
+	uint64 numBytes = (sizeof(uint16) + sizeof(RoaringContainer)) * uint64(Containers.Num());
+	for (const RoaringContainer& container : Containers) {
+		numBytes += GetContainerBytes(container);
+	}
+	return numBytes;
+}
+
+void RoaringBitmap::ToArray(Array<uint32>& outValues) const
+{
+	outValues.Reserve(uint32(GetCardinality()));
+	ForEach([&outValues](uint32 value) {
+		outValues.Add(value);
+	});
+}
+
+void RoaringBitmap::Save(File& file) const
+{
+	RoaringBitmapFileHeader header;
+	header.Magic = RoaringBitmapMagic;
+	header.NumContainers = Containers.Num();
+	file.Write(&header, sizeof(header));
+	for (uint32 i = 0; i < Containers.Num(); ++i) {
+		const RoaringContainer& container = Containers[i];
+		RoaringContainerFileHeader containerHeader;
+		containerHeader.Key = Keys[i];
+		containerHeader.Type = uint8(container.Type);
+		containerHeader.Padding = 0;
+		containerHeader.Cardinality = container.Cardinality;
+		if (container.Type == ERoaringContainerType::Bitmap) {
+			containerHeader.NumElements = container.Words.Num();
+			file.Write(&containerHeader, sizeof(containerHeader));
+			file.Write(container.Words.GetData(), sizeof(uint64) * uint64(container.Words.Num()));
+		} else {
+			containerHeader.NumElements = container.Values.Num();
+			file.Write(&containerHeader, sizeof(containerHeader));
+			file.Write(container.Values.GetData(), sizeof(uint16) * uint64(container.Values.Num()));
+		}
+	}
+}
+
+bool RoaringBitmap::Load(File& file)
+{
+	RoaringBitmapFileHeader header;
+	if (file.Read(reinterpret_cast<uint8*>(&header), sizeof(header)) != sizeof(header) ||
+		header.Magic != RoaringBitmapMagic || header.NumContainers > 65536) {
+		return false;
+	}
+	
+	// Read into new arrays, so a bad file leaves the bitmap as it was
+	Array<uint16> keys(header.NumContainers);
+	Array<RoaringContainer> containers(header.NumContainers);
+	for (uint32 i = 0; i < header.NumContainers; ++i) {
+		RoaringContainerFileHeader containerHeader;
+		if (file.Read(reinterpret_cast<uint8*>(&containerHeader), sizeof(containerHeader)) != sizeof(containerHeader) ||
+			containerHeader.Type > uint8(ERoaringContainerType::Run) ||
+			(i > 0 && containerHeader.Key <= keys[i - 1])) {
+			return false;
+		}
+		
+		RoaringContainer container;
+		container.Type = ERoaringContainerType(containerHeader.Type);
+		uint64 numBytes;
+		uint64 numRead;
+		if (container.Type == ERoaringContainerType::Bitmap) {
+			if (containerHeader.NumElements != BitmapWords) {
+				return false;
+			}
+			numBytes = sizeof(uint64) * BitmapWords;
+			numRead = file.Read(reinterpret_cast<uint8*>(container.Words.AddUninitialized(BitmapWords)), numBytes);
+		} else {
+			if (containerHeader.NumElements > 65536 ||
+				(container.Type == ERoaringContainerType::Run && containerHeader.NumElements % 2 != 0)) {
+				return false;
+			}
+			numBytes = sizeof(uint16) * uint64(containerHeader.NumElements);
+			numRead = file.Read(reinterpret_cast<uint8*>(container.Values.AddUninitialized(containerHeader.NumElements)), numBytes);
+		}
+		if (numRead != numBytes) {
+			return false;
+		}
+		// The stored count must match the values
+		container.Cardinality = CountLoadedValues(container);
+		if (container.Cardinality == 0 || container.Cardinality != containerHeader.Cardinality) {
+			return false;
+		}
+		AddContainer(keys, containers, containerHeader.Key, Move(container));
+	}
+	Keys = Move(keys);
+	Containers = Move(containers);
+	return true;
+}
+
+uint32 RoaringBitmap::FindContainer(uint16 key, bool& bOutFound) const
+{
+	const uint32 index = LowerBound(Keys.GetData(), Keys.Num(), key);
+	bOutFound = index < Keys.Num() && Keys[index] == key;
+	return index;
+}
\ No newline at end of file
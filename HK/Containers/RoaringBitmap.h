@@ -0,0 +1,118 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Common/Math.h"
+
+class File;
+
+enum class ERoaringContainerType : uint8
+{
+	// Sorted values, for up to 4096 values
+	Array,
+	// 65536 bits in 1024 words
+	Bitmap,
+	// Sorted (start, length - 1) pairs
+	Run,
+};
+
+// The values of one RoaringBitmap chunk that share their upper 16 bits
+struct RoaringContainer {
+	ERoaringContainerType Type = ERoaringContainerType::Array;
+	uint32 Cardinality = 0;
+	// The array values or run pairs
+	Array<uint16> Values;
+	// The bitmap words
+	Array<uint64> Words;
+};
+
+// A compressed set of uint32 values. Values are split by their upper
+// 16 bits into containers, and every container picks the cheapest of
+// a sorted array, a 8 KiB bitmap or a list of runs for its values.
+// Sparse sets cost about two bytes per value, dense sets one bit, and
+// long runs almost nothing.
+// Adding and set operations keep arrays and bitmaps. Call Optimize to
+// turn containers into runs where that is smaller.
+class RoaringBitmap {
+public:
+	static constexpr uint32 MaxArrayCardinality = 4096;
+	static constexpr uint32 BitmapWords = 65536 / 64;
+	
+	RoaringBitmap();
+	RoaringBitmap(const RoaringBitmap& other);
+	RoaringBitmap(RoaringBitmap&& other);
+	~RoaringBitmap();
+	
+	RoaringBitmap& operator=(const RoaringBitmap& other);
+	RoaringBitmap& operator=(RoaringBitmap&& other);
+	
+	// Returns false if the value was already present
+	bool Add(uint32 value);
+	// Returns false if the value wasn't present
+	bool Remove(uint32 value);
+	bool Contains(uint32 value) const;
+	void Clear();
+	
+	// In place union, intersection and difference
+	void Or(const RoaringBitmap& other);
+	void And(const RoaringBitmap& other);
+	void AndNot(const RoaringBitmap& other);
+	
+	// Converts every container to its smallest representation
+	void Optimize();
+	
+	uint64 GetCardinality() const;
+	bool IsEmpty() const;
+	// The memory used by the containers
+	uint64 GetNumBytes() const;
+	
+	// Calls f(uint32 value) for every value in ascending order
+	template<typename F>
+	void ForEach(const F& f) const;
+	void ToArray(Array<uint32>& outValues) const;
+	
+	void Save(File& file) const;
+	// Returns false if the file doesn't hold a valid RoaringBitmap, which
+	// leaves this one as it was
+	bool Load(File& file);
+	
+protected:
+	// Returns the index of the container for key, or where to insert it
+	uint32 FindContainer(uint16 key, bool& bOutFound) const;
+	
+	// The upper 16 bits of every container, sorted
+	Array<uint16> Keys;
+	Array<RoaringContainer> Containers;
+};
+
+template<typename F>
+void RoaringBitmap::ForEach(const F& f) const
+{
+	for (uint32 i = 0; i < Containers.Num(); ++i) {
+		const uint32 high = uint32(Keys[i]) << 16;
+		const RoaringContainer& container = Containers[i];
+		if (container.Type == ERoaringContainerType::Array) {
+			for (uint16 value : container.Values) {
+				f(high | value);
+			}
+		} else if (container.Type == ERoaringContainerType::Bitmap) {
+			for (uint32 w = 0; w < BitmapWords; ++w) {
+				uint64 word = container.Words[w];
+				while (word != 0) {
+					f(high | (w * 64 + Math::CountTrailingZeros(word)));
+					word &= word - 1;
+				}
+			}
+		} else {
+			for (uint32 r = 0; r < container.Values.Num(); r += 2) {
+				const uint32 start = container.Values[r];
+				const uint32 end = start + container.Values[r + 1];
+				for (uint32 value = start; value <= end; ++value) {
+					f(high | value);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -4,8 +4,10 @@
 #pragma once
 
 #include "Array.h"
+#include "HashTableStats.h"
 #include "Util/Hasher.h"
 #include "Common/CompilerMacros.h"
+#include "Common/Math.h"
 #include "Allocators/Memory.h"
 
 template<typename T>
@@ -17,6 +19,11 @@ struct SetEntry {
 
 constexpr f32 SetMaxLoadFactor = 0.75f;
 
+// The number of keys FindBatch hashes and prefetches before it resolves
+// their probes. Large enough to overlap the cache misses, small enough
+// that the first prefetched buckets are not evicted before they are used.
+constexpr uint32 SetFindBatchSize = 16;
+
 template<typename T>
 class Set {
 public:
@@ -34,6 +41,11 @@ public:
 	bool Contains(const T& item) const;
 	bool Add(const T& item);
 	uint32 AddGetIndex(const T& item);
+	// Sizes the table once for all items, then inserts them ordered
+	// by their home slot so the writes walk the table front to back.
+	void AddRange(const ArrayView<T>& items);
+	// Grows the table so num more items can be added without a rehash.
+	void Reserve(uint32 num);
 	bool Remove(const T& item);
 	void Clear();
 	
@@ -41,11 +53,52 @@ public:
 	const T* Find(const T& item) const;
 	T& FindOrAdd(const T& item);
 	
+	// Finds all keys at once, writing a pointer to the found item or
+	// nullptr for every key into outItems. The home buckets of a batch
+	// are prefetched before any probe is resolved, which overlaps the
+	// cache misses on tables much larger than the cache.
+	void FindBatch(const ArrayView<T>& keys, Array<const T*>& outItems) const;
+	
 	void GetItems(Array<T>& items) const;
+	uint32 Num() const;
+	
+	// Calls f(item) for every item in the set, in table order.
+	template<typename F>
+	void ForEach(const F& f);
+	template<typename F>
+	void ForEach(const F& f) const;
+	
+#if HASH_TABLE_STATS
+	void GetStats(HashTableStats& outStats) const;
+#endif
 	
 protected:
 	int32 FindIndex(const T& item) const;
 	
+	// Probes for an item that compares equal to key, where key
+	// must hash identically to the item it matches.
+	template<typename K>
+	int32 FindIndexHashed(const K& key, uint32 hash) const;
+	
+	// Probes once for key, claiming the first free slot if it is
+	// not present. A claimed slot is marked as used, but its item
+	// is left unconstructed for the caller to placement new.
+	template<typename K>
+	uint32 FindOrClaimIndex(const K& key, uint32 hash, bool& bOutClaimed);
+	
+	// Probes all keys, calling onResolved(keyIndex, entryIndex) for each.
+	// Keys are hashed and their home buckets prefetched a batch ahead of
+	// resolving their probes.
+	template<typename K, typename F>
+	void FindIndexBatch(const K* keys, uint32 num, F&& onResolved) const;
+	
+	void RemoveAtIndex(uint32 index);
+	
+	template<typename K>
+	static uint32 HashOf(const K& key) {
+		return HasherType::Hash<uint32>(key);
+	}
+	
 private:
 	bool AddImpl(const T& item, uint32* outIndex);
 
@@ -57,6 +110,9 @@ protected:
 	SetEntry<T>* Entries;
 	uint32 Capacity;
 	uint32 NumEntries;
+#if HASH_TABLE_STATS
+	HashTableCounters Counters;
+#endif
 };
 
 template<typename T>
@@ -70,21 +126,20 @@ Set<T>::Set()
 template<typename T>
 Set<T>::Set(uint32 buffer)
 {
+	Entries = nullptr;
+	Capacity = 0;
+	NumEntries = 0;
 	if (buffer > 0) {
-		Entries = nullptr;
-		Capacity = 0;
-		NumEntries = 0;
 		Rehash(buffer);
 	}
-	else {
-		Set();
-	}
 }
 
 template<typename T>
 Set<T>::Set(const Set& copy)
 {
-	Set();
+	Entries = nullptr;
+	Capacity = 0;
+	NumEntries = 0;
 	if (copy.NumEntries > 0) {
 		Rehash(copy.Capacity);
 		NumEntries = copy.NumEntries;
@@ -167,28 +222,67 @@ uint32 Set<T>::AddGetIndex(const T& item)
 }
 
 template<typename T>
-bool Set<T>::Remove(const T& item)
+void Set<T>::AddRange(const ArrayView<T>& items)
 {
-	const uint32 hash = HasherType::Hash<uint32>(item);
-	uint32 index = hash % Capacity;
-	const uint32 startIndex = index;
-	do {
-		if (!Entries[index].IsUsed) {
-			return false;
-		}
-		if (Entries[index].Hash == hash && Entries[index].Item == item) {
-			Entries[index].Item.~T();
-			Entries[index].IsUsed = false;
-			--NumEntries;
-			CheckGap(index);
-			return true;
-		}
-		++index;
-		if (UNLIKELY(index == Capacity)) {
-			index = 0;
+	const uint32 num = items.Size();
+	if (UNLIKELY(num == 0)) {
+		return;
+	}
+	Reserve(num);
+	
+	// Counting sort the items on their home slot, using one bin per
+	// item. That orders the inserts to within a few slots without
+	// touching memory proportional to the capacity.
+	const uint32 numBins = Math::NextPowerOfTwo(num);
+	Array<uint32> hashes(num);
+	Array<uint32> binStart(numBins + 1);
+	Array<uint32> order(num);
+	hashes.AddUninitialized(num);
+	order.AddUninitialized(num);
+	Memory::FillZero(binStart.AddUninitialized(numBins + 1), sizeof(uint32) * (numBins + 1));
+	
+	const T* data = items.ConstData();
+	for (uint32 i = 0; i < num; ++i) {
+		hashes[i] = HashOf(data[i]);
+		const uint32 bin = uint32(uint64(hashes[i] % Capacity) * numBins / Capacity);
+		++binStart[bin + 1];
+	}
+	for (uint32 bin = 0; bin < numBins; ++bin) {
+		binStart[bin + 1] += binStart[bin];
+	}
+	for (uint32 i = 0; i < num; ++i) {
+		const uint32 bin = uint32(uint64(hashes[i] % Capacity) * numBins / Capacity);
+		order[binStart[bin]++] = i;
+	}
+	
+	for (uint32 i = 0; i < num; ++i) {
+		const uint32 itemIndex = order[i];
+		bool bClaimed = false;
+		const uint32 index = FindOrClaimIndex(data[itemIndex], hashes[itemIndex], bClaimed);
+		if (bClaimed) {
+			Memory::PlacementNew<T>(&Entries[index].Item, data[itemIndex]);
 		}
-	} while (index != startIndex);
-	return false;
+	}
+}
+
+template<typename T>
+void Set<T>::Reserve(uint32 num)
+{
+	const uint32 required = uint32((NumEntries + num) / SetMaxLoadFactor) + 1;
+	if (required > Capacity) {
+		Rehash(required);
+	}
+}
+
+template<typename T>
+bool Set<T>::Remove(const T& item)
+{
+	const int32 index = FindIndexHashed(item, HashOf(item));
+	if (index < 0) {
+		return false;
+	}
+	RemoveAtIndex(index);
+	return true;
 }
 
 template<typename T>
@@ -231,14 +325,20 @@ const T* Set<T>::Find(const T& item) const
 template<typename T>
 T& Set<T>::FindOrAdd(const T& item)
 {
-	T* found = Find(item);
-	if (!!found) {
-		return *found;
-	}
 	return Entries[AddGetIndex(item)].Item;
 }
 
 
+template<typename T>
+void Set<T>::FindBatch(const ArrayView<T>& keys, Array<const T*>& outItems) const
+{
+	outItems.Reset();
+	const T** out = outItems.AddUninitialized(keys.Size());
+	FindIndexBatch(keys.ConstData(), keys.Size(), [&](uint32 keyIndex, int32 index) {
+		out[keyIndex] = index >= 0 ? &Entries[index].Item : nullptr;
+	});
+}
+
 template<typename T>
 void Set<T>::GetItems(Array<T>& items) const
 {
@@ -257,20 +357,95 @@ void Set<T>::GetItems(Array<T>& items) const
 	}
 }
 
+template<typename T>
+uint32 Set<T>::Num() const
+{
+	return NumEntries;
+}
+
+template<typename T>
+template<typename F>
+void Set<T>::ForEach(const F& f)
+{
+	SetEntry<T>* entry = Entries;
+	uint32 count = NumEntries;
+	while (count > 0) {
+		--count;
+		while (!entry->IsUsed) {
+			++entry;
+		}
+		f(entry->Item);
+		++entry;
+	}
+}
+
+template<typename T>
+template<typename F>
+void Set<T>::ForEach(const F& f) const
+{
+	const SetEntry<T>* entry = Entries;
+	uint32 count = NumEntries;
+	while (count > 0) {
+		--count;
+		while (!entry->IsUsed) {
+			++entry;
+		}
+		f(entry->Item);
+		++entry;
+	}
+}
+
+#if HASH_TABLE_STATS
+template<typename T>
+void Set<T>::GetStats(HashTableStats& outStats) const
+{
+	outStats = HashTableStats();
+	outStats.NumEntries = NumEntries;
+	outStats.Capacity = Capacity;
+	outStats.Counters = Counters;
+	if (NumEntries == 0) {
+		return;
+	}
+	outStats.LoadFactor = f32(NumEntries) / f32(Capacity);
+	outStats.BytesPerEntry = f32(sizeof(SetEntry<T>) * Capacity) / f32(NumEntries);
+	
+	uint64 totalProbes = 0;
+	for (uint32 i = 0; i < Capacity; ++i) {
+		if (!Entries[i].IsUsed) {
+			continue;
+		}
+		const uint32 probeLength = (i - Entries[i].Hash % Capacity + Capacity) % Capacity + 1;
+		totalProbes += probeLength;
+		outStats.MaxProbeLength = Math::Max(outStats.MaxProbeLength, probeLength);
+		if (probeLength > 1) {
+			++outStats.NumDisplaced;
+		}
+		++outStats.ProbeLengthHistogram[Math::Min(probeLength, HashTableStats::HistogramSize) - 1];
+	}
+	outStats.AverageProbeLength = f32(f64(totalProbes) / f64(NumEntries));
+}
+#endif
+
 template<typename T>
 int32 Set<T>::FindIndex(const T& item) const
+{
+	return FindIndexHashed(item, HashOf(item));
+}
+
+template<typename T>
+template<typename K>
+int32 Set<T>::FindIndexHashed(const K& key, uint32 hash) const
 {
 	if (UNLIKELY(Entries == nullptr)) {
 		return -1;
 	}
-	const uint32 hash = HasherType::Hash<uint32>(item);
 	uint32 index = hash % Capacity;
 	const uint32 startIndex = index;
 	do {
 		if (!Entries[index].IsUsed) {
 			return -1;
 		}
-		if (Entries[index].Hash == hash && Entries[index].Item == item) {
+		if (Entries[index].Hash == hash && Entries[index].Item == key) {
 			return index;
 		}
 		++index;
@@ -282,32 +457,61 @@ int32 Set<T>::FindIndex(const T& item) const
 }
 
 template<typename T>
-bool Set<T>::AddImpl(const T& item, uint32* outIndex)
+template<typename K, typename F>
+void Set<T>::FindIndexBatch(const K* keys, uint32 num, F&& onResolved) const
+{
+	if (UNLIKELY(Entries == nullptr)) {
+		for (uint32 i = 0; i < num; ++i) {
+			onResolved(i, -1);
+		}
+		return;
+	}
+	
+	// Hashes live in a ring of two batches, so the next batch can be
+	// hashed and prefetched while the current one is being resolved.
+	constexpr uint32 ringSize = SetFindBatchSize * 2;
+	uint32 hashes[ringSize];
+	
+	const uint32 firstEnd = Math::Min(num, SetFindBatchSize);
+	for (uint32 i = 0; i < firstEnd; ++i) {
+		hashes[i] = HashOf(keys[i]);
+		PREFETCH_READ(&Entries[hashes[i] % Capacity]);
+	}
+	
+	for (uint32 offset = 0; offset < num; offset += SetFindBatchSize) {
+		const uint32 end = Math::Min(num, offset + SetFindBatchSize);
+		const uint32 nextEnd = Math::Min(num, end + SetFindBatchSize);
+		for (uint32 i = end; i < nextEnd; ++i) {
+			const uint32 hash = HashOf(keys[i]);
+			hashes[i % ringSize] = hash;
+			PREFETCH_READ(&Entries[hash % Capacity]);
+		}
+		for (uint32 i = offset; i < end; ++i) {
+			onResolved(i, FindIndexHashed(keys[i], hashes[i % ringSize]));
+		}
+	}
+}
+
+template<typename T>
+template<typename K>
+uint32 Set<T>::FindOrClaimIndex(const K& key, uint32 hash, bool& bOutClaimed)
 {
 	if (UNLIKELY(NumEntries >= SetMaxLoadFactor * Capacity)) {
 		Rehash(Capacity * 2);
 	}
-	const uint32 hash = HasherType::Hash<uint32>(item);
 	uint32 index = hash % Capacity;
 	const uint32 startIndex = index;
 	do {
 		if (!Entries[index].IsUsed) {
-			Entries[index].Item = item;
 			Entries[index].Hash = hash;
 			Entries[index].IsUsed = true;
 			++NumEntries;
-			if (outIndex)
-			{
-				*outIndex = index;
-			}
-			return true;
+			bOutClaimed = true;
+			return index;
 		}
-		if (Entries[index].Hash == hash && Entries[index].Item == item) {
-			if (outIndex)
-			{
-				*outIndex = index;
-			}
-			return false;
+		if (Entries[index].Hash == hash && Entries[index].Item == key) {
+			bOutClaimed = false;
+			return index;
 		}
 		++index;
 		if (UNLIKELY(index == Capacity)) {
@@ -315,7 +519,33 @@ bool Set<T>::AddImpl(const T& item, uint32* outIndex)
 		}
 	} while (index != startIndex);
 	CHECK(false);
-	return false;
+	bOutClaimed = false;
+	return 0;
+}
+
+template<typename T>
+void Set<T>::RemoveAtIndex(uint32 index)
+{
+	CHECK(index < Capacity && Entries[index].IsUsed);
+	Entries[index].Item.~T();
+	Entries[index].IsUsed = false;
+	--NumEntries;
+	CheckGap(index);
+}
+
+template<typename T>
+bool Set<T>::AddImpl(const T& item, uint32* outIndex)
+{
+	bool bClaimed = false;
+	const uint32 index = FindOrClaimIndex(item, HashOf(item), bClaimed);
+	if (bClaimed) {
+		Memory::PlacementNew<T>(&Entries[index].Item, item);
+	}
+	if (outIndex)
+	{
+		*outIndex = index;
+	}
+	return bClaimed;
 }
 
 template<typename T>
@@ -327,29 +557,45 @@ void Set<T>::Rehash(uint32 newCapacity)
 	if (UNLIKELY(newCapacity < NumEntries)) {
 		newCapacity = NumEntries;
 	}
+	// FixHole relies on the distance between two slots wrapping
+	// around like the hash does, which holds for powers of two.
+	newCapacity = Math::NextPowerOfTwo(newCapacity);
 	if (UNLIKELY(newCapacity == Capacity)) {
 		return;
 	}
 	
 	SetEntry<T>* oldEntries = Entries;
 	uint32 oldCapacity = Capacity;
-	uint32 oldNumEntries = NumEntries;
+#if HASH_TABLE_STATS
+	++Counters.NumRehashes;
+#endif
 	
 	uint64 bytesForEntries = sizeof(SetEntry<T>)*newCapacity;
 	Entries = static_cast<SetEntry<T>*>(Memory::Allocate(bytesForEntries));
 	Memory::FillZero(Entries, bytesForEntries);
 	Capacity = newCapacity;
-	NumEntries = 0;
 	
 	if (LIKELY(oldEntries != nullptr)) {
+		// Entries are unique and keep their stored hash, so each one
+		// only needs to find the first free slot from its home slot.
 		SetEntry<T>* oldEntry = &oldEntries[0];
-		uint32 count = oldNumEntries;
+		uint32 count = NumEntries;
 		while (count > 0) {
 			--count;
 			while (!oldEntry->IsUsed) {
 				++oldEntry;
 			}
-			Add(oldEntry->Item);
+			uint32 index = oldEntry->Hash % Capacity;
+			while (Entries[index].IsUsed) {
+				++index;
+				if (UNLIKELY(index == Capacity)) {
+					index = 0;
+				}
+			}
+			Memory::PlacementNew<T>(&Entries[index].Item, Move(oldEntry->Item));
+			Entries[index].Hash = oldEntry->Hash;
+			Entries[index].IsUsed = true;
+			oldEntry->Item.~T();
 			++oldEntry;
 		}
 
@@ -392,6 +638,9 @@ bool Set<T>::FixHole(uint32& index)
 		{
 			Entries[index] = Move(Entries[entryIndex]);
 			Entries[entryIndex].IsUsed = false;
+#if HASH_TABLE_STATS
+			++Counters.NumHoleMoves;
+#endif
 			// TODO (HvdK): call destructor?
 			index = entryIndex;
 			return true;
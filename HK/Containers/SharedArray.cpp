@@ -0,0 +1,49 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/SharedArray.h"
+
+GSharedArray::Header* GSharedArray::AllocateBlock(uint64 elementSize, uint32 max)
+{
+	void* memory = Memory::Allocate(sizeof(Header) + elementSize * max);
+	Header* block = Memory::PlacementNew<Header>(memory);
+	block->RefCount.Store(1, EMemoryOrder::Relaxed);
+	block->Num = 0;
+	block->Max = max;
+	return block;
+}
+
+void GSharedArray::FreeBlock(Header* block, uint64 elementSize)
+{
+	Memory::Free(block, sizeof(Header) + elementSize * block->Max);
+}
+
+void GSharedArray::GrowBlock(Header*& block, uint64 elementSize, uint32 max)
+{
+	CHECK(IsUniqueBlock(block));
+	void* memory = block;
+	Memory::Reallocate(memory, sizeof(Header) + elementSize * block->Max, sizeof(Header) + elementSize * max);
+	block = static_cast<Header*>(memory);
+	block->Max = max;
+}
+
+void GSharedArray::AddRef(Header* block)
+{
+	// A new reference is always made from an existing one, which keeps
+	// the block alive, so nothing needs to be ordered here.
+	block->RefCount.FetchAdd(1, EMemoryOrder::Relaxed);
+}
+
+bool GSharedArray::ReleaseRef(Header* block)
+{
+	// Writes done through other references have to be visible to
+	// whoever destroys the elements.
+	return block->RefCount.FetchSub(1, EMemoryOrder::AcqRel) == 1;
+}
+
+bool GSharedArray::IsUniqueBlock(const Header* block)
+{
+	// Pairs with the release in ReleaseRef, so the last reads through a
+	// copy that just let go happen before we write in place.
+	return block->RefCount.Load(EMemoryOrder::Acquire) == 1;
+}
\ No newline at end of file
@@ -0,0 +1,477 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Array.h"
+#include "Common/Math.h"
+#include "Util/Atomic.h"
+
+// The type independent part of SharedArray, a reference counted block
+// holding a small header followed by the elements.
+class GSharedArray {
+protected:
+	struct Header {
+		Atomic<uint32> RefCount;
+		uint32 Num;
+		uint32 Max;
+		uint32 Padding;
+	};
+
+	static Header* AllocateBlock(uint64 elementSize, uint32 max);
+	static void FreeBlock(Header* block, uint64 elementSize);
+	// Grows a block that nobody else references, moving the elements
+	// bitwise like Array does.
+	static void GrowBlock(Header*& block, uint64 elementSize, uint32 max);
+	static void AddRef(Header* block);
+	// Returns true when this dropped the last reference.
+	static bool ReleaseRef(Header* block);
+	static bool IsUniqueBlock(const Header* block);
+};
+
+// An array whose storage is shared between copies and only cloned when
+// a copy is written to while another copy still references it.
+// Copying is O(1), which makes it cheap to keep snapshots around for
+// undo or to hand a read-only copy to another thread. The reference
+// count is atomic, a single SharedArray object must still not be used
+// from two threads at once.
+// Reads never clone. Every mutating call makes the storage unique
+// first, so a mutation of a shared array costs a full copy. Use
+// PersistentArray when big arrays are snapshotted often and changed
+// in few places.
+template<typename T>
+class SharedArray : public GSharedArray {
+	static_assert(alignof(T) <= sizeof(Header), "SharedArray elements are aligned to its header");
+public:
+	SharedArray();
+	SharedArray(uint32 buffer);
+	SharedArray(ArrayView<T> items);
+	SharedArray(const SharedArray& other);
+	SharedArray(SharedArray&& other);
+	~SharedArray();
+
+	SharedArray& operator=(const SharedArray& other);
+	SharedArray& operator=(SharedArray&& other);
+
+	uint32 Num() const;
+	bool IsValidIndex(uint32 index) const;
+	// True when no other copy shares the storage, mutations are then
+	// done in place.
+	bool IsUnique() const;
+
+	const T& operator[](uint32 index) const;
+	const T* GetData() const;
+	ArrayView<T> View() const;
+	Array<T> ToArray() const;
+
+	// Returns a reference that may be written to, cloning shared storage.
+	// The reference is invalidated by the next mutation or copy.
+	T& Mutate(uint32 index);
+	T* GetMutableData();
+	void Set(uint32 index, const T& item);
+	void Add(const T& item);
+	void Add(T&& item);
+	T& AddDefaulted();
+	void RemoveAt(uint32 index);
+	void RemoveAtSwap(uint32 index);
+	void Reserve(uint32 num);
+	void Reset();
+
+	const T* begin() const { return GetData(); }
+	const T* end() const { return GetData() + Num(); }
+
+private:
+	// Makes the storage unique and at least max elements big.
+	void MakeUnique(uint32 max);
+	void Release();
+	T* Elements() const { return reinterpret_cast<T*>(Block + 1); }
+
+	Header* Block;
+};
+
+// An array split in chunks of 2^ChunkBits elements, each of which is a
+// SharedArray, behind a SharedArray of chunks.
+// Copying is O(1) like SharedArray, but writing to a shared copy only
+// clones the list of chunks and the one chunk being written to. Undo
+// snapshots of a big array then cost memory proportional to the
+// changes made between them, not to the array size.
+// Elements are only added and removed at the end.
+template<typename T, uint32 ChunkBits = 8>
+class PersistentArray {
+public:
+	static constexpr uint32 ChunkSize = 1 << ChunkBits;
+
+	PersistentArray();
+	PersistentArray(ArrayView<T> items);
+
+	uint32 Num() const;
+	bool IsValidIndex(uint32 index) const;
+
+	const T& operator[](uint32 index) const;
+	Array<T> ToArray() const;
+	// Calls visit(const T&) on every element in order.
+	template<typename F>
+	void ForEach(F&& visit) const;
+
+	// See SharedArray::Mutate.
+	T& Mutate(uint32 index);
+	void Set(uint32 index, const T& item);
+	void Add(const T& item);
+	void RemoveLast();
+	void Reset();
+
+private:
+	SharedArray<T>& MutateLastChunk();
+
+	SharedArray<SharedArray<T>> Chunks;
+	uint32 ArrayNum;
+};
+
+template<typename T>
+SharedArray<T>::SharedArray()
+{
+	Block = nullptr;
+}
+
+template<typename T>
+SharedArray<T>::SharedArray(uint32 buffer)
+{
+	Block = nullptr;
+	if (buffer > 0) {
+		Block = AllocateBlock(sizeof(T), buffer);
+	}
+}
+
+template<typename T>
+SharedArray<T>::SharedArray(ArrayView<T> items)
+{
+	Block = nullptr;
+	const uint32 num = items.Size();
+	if (num > 0) {
+		Block = AllocateBlock(sizeof(T), num);
+		for (uint32 i = 0; i < num; ++i) {
+			Memory::PlacementNew<T>(&Elements()[i], items[i]);
+		}
+		Block->Num = num;
+	}
+}
+
+template<typename T>
+SharedArray<T>::SharedArray(const SharedArray& other)
+{
+	Block = other.Block;
+	if (Block != nullptr) {
+		AddRef(Block);
+	}
+}
+
+template<typename T>
+SharedArray<T>::SharedArray(SharedArray&& other)
+{
+	Block = other.Block;
+	other.Block = nullptr;
+}
+
+template<typename T>
+SharedArray<T>::~SharedArray()
+{
+	Release();
+}
+
+template<typename T>
+SharedArray<T>& SharedArray<T>::operator=(const SharedArray& other)
+{
+	if (Block != other.Block) {
+		Release();
+		Block = other.Block;
+		if (Block != nullptr) {
+			AddRef(Block);
+		}
+	}
+	return *this;
+}
+
+template<typename T>
+SharedArray<T>& SharedArray<T>::operator=(SharedArray&& other)
+{
+	CHECK(this != &other);
+	Release();
+	Block = other.Block;
+	other.Block = nullptr;
+	return *this;
+}
+
+template<typename T>
+uint32 SharedArray<T>::Num() const
+{
+	return Block != nullptr ? Block->Num : 0;
+}
+
+template<typename T>
+bool SharedArray<T>::IsValidIndex(uint32 index) const
+{
+	return index < Num();
+}
+
+template<typename T>
+bool SharedArray<T>::IsUnique() const
+{
+	return Block == nullptr || IsUniqueBlock(Block);
+}
+
+template<typename T>
+const T& SharedArray<T>::operator[](uint32 index) const
+{
+	CHECK(IsValidIndex(index));
+	return Elements()[index];
+}
+
+template<typename T>
+const T* SharedArray<T>::GetData() const
+{
+	return Block != nullptr ? Elements() : nullptr;
+}
+
+template<typename T>
+ArrayView<T> SharedArray<T>::View() const
+{
+	return ArrayView<T>(GetData(), Num());
+}
+
+template<typename T>
+Array<T> SharedArray<T>::ToArray() const
+{
+	Array<T> result(Num());
+	for (uint32 i = 0; i < Num(); ++i) {
+		result.Add(Elements()[i]);
+	}
+	return result;
+}
+
+template<typename T>
+T& SharedArray<T>::Mutate(uint32 index)
+{
+	CHECK(IsValidIndex(index));
+	MakeUnique(Block->Max);
+	return Elements()[index];
+}
+
+template<typename T>
+T* SharedArray<T>::GetMutableData()
+{
+	if (Block == nullptr) {
+		return nullptr;
+	}
+	MakeUnique(Block->Max);
+	return Elements();
+}
+
+template<typename T>
+void SharedArray<T>::Set(uint32 index, const T& item)
+{
+	Mutate(index) = item;
+}
+
+template<typename T>
+void SharedArray<T>::Add(const T& item)
+{
+	MakeUnique(Num() + 1);
+	Memory::PlacementNew<T>(&Elements()[Block->Num++], item);
+}
+
+template<typename T>
+void SharedArray<T>::Add(T&& item)
+{
+	MakeUnique(Num() + 1);
+	Memory::PlacementNew<T>(&Elements()[Block->Num++], Move(item));
+}
+
+template<typename T>
+T& SharedArray<T>::AddDefaulted()
+{
+	MakeUnique(Num() + 1);
+	return *Memory::PlacementNew<T>(&Elements()[Block->Num++]);
+}
+
+template<typename T>
+void SharedArray<T>::RemoveAt(uint32 index)
+{
+	CHECK(IsValidIndex(index));
+	MakeUnique(Block->Max);
+	T* elements = Elements();
+	elements[index].~T();
+	const uint32 num = --Block->Num;
+	if (LIKELY(index < num)) {
+		Memory::Move(&elements[index + 1], &elements[index], sizeof(T) * (num - index));
+	}
+}
+
+template<typename T>
+void SharedArray<T>::RemoveAtSwap(uint32 index)
+{
+	CHECK(IsValidIndex(index));
+	MakeUnique(Block->Max);
+	T* elements = Elements();
+	elements[index].~T();
+	const uint32 num = --Block->Num;
+	if (LIKELY(index < num)) {
+		Memory::Copy(&elements[num], &elements[index], sizeof(T));
+	}
+}
+
+template<typename T>
+void SharedArray<T>::Reserve(uint32 num)
+{
+	MakeUnique(Num() + num);
+}
+
+template<typename T>
+void SharedArray<T>::Reset()
+{
+	Release();
+	Block = nullptr;
+}
+
+template<typename T>
+void SharedArray<T>::MakeUnique(uint32 max)
+{
+	if (UNLIKELY(Block == nullptr)) {
+		Block = AllocateBlock(sizeof(T), CalculateArrayMaxGrowth(0, max));
+		return;
+	}
+	if (UNLIKELY(!IsUniqueBlock(Block))) {
+		// Clone with copy constructors, the elements stay in use by the
+		// other copies.
+		const uint32 num = Block->Num;
+		Header* clone = AllocateBlock(sizeof(T), max > Block->Max ? CalculateArrayMaxGrowth(Block->Max, max) : Block->Max);
+		T* from = Elements();
+		T* to = reinterpret_cast<T*>(clone + 1);
+		for (uint32 i = 0; i < num; ++i) {
+			Memory::PlacementNew<T>(&to[i], from[i]);
+		}
+		clone->Num = num;
+		// The other copies may have let go since we checked
+		Release();
+		Block = clone;
+		return;
+	}
+	if (UNLIKELY(Block->Max < max)) {
+		GrowBlock(Block, sizeof(T), CalculateArrayMaxGrowth(Block->Max, max));
+	}
+}
+
+template<typename T>
+void SharedArray<T>::Release()
+{
+	if (Block != nullptr && ReleaseRef(Block)) {
+		T* elements = Elements();
+		for (uint32 i = 0; i < Block->Num; ++i) {
+			elements[i].~T();
+		}
+		FreeBlock(Block, sizeof(T));
+	}
+}
+
+template<typename T, uint32 ChunkBits>
+PersistentArray<T, ChunkBits>::PersistentArray()
+{
+	ArrayNum = 0;
+}
+
+template<typename T, uint32 ChunkBits>
+PersistentArray<T, ChunkBits>::PersistentArray(ArrayView<T> items)
+	: Chunks((items.Size() + ChunkSize - 1) >> ChunkBits)
+{
+	ArrayNum = items.Size();
+	for (uint32 start = 0; start < ArrayNum; start += ChunkSize) {
+		const uint32 num = Math::Min(ChunkSize, ArrayNum - start);
+		Chunks.Add(SharedArray<T>(ArrayView<T>(&items.ConstData()[start], num)));
+	}
+}
+
+template<typename T, uint32 ChunkBits>
+uint32 PersistentArray<T, ChunkBits>::Num() const
+{
+	return ArrayNum;
+}
+
+template<typename T, uint32 ChunkBits>
+bool PersistentArray<T, ChunkBits>::IsValidIndex(uint32 index) const
+{
+	return index < ArrayNum;
+}
+
+template<typename T, uint32 ChunkBits>
+const T& PersistentArray<T, ChunkBits>::operator[](uint32 index) const
+{
+	CHECK(IsValidIndex(index));
+	return Chunks[index >> ChunkBits][index & (ChunkSize - 1)];
+}
+
+template<typename T, uint32 ChunkBits>
+Array<T> PersistentArray<T, ChunkBits>::ToArray() const
+{
+	Array<T> result(ArrayNum);
+	ForEach([&result](const T& item) { result.Add(item); });
+	return result;
+}
+
+template<typename T, uint32 ChunkBits>
+template<typename F>
+void PersistentArray<T, ChunkBits>::ForEach(F&& visit) const
+{
+	for (const SharedArray<T>& chunk : Chunks) {
+		for (const T& item : chunk) {
+			visit(item);
+		}
+	}
+}
+
+template<typename T, uint32 ChunkBits>
+T& PersistentArray<T, ChunkBits>::Mutate(uint32 index)
+{
+	CHECK(IsValidIndex(index));
+	return Chunks.Mutate(index >> ChunkBits).Mutate(index & (ChunkSize - 1));
+}
+
+template<typename T, uint32 ChunkBits>
+void PersistentArray<T, ChunkBits>::Set(uint32 index, const T& item)
+{
+	Mutate(index) = item;
+}
+
+template<typename T, uint32 ChunkBits>
+void PersistentArray<T, ChunkBits>::Add(const T& item)
+{
+	if ((ArrayNum & (ChunkSize - 1)) == 0) {
+		Chunks.Add(SharedArray<T>(ChunkSize));
+	}
+	MutateLastChunk().Add(item);
+	++ArrayNum;
+}
+
+template<typename T, uint32 ChunkBits>
+void PersistentArray<T, ChunkBits>::RemoveLast()
+{
+	CHECK(ArrayNum > 0);
+	--ArrayNum;
+	if ((ArrayNum & (ChunkSize - 1)) == 0) {
+		Chunks.RemoveAt(Chunks.Num() - 1);
+	} else {
+		SharedArray<T>& chunk = MutateLastChunk();
+		chunk.RemoveAt(chunk.Num() - 1);
+	}
+}
+
+template<typename T, uint32 ChunkBits>
+void PersistentArray<T, ChunkBits>::Reset()
+{
+	Chunks.Reset();
+	ArrayNum = 0;
+}
+
+template<typename T, uint32 ChunkBits>
+SharedArray<T>& PersistentArray<T, ChunkBits>::MutateLastChunk()
+{
+	return Chunks.Mutate(Chunks.Num() - 1);
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/SnapshotMap.h"
+
+GSnapshotMap::GSnapshotMap(void (*destroySnapshot)(void*))
+	: Current(nullptr)
+	, GlobalEpoch(1)
+	, DestroySnapshot(destroySnapshot)
+{
+}
+
+GSnapshotMap::~GSnapshotMap()
+{
+	for (uint32 i = 0; i < MaxReaders; ++i) {
+		CHECK(Slots[i].InUse.Load(EMemoryOrder::Relaxed) == 0);
+	}
+	for (const RetiredSnapshot& retired : Retired) {
+		DestroySnapshot(retired.Snapshot);
+	}
+	void* current = Current.Load(EMemoryOrder::Acquire);
+	if (current != nullptr) {
+		DestroySnapshot(current);
+	}
+}
+
+void GSnapshotMap::Reclaim()
+{
+	ScopeLock<SpinLock> lock(WriterLock);
+	ReclaimLocked();
+}
+
+uint32 GSnapshotMap::ClaimReaderSlot() const
+{
+	for (uint32 i = 0; i < MaxReaders; ++i) {
+		uint32 expected = 0;
+		if (Slots[i].InUse.Load(EMemoryOrder::Relaxed) == 0 &&
+			Slots[i].InUse.CompareExchange(expected, 1, EMemoryOrder::Acquire)) {
+			return i;
+		}
+	}
+	// Raise MaxReaders if you really need this many
+	CHECK(false);
+	return 0;
+}
+
+void GSnapshotMap::ReleaseReaderSlot(uint32 slot) const
+{
+	CHECK(Slots[slot].Epoch.Load(EMemoryOrder::Relaxed) == 0);
+	Slots[slot].InUse.Store(0, EMemoryOrder::Release);
+}
+
+const void* GSnapshotMap::Pin(uint32 slot) const
+{
+	CHECK(Slots[slot].Epoch.Load(EMemoryOrder::Relaxed) == 0);
+	// Announcing the epoch has to be ordered before loading the
+	// snapshot, which takes a sequentially consistent store.
+	Slots[slot].Epoch.Store(GlobalEpoch.Load(EMemoryOrder::Acquire), EMemoryOrder::SeqCst);
+	return Current.Load(EMemoryOrder::SeqCst);
+}
+
+void GSnapshotMap::Unpin(uint32 slot) const
+{
+	Slots[slot].Epoch.Store(0, EMemoryOrder::Release);
+}
+
+void GSnapshotMap::PublishInternal(void* snapshot)
+{
+	ScopeLock<SpinLock> lock(WriterLock);
+	void* previous = Current.Exchange(snapshot, EMemoryOrder::SeqCst);
+	if (previous != nullptr) {
+		// Readers that announce a later epoch load the new snapshot
+		RetiredSnapshot retired;
+		retired.Snapshot = previous;
+		retired.Epoch = GlobalEpoch.FetchAdd(1, EMemoryOrder::SeqCst);
+		Retired.Add(retired);
+	}
+	ReclaimLocked();
+}
+
+void GSnapshotMap::ReclaimLocked()
+{
+	if (Retired.Num() == 0) {
+		return;
+	}
+	
+	uint64 oldestPinned = Traits::Limits<uint64>::Max;
+	for (uint32 i = 0; i < MaxReaders; ++i) {
+		const uint64 epoch = Slots[i].Epoch.Load(EMemoryOrder::SeqCst);
+		if (epoch != 0 && epoch < oldestPinned) {
+			oldestPinned = epoch;
+		}
+	}
+	
+	for (uint32 i = Retired.Num(); i > 0;) {
+		--i;
+		if (Retired[i].Epoch < oldestPinned) {
+			DestroySnapshot(Retired[i].Snapshot);
+			Retired.RemoveAtSwap(i);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "HashMap.h"
+#include "Util/Atomic.h"
+#include "Util/SpinLock.h"
+
+// The type independent part of SnapshotMap, an epoch based publisher
+// of immutable snapshots.
+// Readers announce the global epoch in their own slot before loading
+// the current snapshot, and clear it when they are done. A snapshot
+// replaced in epoch E can only be seen by readers that announced E or
+// earlier, so it is freed once every active reader is past E.
+class GSnapshotMap {
+public:
+	static constexpr uint32 MaxReaders = 64;
+	
+	// Frees every replaced snapshot that no reader can still see.
+	// Publishing reclaims as well, so this is only needed to release
+	// memory early.
+	void Reclaim();
+	
+protected:
+	GSnapshotMap(void (*destroySnapshot)(void*));
+	~GSnapshotMap();
+	
+	uint32 ClaimReaderSlot() const;
+	void ReleaseReaderSlot(uint32 slot) const;
+	const void* Pin(uint32 slot) const;
+	void Unpin(uint32 slot) const;
+	void PublishInternal(void* snapshot);
+	
+private:
+	void ReclaimLocked();
+	
+	struct alignas(CACHE_LINE_SIZE) ReaderSlot {
+		// The epoch the reader pinned in, 0 while it isn't reading
+		Atomic<uint64> Epoch;
+		Atomic<uint32> InUse;
+	};
+	struct RetiredSnapshot {
+		void* Snapshot;
+		uint64 Epoch;
+	};
+	
+	mutable ReaderSlot Slots[MaxReaders];
+	alignas(CACHE_LINE_SIZE) Atomic<void*> Current;
+	Atomic<uint64> GlobalEpoch;
+	
+	alignas(CACHE_LINE_SIZE) SpinLock WriterLock;
+	Array<RetiredSnapshot> Retired;
+	void (*DestroySnapshot)(void*);
+};
+
+// A hash map for read-mostly tables that are shared between threads.
+// Readers look up keys in an immutable snapshot without taking any lock
+// or writing to memory shared with other readers, so reads never block
+// and scale with the number of reading threads.
+// A writer builds a complete new HashMap and publishes it, which swaps
+// it in atomically. Old snapshots are freed once no reader uses them.
+template<class TKey, class TValue>
+class SnapshotMap : public GSnapshotMap {
+public:
+	typedef HashMap<TKey, TValue> TableType;
+	
+	SnapshotMap();
+	~SnapshotMap();
+	SnapshotMap(const SnapshotMap&) = delete;
+	SnapshotMap& operator=(const SnapshotMap&) = delete;
+	
+	// Replaces the current table, may be called from any thread.
+	void Publish(TableType&& table);
+	// Returns a copy of the current table, to modify and publish.
+	TableType CopyCurrent() const;
+	
+	// A thread's handle to read the map, each reading thread should
+	// keep one alive instead of creating one per lookup. At most
+	// MaxReaders readers can exist at once.
+	class Reader {
+	public:
+		Reader(const SnapshotMap& map);
+		~Reader();
+		Reader(const Reader&) = delete;
+		Reader& operator=(const Reader&) = delete;
+		
+		bool Find(const TKey& key, TValue& outValue);
+		// See HashMap::FindAs.
+		template<typename K>
+		bool FindAs(const K& key, TValue& outValue);
+		
+		// Pins the current snapshot, which stays valid until Unpin.
+		// Use this to do many lookups in one consistent snapshot.
+		const TableType& Pin();
+		void Unpin();
+		
+	private:
+		const SnapshotMap& Map;
+		uint32 Slot;
+	};
+	
+private:
+	static void DestroyTable(void* table);
+	static TableType* NewTable(TableType&& table);
+};
+
+template<class TKey, class TValue>
+SnapshotMap<TKey, TValue>::SnapshotMap()
+	: GSnapshotMap(&DestroyTable)
+{
+	PublishInternal(NewTable(TableType()));
+}
+
+template<class TKey, class TValue>
+SnapshotMap<TKey, TValue>::~SnapshotMap()
+{
+}
+
+template<class TKey, class TValue>
+void SnapshotMap<TKey, TValue>::Publish(TableType&& table)
+{
+	PublishInternal(NewTable(Move(table)));
+}
+
+template<class TKey, class TValue>
+typename SnapshotMap<TKey, TValue>::TableType SnapshotMap<TKey, TValue>::CopyCurrent() const
+{
+	Reader reader(*this);
+	TableType copy(reader.Pin());
+	reader.Unpin();
+	return copy;
+}
+
+template<class TKey, class TValue>
+void SnapshotMap<TKey, TValue>::DestroyTable(void* table)
+{
+	TableType* typed = static_cast<TableType*>(table);
+	typed->~TableType();
+	Memory::Free(typed, sizeof(TableType));
+}
+
+template<class TKey, class TValue>
+typename SnapshotMap<TKey, TValue>::TableType* SnapshotMap<TKey, TValue>::NewTable(TableType&& table)
+{
+	void* memory = Memory::Allocate(sizeof(TableType));
+	return Memory::PlacementNew<TableType>(memory, Move(table));
+}
+
+template<class TKey, class TValue>
+SnapshotMap<TKey, TValue>::Reader::Reader(const SnapshotMap& map)
+	: Map(map)
+	, Slot(map.ClaimReaderSlot())
+{}
+
+template<class TKey, class TValue>
+SnapshotMap<TKey, TValue>::Reader::~Reader()
+{
+	Map.ReleaseReaderSlot(Slot);
+}
+
+template<class TKey, class TValue>
+bool SnapshotMap<TKey, TValue>::Reader::Find(const TKey& key, TValue& outValue)
+{
+	return FindAs(key, outValue);
+}
+
+template<class TKey, class TValue>
+template<typename K>
+bool SnapshotMap<TKey, TValue>::Reader::FindAs(const K& key, TValue& outValue)
+{
+	const TValue* value = Pin().FindAs(key);
+	if (value != nullptr) {
+		outValue = *value;
+	}
+	Unpin();
+	return value != nullptr;
+}
+
+template<class TKey, class TValue>
+const typename SnapshotMap<TKey, TValue>::TableType& SnapshotMap<TKey, TValue>::Reader::Pin()
+{
+	return *static_cast<const TableType*>(Map.Pin(Slot));
+}
+
+template<class TKey, class TValue>
+void SnapshotMap<TKey, TValue>::Reader::Unpin()
+{
+	Map.Unpin(Slot);
+}
\ No newline at end of file
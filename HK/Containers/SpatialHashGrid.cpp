@@ -0,0 +1,206 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Containers/SpatialHashGrid.h"
+
+#include "Common/Math.h"
+
+// Rounds towards negative infinity, clamped so far away points share
+// the outermost cells instead of overflowing.
+static int32 FloorToCell(f32 value)
+{
+	if (UNLIKELY(!(value > -1.0e9f))) {
+		return -1000000000;
+	}
+	if (UNLIKELY(value > 1.0e9f)) {
+		return 1000000000;
+	}
+	const int32 truncated = int32(value);
+	return truncated - (f32(truncated) > value);
+}
+
+static f32 DistanceSquared(const SpatialPoint& a, const SpatialPoint& b)
+{
+	const f32 dx = a.X - b.X;
+	const f32 dy = a.Y - b.Y;
+	const f32 dz = a.Z - b.Z;
+	return dx * dx + dy * dy + dz * dz;
+}
+
+// Sets the number of elements without keeping them, for arrays of
+// plain data that are overwritten right after.
+template<typename T>
+static void SetNumUninitialized(Array<T>& array, uint32 num)
+{
+	array.Reset();
+	array.AddUninitialized(num);
+}
+
+void GSpatialHashGrid::CellKey::Hash(Hasher& hasher) const
+{
+	hasher.Add(X);
+	hasher.Add(Y);
+	hasher.Add(Z);
+}
+
+GSpatialHashGrid::GSpatialHashGrid(f32 cellSize)
+{
+	CHECK(cellSize > 0.0f);
+	CellSize = cellSize;
+	InverseCellSize = 1.0f / cellSize;
+	BucketMask = 0;
+	BucketStarts.Add(0);
+	BucketStarts.Add(0);
+}
+
+uint32 GSpatialHashGrid::Num() const
+{
+	return Positions.Num();
+}
+
+f32 GSpatialHashGrid::GetCellSize() const
+{
+	return CellSize;
+}
+
+void GSpatialHashGrid::QuerySphere(const SpatialPoint& center, f32 radius, Array<uint32>& outIndices) const
+{
+	const uint32* inputIndices = InputIndices.GetData();
+	ForEachInSphereSorted(center, radius, [&](uint32 i) {
+		outIndices.Add(inputIndices[i]);
+	});
+}
+
+void GSpatialHashGrid::QueryBox(const SpatialPoint& min, const SpatialPoint& max, Array<uint32>& outIndices) const
+{
+	const uint32* inputIndices = InputIndices.GetData();
+	ForEachInBoxSorted(min, max, [&](uint32 i) {
+		outIndices.Add(inputIndices[i]);
+	});
+}
+
+void GSpatialHashGrid::FindNearest(ArrayView<SpatialPoint> queries, f32 maxDistance, Array<uint32>& outIndices) const
+{
+	uint32* results = outIndices.AddUninitialized(queries.Size());
+	const SpatialPoint* positions = Positions.GetData();
+	const CellKey* cells = Cells.GetData();
+	const uint32* starts = BucketStarts.GetData();
+	const f32 maxDistanceSquared = maxDistance * maxDistance;
+	const int32 maxRing = FloorToCell(maxDistance * InverseCellSize) + 1;
+	
+	for (uint32 q = 0; q < queries.Size(); ++q) {
+		const SpatialPoint& query = queries[q];
+		const CellKey center = GetCell(query);
+		f32 best = maxDistanceSquared;
+		uint32 bestIndex = INVALID_INDEX;
+		const auto visitEntry = [&](uint32 i) {
+			const f32 distance = DistanceSquared(positions[i], query);
+			if (distance <= best) {
+				// Ties go to the earliest input, like a brute force search
+				if (distance < best || bestIndex == INVALID_INDEX || InputIndices[i] < InputIndices[bestIndex]) {
+					best = distance;
+					bestIndex = i;
+				}
+			}
+		};
+		
+		// Search shells of cells around the query's cell. Entries beyond
+		// shell r are at least r cells away, once the best is closer than
+		// that nothing further out can beat it.
+		for (int32 ring = 0; ring <= maxRing; ++ring) {
+			if (ring > 0) {
+				const f32 reach = f32(ring - 1) * CellSize;
+				if (reach * reach >= best) {
+					break;
+				}
+			}
+			const f64 side = 2.0 * ring + 1.0;
+			if (side * side * side >= f64(Positions.Num())) {
+				// Cheaper to look at everything than at this many cells
+				for (uint32 i = 0; i < Positions.Num(); ++i) {
+					visitEntry(i);
+				}
+				break;
+			}
+			CellKey cell;
+			for (int32 dz = -ring; dz <= ring; ++dz) {
+				cell.Z = center.Z + dz;
+				for (int32 dy = -ring; dy <= ring; ++dy) {
+					cell.Y = center.Y + dy;
+					const bool onShell = dz == -ring || dz == ring || dy == -ring || dy == ring;
+					// Inside the shell only the two ends of the row are new
+					const int32 step = onShell ? 1 : 2 * ring;
+					for (int32 dx = -ring; dx <= ring; dx += step) {
+						cell.X = center.X + dx;
+						const uint32 bucket = GetBucket(cell);
+						for (uint32 i = starts[bucket]; i < starts[bucket + 1]; ++i) {
+							if (cells[i] == cell) {
+								visitEntry(i);
+							}
+						}
+					}
+				}
+			}
+		}
+		results[q] = bestIndex != INVALID_INDEX ? InputIndices[bestIndex] : INVALID_INDEX;
+	}
+}
+
+void GSpatialHashGrid::SortEntries(ArrayView<SpatialPoint> positions)
+{
+	const uint32 num = positions.Size();
+	
+	// About two buckets per entry keeps buckets short, the table only
+	// grows so rebuilds with fewer entries don't reallocate.
+	const uint32 numBuckets = Math::NextPowerOfTwo(Math::Max(num * 2, 16u));
+	if (numBuckets > BucketMask + 1) {
+		BucketMask = numBuckets - 1;
+		SetNumUninitialized(BucketStarts, numBuckets + 1);
+	}
+	uint32* starts = BucketStarts.GetData();
+	Memory::FillZero(starts, sizeof(uint32) * (BucketMask + 2));
+	
+	SetNumUninitialized(EntryBuckets, num);
+	uint32* entryBuckets = EntryBuckets.GetData();
+	for (uint32 i = 0; i < num; ++i) {
+		const uint32 bucket = GetBucket(GetCell(positions[i]));
+		entryBuckets[i] = bucket;
+		++starts[bucket];
+	}
+	
+	// Make every start the end of its bucket, the scatter below walks
+	// backwards and moves them to the front, keeping the input order.
+	uint32 sum = 0;
+	for (uint32 bucket = 0; bucket <= BucketMask; ++bucket) {
+		sum += starts[bucket];
+		starts[bucket] = sum;
+	}
+	starts[BucketMask + 1] = num;
+	
+	SetNumUninitialized(Positions, num);
+	SetNumUninitialized(Cells, num);
+	SetNumUninitialized(InputIndices, num);
+	SpatialPoint* sortedPositions = Positions.GetData();
+	CellKey* sortedCells = Cells.GetData();
+	uint32* inputIndices = InputIndices.GetData();
+	for (uint32 i = num; i-- > 0;) {
+		const uint32 slot = --starts[entryBuckets[i]];
+		sortedPositions[slot] = positions[i];
+		sortedCells[slot] = GetCell(positions[i]);
+		inputIndices[slot] = i;
+	}
+}
+
+GSpatialHashGrid::CellKey GSpatialHashGrid::GetCell(const SpatialPoint& position) const
+{
+	CellKey cell;
+	cell.X = FloorToCell(position.X * InverseCellSize);
+	cell.Y = FloorToCell(position.Y * InverseCellSize);
+	cell.Z = FloorToCell(position.Z * InverseCellSize);
+	return cell;
+}
+
+uint32 GSpatialHashGrid::GetBucket(const CellKey& cell) const
+{
+	return Hasher::Hash<uint32>(cell) & BucketMask;
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Array.h"
+#include "Util/Hasher.h"
+
+struct SpatialPoint {
+	f32 X;
+	f32 Y;
+	f32 Z;
+};
+
+// The type independent part of SpatialHashGrid, which sorts the entries
+// by the hash bucket of their cell and answers the queries in terms of
+// the entries' indices in the Rebuild input.
+class GSpatialHashGrid {
+public:
+	uint32 Num() const;
+	f32 GetCellSize() const;
+
+	// Adds the index of every entry within radius of center to outIndices.
+	void QuerySphere(const SpatialPoint& center, f32 radius, Array<uint32>& outIndices) const;
+	// Adds the index of every entry inside the box to outIndices.
+	void QueryBox(const SpatialPoint& min, const SpatialPoint& max, Array<uint32>& outIndices) const;
+	// Adds one index per query to outIndices, that of the closest entry
+	// within maxDistance of the query, or INVALID_INDEX when there is none.
+	// Keep maxDistance within a few cells, every ring of cells up to it
+	// may need to be searched for queries far from any entry.
+	void FindNearest(ArrayView<SpatialPoint> queries, f32 maxDistance, Array<uint32>& outIndices) const;
+
+protected:
+	struct CellKey {
+		int32 X;
+		int32 Y;
+		int32 Z;
+
+		bool operator==(const CellKey& other) const { return X == other.X && Y == other.Y && Z == other.Z; }
+		void Hash(Hasher& hasher) const;
+	};
+
+	GSpatialHashGrid(f32 cellSize);
+
+	// Counting sorts the positions by bucket into Positions, Cells and
+	// InputIndices. Reuses all memory from earlier rebuilds.
+	void SortEntries(ArrayView<SpatialPoint> positions);
+	CellKey GetCell(const SpatialPoint& position) const;
+	uint32 GetBucket(const CellKey& cell) const;
+	// Calls visit(uint32 sortedIndex) for every entry in the cells from
+	// min to max inclusive, or for every entry when that's less work.
+	template<typename F>
+	void ForEachInCells(const CellKey& min, const CellKey& max, F&& visit) const;
+	template<typename F>
+	void ForEachInSphereSorted(const SpatialPoint& center, f32 radius, F&& visit) const;
+	template<typename F>
+	void ForEachInBoxSorted(const SpatialPoint& min, const SpatialPoint& max, F&& visit) const;
+
+	// Parallel arrays of the entries sorted by bucket, entries of the
+	// same bucket are contiguous and keep their input order.
+	Array<SpatialPoint> Positions;
+	Array<CellKey> Cells;
+	Array<uint32> InputIndices;
+	// The first sorted entry of every bucket, with one more at the end
+	Array<uint32> BucketStarts;
+	Array<uint32> EntryBuckets;
+	f32 CellSize;
+	f32 InverseCellSize;
+	uint32 BucketMask;
+};
+
+// A broad-phase structure for finding entries near a point, rebuilt from
+// scratch whenever the entries move, usually once per frame.
+// Space is cut in cubes of cellSize, and each cell is hashed to one of a
+// power of two number of buckets. A rebuild counting sorts all entries
+// by bucket so every bucket's entries are contiguous, without an array
+// per cell. Queries visit the buckets of the cells they overlap and
+// filter out entries of other cells that share the bucket.
+// Pick a cell size close to the usual query radius. Rebuilds and queries
+// reuse their memory, so they don't allocate once the grid has seen its
+// largest number of entries and the output arrays have grown.
+template<typename T>
+class SpatialHashGrid : public GSpatialHashGrid {
+public:
+	SpatialHashGrid(f32 cellSize);
+
+	// Replaces all entries, values[i] is found at positions[i].
+	void Rebuild(ArrayView<SpatialPoint> positions, ArrayView<T> values);
+
+	// Calls visit(const T& value, const SpatialPoint& position) for every
+	// entry within radius of center.
+	template<typename F>
+	void ForEachInSphere(const SpatialPoint& center, f32 radius, F&& visit) const;
+	// Calls visit(const T& value, const SpatialPoint& position) for every
+	// entry inside the box.
+	template<typename F>
+	void ForEachInBox(const SpatialPoint& min, const SpatialPoint& max, F&& visit) const;
+
+private:
+	// Sorted like the positions
+	Array<T> Values;
+};
+
+template<typename F>
+void GSpatialHashGrid::ForEachInCells(const CellKey& min, const CellKey& max, F&& visit) const
+{
+	// In floating point, a huge range would overflow any integer
+	const f64 numCells = (f64(max.X) - min.X + 1) * (f64(max.Y) - min.Y + 1) * (f64(max.Z) - min.Z + 1);
+	if (numCells >= f64(Positions.Num())) {
+		for (uint32 i = 0; i < Positions.Num(); ++i) {
+			visit(i);
+		}
+		return;
+	}
+	const uint32* starts = BucketStarts.GetData();
+	const CellKey* cells = Cells.GetData();
+	CellKey cell;
+	for (cell.Z = min.Z; cell.Z <= max.Z; ++cell.Z) {
+		for (cell.Y = min.Y; cell.Y <= max.Y; ++cell.Y) {
+			for (cell.X = min.X; cell.X <= max.X; ++cell.X) {
+				const uint32 bucket = GetBucket(cell);
+				for (uint32 i = starts[bucket]; i < starts[bucket + 1]; ++i) {
+					if (cells[i] == cell) {
+						visit(i);
+					}
+				}
+			}
+		}
+	}
+}
+
+template<typename F>
+void GSpatialHashGrid::ForEachInSphereSorted(const SpatialPoint& center, f32 radius, F&& visit) const
+{
+	const SpatialPoint min = { center.X - radius, center.Y - radius, center.Z - radius };
+	const SpatialPoint max = { center.X + radius, center.Y + radius, center.Z + radius };
+	const f32 radiusSquared = radius * radius;
+	const SpatialPoint* positions = Positions.GetData();
+	ForEachInCells(GetCell(min), GetCell(max), [&](uint32 i) {
+		const f32 dx = positions[i].X - center.X;
+		const f32 dy = positions[i].Y - center.Y;
+		const f32 dz = positions[i].Z - center.Z;
+		if (dx * dx + dy * dy + dz * dz <= radiusSquared) {
+			visit(i);
+		}
+	});
+}
+
+template<typename F>
+void GSpatialHashGrid::ForEachInBoxSorted(const SpatialPoint& min, const SpatialPoint& max, F&& visit) const
+{
+	const SpatialPoint* positions = Positions.GetData();
+	ForEachInCells(GetCell(min), GetCell(max), [&](uint32 i) {
+		const SpatialPoint& p = positions[i];
+		if (p.X >= min.X && p.X <= max.X && p.Y >= min.Y && p.Y <= max.Y && p.Z >= min.Z && p.Z <= max.Z) {
+			visit(i);
+		}
+	});
+}
+
+template<typename T>
+SpatialHashGrid<T>::SpatialHashGrid(f32 cellSize)
+	: GSpatialHashGrid(cellSize)
+{}
+
+template<typename T>
+void SpatialHashGrid<T>::Rebuild(ArrayView<SpatialPoint> positions, ArrayView<T> values)
+{
+	CHECK(positions.Size() == values.Size());
+	SortEntries(positions);
+	Values.Reset();
+	T* sorted = Values.AddUninitialized(values.Size());
+	const T* input = values.ConstData();
+	for (uint32 i = 0; i < InputIndices.Num(); ++i) {
+		Memory::PlacementNew<T>(&sorted[i], input[InputIndices[i]]);
+	}
+}
+
+template<typename T>
+template<typename F>
+void SpatialHashGrid<T>::ForEachInSphere(const SpatialPoint& center, f32 radius, F&& visit) const
+{
+	ForEachInSphereSorted(center, radius, [&](uint32 i) {
+		visit(Values[i], Positions[i]);
+	});
+}
+
+template<typename T>
+template<typename F>
+void SpatialHashGrid<T>::ForEachInBox(const SpatialPoint& min, const SpatialPoint& max, F&& visit) const
+{
+	ForEachInBoxSorted(min, max, [&](uint32 i) {
+		visit(Values[i], Positions[i]);
+	});
+}
\ No newline at end of file
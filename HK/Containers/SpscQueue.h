@@ -0,0 +1,175 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Allocators/Memory.h"
+#include "Common/Math.h"
+#include "Containers/View/ArrayView.h"
+#include "Util/Atomic.h"
+
+// A bounded wait-free queue between exactly one producer thread and one
+// consumer thread. The items live in a power of two ring, Head and Tail
+// count up forever and are masked into it.
+// Each side keeps a cached copy of the other side's counter and only
+// reloads it when the ring looks full or empty, so in the steady state
+// neither side touches the other's cache line.
+template<typename T>
+class SpscQueue {
+public:
+	// The capacity is rounded up to a power of two
+	SpscQueue(uint32 capacity);
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+	~SpscQueue();
+	
+	// Producer only, returns false if the queue is full
+	bool Push(const T& item);
+	bool Push(T&& item);
+	// Producer only, pushes as many items as fit and returns how many
+	uint32 PushN(const ArrayView<T>& items);
+	
+	// Consumer only, returns false if the queue is empty
+	bool Pop(T& outItem);
+	// Consumer only, pops up to maxItems and returns how many
+	uint32 PopN(T* outItems, uint32 maxItems);
+	
+	// Exact only when called from one of the two threads while the
+	// other is idle
+	uint32 Num() const;
+	uint32 GetCapacity() const { return Mask + 1; }
+	
+protected:
+	// Returns the number of free slots, reloading Head if needed
+	uint32 GetFreeSlots(uint32 tail, uint32 wanted);
+	// Returns the number of filled slots, reloading Tail if needed
+	uint32 GetFilledSlots(uint32 head, uint32 wanted);
+	
+	// Written by the producer
+	alignas(CACHE_LINE_SIZE) Atomic<uint32> Tail;
+	uint32 CachedHead;
+	
+	// Written by the consumer
+	alignas(CACHE_LINE_SIZE) Atomic<uint32> Head;
+	uint32 CachedTail;
+	
+	alignas(CACHE_LINE_SIZE) T* Items;
+	uint32 Mask;
+};
+
+template<typename T>
+SpscQueue<T>::SpscQueue(uint32 capacity)
+	: Tail(0)
+	, CachedHead(0)
+	, Head(0)
+	, CachedTail(0)
+{
+	CHECK(capacity > 0 && capacity <= (1u << 31));
+	capacity = Math::NextPowerOfTwo(capacity);
+	Items = Memory::Allocate<T>(capacity);
+	Mask = capacity - 1;
+}
+
+template<typename T>
+SpscQueue<T>::~SpscQueue()
+{
+	const uint32 tail = Tail.Load(EMemoryOrder::Relaxed);
+	for (uint32 i = Head.Load(EMemoryOrder::Relaxed); i != tail; ++i) {
+		Items[i & Mask].~T();
+	}
+	Memory::Free(Items, sizeof(T) * uint64(Mask + 1));
+}
+
+template<typename T>
+bool SpscQueue<T>::Push(const T& item)
+{
+	const uint32 tail = Tail.Load(EMemoryOrder::Relaxed);
+	if (GetFreeSlots(tail, 1) == 0) {
+		return false;
+	}
+	Memory::PlacementNew<T>(&Items[tail & Mask], item);
+	Tail.Store(tail + 1, EMemoryOrder::Release);
+	return true;
+}
+
+template<typename T>
+bool SpscQueue<T>::Push(T&& item)
+{
+	const uint32 tail = Tail.Load(EMemoryOrder::Relaxed);
+	if (GetFreeSlots(tail, 1) == 0) {
+		return false;
+	}
+	Memory::PlacementNew<T>(&Items[tail & Mask], Move(item));
+	Tail.Store(tail + 1, EMemoryOrder::Release);
+	return true;
+}
+
+template<typename T>
+uint32 SpscQueue<T>::PushN(const ArrayView<T>& items)
+{
+	const uint32 tail = Tail.Load(EMemoryOrder::Relaxed);
+	const uint32 num = Math::Min(items.Size(), GetFreeSlots(tail, items.Size()));
+	const T* source = items.ConstData();
+	for (uint32 i = 0; i < num; ++i) {
+		Memory::PlacementNew<T>(&Items[(tail + i) & Mask], source[i]);
+	}
+	// One release publishes the whole batch
+	Tail.Store(tail + num, EMemoryOrder::Release);
+	return num;
+}
+
+template<typename T>
+bool SpscQueue<T>::Pop(T& outItem)
+{
+	const uint32 head = Head.Load(EMemoryOrder::Relaxed);
+	if (GetFilledSlots(head, 1) == 0) {
+		return false;
+	}
+	T& item = Items[head & Mask];
+	outItem = Move(item);
+	item.~T();
+	Head.Store(head + 1, EMemoryOrder::Release);
+	return true;
+}
+
+template<typename T>
+uint32 SpscQueue<T>::PopN(T* outItems, uint32 maxItems)
+{
+	const uint32 head = Head.Load(EMemoryOrder::Relaxed);
+	const uint32 num = Math::Min(maxItems, GetFilledSlots(head, maxItems));
+	for (uint32 i = 0; i < num; ++i) {
+		T& item = Items[(head + i) & Mask];
+		outItems[i] = Move(item);
+		item.~T();
+	}
+	Head.Store(head + num, EMemoryOrder::Release);
+	return num;
+}
+
+template<typename T>
+uint32 SpscQueue<T>::Num() const
+{
+	return Tail.Load(EMemoryOrder::Acquire) - Head.Load(EMemoryOrder::Acquire);
+}
+
+template<typename T>
+uint32 SpscQueue<T>::GetFreeSlots(uint32 tail, uint32 wanted)
+{
+	uint32 free = Mask + 1 - (tail - CachedHead);
+	if (free < wanted) {
+		CachedHead = Head.Load(EMemoryOrder::Acquire);
+		free = Mask + 1 - (tail - CachedHead);
+	}
+	return free;
+}
+
+template<typename T>
+uint32 SpscQueue<T>::GetFilledSlots(uint32 head, uint32 wanted)
+{
+	uint32 filled = CachedTail - head;
+	if (filled < wanted) {
+		CachedTail = Tail.Load(EMemoryOrder::Acquire);
+		filled = CachedTail - head;
+	}
+	return filled;
+}
\ No newline at end of file
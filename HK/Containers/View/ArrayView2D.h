@@ -0,0 +1,132 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Common/CompilerMacros.h"
+#include "Common/Math.h"
+#include "Common/Types.h"
+#include "Containers/Array.h"
+
+// A rectangle of elements in memory that stores rows one after the
+// other, Stride elements apart. The view doesn't own the elements, use
+// ArrayView2D<const T> for read-only access.
+// Slicing a sub-rectangle keeps the stride, so it never copies.
+// Element access is bounds checked, use Row for unchecked inner loops.
+template<typename T>
+class ArrayView2D {
+public:
+	ArrayView2D();
+	ArrayView2D(T* data, uint32 width, uint32 height);
+	ArrayView2D(T* data, uint32 width, uint32 height, uint32 stride);
+	ArrayView2D(Array<T>& array, uint32 width, uint32 height);
+
+	operator ArrayView2D<const T>() const { return ArrayView2D<const T>(ViewData, ViewWidth, ViewHeight, RowStride); }
+
+	T* Data() const { return ViewData; }
+	uint32 Width() const { return ViewWidth; }
+	uint32 Height() const { return ViewHeight; }
+	// The distance between the starts of two rows, in elements
+	uint32 Stride() const { return RowStride; }
+	bool IsValid(uint32 x, uint32 y) const { return x < ViewWidth && y < ViewHeight; }
+
+	T& operator()(uint32 x, uint32 y) const;
+	T* Row(uint32 y) const;
+	ArrayView2D Slice(uint32 x, uint32 y, uint32 width, uint32 height) const;
+
+	// Cuts the view in tiles of at most tileWidth by tileHeight and calls
+	// visit(ArrayView2D<T> tile, uint32 x, uint32 y) for each, with the
+	// position of the tile in this view. Working tile by tile keeps
+	// neighbourhood passes over a big view inside the cache.
+	template<typename F>
+	void ForEachTile(uint32 tileWidth, uint32 tileHeight, F&& visit) const;
+	// Calls visit(uint32 x, uint32 y, T& element) for every element,
+	// tile by tile and row by row inside a tile.
+	template<typename F>
+	void ForEachTiled(uint32 tileSize, F&& visit) const;
+
+private:
+	T* ViewData;
+	uint32 ViewWidth;
+	uint32 ViewHeight;
+	uint32 RowStride;
+};
+
+template<typename T>
+ArrayView2D<T>::ArrayView2D()
+	: ViewData(nullptr)
+	, ViewWidth(0)
+	, ViewHeight(0)
+	, RowStride(0)
+{}
+
+template<typename T>
+ArrayView2D<T>::ArrayView2D(T* data, uint32 width, uint32 height)
+	: ArrayView2D(data, width, height, width)
+{}
+
+template<typename T>
+ArrayView2D<T>::ArrayView2D(T* data, uint32 width, uint32 height, uint32 stride)
+	: ViewData(data)
+	, ViewWidth(width)
+	, ViewHeight(height)
+	, RowStride(stride)
+{
+	CHECK(width <= stride || height <= 1);
+	CHECK(data != nullptr || width * height == 0);
+}
+
+template<typename T>
+ArrayView2D<T>::ArrayView2D(Array<T>& array, uint32 width, uint32 height)
+	: ArrayView2D(array.GetData(), width, height, width)
+{
+	CHECK(uint64(width) * height <= array.Num());
+}
+
+template<typename T>
+T& ArrayView2D<T>::operator()(uint32 x, uint32 y) const
+{
+	CHECK(IsValid(x, y));
+	return ViewData[uint64(y) * RowStride + x];
+}
+
+template<typename T>
+T* ArrayView2D<T>::Row(uint32 y) const
+{
+	CHECK(y < ViewHeight);
+	return &ViewData[uint64(y) * RowStride];
+}
+
+template<typename T>
+ArrayView2D<T> ArrayView2D<T>::Slice(uint32 x, uint32 y, uint32 width, uint32 height) const
+{
+	CHECK(x + width <= ViewWidth && y + height <= ViewHeight);
+	return ArrayView2D(&ViewData[uint64(y) * RowStride + x], width, height, RowStride);
+}
+
+template<typename T>
+template<typename F>
+void ArrayView2D<T>::ForEachTile(uint32 tileWidth, uint32 tileHeight, F&& visit) const
+{
+	CHECK(tileWidth > 0 && tileHeight > 0);
+	for (uint32 y = 0; y < ViewHeight; y += tileHeight) {
+		const uint32 height = Math::Min(tileHeight, ViewHeight - y);
+		for (uint32 x = 0; x < ViewWidth; x += tileWidth) {
+			visit(Slice(x, y, Math::Min(tileWidth, ViewWidth - x), height), x, y);
+		}
+	}
+}
+
+template<typename T>
+template<typename F>
+void ArrayView2D<T>::ForEachTiled(uint32 tileSize, F&& visit) const
+{
+	ForEachTile(tileSize, tileSize, [&visit](const ArrayView2D& tile, uint32 tileX, uint32 tileY) {
+		for (uint32 y = 0; y < tile.Height(); ++y) {
+			T* row = tile.Row(y);
+			for (uint32 x = 0; x < tile.Width(); ++x) {
+				visit(tileX + x, tileY + y, row[x]);
+			}
+		}
+	});
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Containers/View/ArrayView2D.h"
+
+// A box of elements in memory stored as planes of rows, see ArrayView2D.
+// Rows are Stride elements apart and planes PlaneStride elements apart.
+template<typename T>
+class ArrayView3D {
+public:
+	ArrayView3D();
+	ArrayView3D(T* data, uint32 width, uint32 height, uint32 depth);
+	ArrayView3D(T* data, uint32 width, uint32 height, uint32 depth, uint32 stride, uint32 planeStride);
+	ArrayView3D(Array<T>& array, uint32 width, uint32 height, uint32 depth);
+
+	operator ArrayView3D<const T>() const { return ArrayView3D<const T>(ViewData, ViewWidth, ViewHeight, ViewDepth, RowStride, PlaneStride); }
+
+	T* Data() const { return ViewData; }
+	uint32 Width() const { return ViewWidth; }
+	uint32 Height() const { return ViewHeight; }
+	uint32 Depth() const { return ViewDepth; }
+	uint32 Stride() const { return RowStride; }
+	uint32 GetPlaneStride() const { return PlaneStride; }
+	bool IsValid(uint32 x, uint32 y, uint32 z) const { return x < ViewWidth && y < ViewHeight && z < ViewDepth; }
+
+	T& operator()(uint32 x, uint32 y, uint32 z) const;
+	T* Row(uint32 y, uint32 z) const;
+	ArrayView2D<T> Plane(uint32 z) const;
+	ArrayView3D Slice(uint32 x, uint32 y, uint32 z, uint32 width, uint32 height, uint32 depth) const;
+
+	// Calls visit(ArrayView3D<T> tile, uint32 x, uint32 y, uint32 z) for
+	// boxes of at most tileWidth by tileHeight by tileDepth elements.
+	template<typename F>
+	void ForEachTile(uint32 tileWidth, uint32 tileHeight, uint32 tileDepth, F&& visit) const;
+	// Calls visit(uint32 x, uint32 y, uint32 z, T& element) for every
+	// element, tile by tile.
+	template<typename F>
+	void ForEachTiled(uint32 tileSize, F&& visit) const;
+
+private:
+	T* ViewData;
+	uint32 ViewWidth;
+	uint32 ViewHeight;
+	uint32 ViewDepth;
+	uint32 RowStride;
+	uint32 PlaneStride;
+};
+
+template<typename T>
+ArrayView3D<T>::ArrayView3D()
+	: ViewData(nullptr)
+	, ViewWidth(0)
+	, ViewHeight(0)
+	, ViewDepth(0)
+	, RowStride(0)
+	, PlaneStride(0)
+{}
+
+template<typename T>
+ArrayView3D<T>::ArrayView3D(T* data, uint32 width, uint32 height, uint32 depth)
+	: ArrayView3D(data, width, height, depth, width, width * height)
+{}
+
+template<typename T>
+ArrayView3D<T>::ArrayView3D(T* data, uint32 width, uint32 height, uint32 depth, uint32 stride, uint32 planeStride)
+	: ViewData(data)
+	, ViewWidth(width)
+	, ViewHeight(height)
+	, ViewDepth(depth)
+	, RowStride(stride)
+	, PlaneStride(planeStride)
+{
+	CHECK(width <= stride || height * depth <= 1);
+	CHECK(uint64(stride) * height <= planeStride || depth <= 1);
+	CHECK(data != nullptr || uint64(width) * height * depth == 0);
+}
+
+template<typename T>
+ArrayView3D<T>::ArrayView3D(Array<T>& array, uint32 width, uint32 height, uint32 depth)
+	: ArrayView3D(array.GetData(), width, height, depth)
+{
+	CHECK(uint64(width) * height * depth <= array.Num());
+}
+
+template<typename T>
+T& ArrayView3D<T>::operator()(uint32 x, uint32 y, uint32 z) const
+{
+	CHECK(IsValid(x, y, z));
+	return ViewData[uint64(z) * PlaneStride + uint64(y) * RowStride + x];
+}
+
+template<typename T>
+T* ArrayView3D<T>::Row(uint32 y, uint32 z) const
+{
+	CHECK(y < ViewHeight && z < ViewDepth);
+	return &ViewData[uint64(z) * PlaneStride + uint64(y) * RowStride];
+}
+
+template<typename T>
+ArrayView2D<T> ArrayView3D<T>::Plane(uint32 z) const
+{
+	CHECK(z < ViewDepth);
+	return ArrayView2D<T>(&ViewData[uint64(z) * PlaneStride], ViewWidth, ViewHeight, RowStride);
+}
+
+template<typename T>
+ArrayView3D<T> ArrayView3D<T>::Slice(uint32 x, uint32 y, uint32 z, uint32 width, uint32 height, uint32 depth) const
+{
+	CHECK(x + width <= ViewWidth && y + height <= ViewHeight && z + depth <= ViewDepth);
+	return ArrayView3D(&ViewData[uint64(z) * PlaneStride + uint64(y) * RowStride + x],
+		width, height, depth, RowStride, PlaneStride);
+}
+
+template<typename T>
+template<typename F>
+void ArrayView3D<T>::ForEachTile(uint32 tileWidth, uint32 tileHeight, uint32 tileDepth, F&& visit) const
+{
+	CHECK(tileWidth > 0 && tileHeight > 0 && tileDepth > 0);
+	for (uint32 z = 0; z < ViewDepth; z += tileDepth) {
+		const uint32 depth = Math::Min(tileDepth, ViewDepth - z);
+		for (uint32 y = 0; y < ViewHeight; y += tileHeight) {
+			const uint32 height = Math::Min(tileHeight, ViewHeight - y);
+			for (uint32 x = 0; x < ViewWidth; x += tileWidth) {
+				visit(Slice(x, y, z, Math::Min(tileWidth, ViewWidth - x), height, depth), x, y, z);
+			}
+		}
+	}
+}
+
+template<typename T>
+template<typename F>
+void ArrayView3D<T>::ForEachTiled(uint32 tileSize, F&& visit) const
+{
+	ForEachTile(tileSize, tileSize, tileSize, [&visit](const ArrayView3D& tile, uint32 tileX, uint32 tileY, uint32 tileZ) {
+		for (uint32 z = 0; z < tile.Depth(); ++z) {
+			for (uint32 y = 0; y < tile.Height(); ++y) {
+				T* row = tile.Row(y, z);
+				for (uint32 x = 0; x < tile.Width(); ++x) {
+					visit(tileX + x, tileY + y, tileZ + z, row[x]);
+				}
+			}
+		}
+	});
+}
\ No newline at end of file
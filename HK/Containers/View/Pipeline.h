@@ -0,0 +1,403 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Common/Math.h"
+#include "Common/Types.h"
+#include "Containers/Array.h"
+#include "Containers/View/ArrayView.h"
+#include "Containers/View/StringView.h"
+
+// Lazy pipelines over views, built by chaining adaptors onto a source:
+//
+//	Array<int64> values;
+//	Pipeline::Split(line, ',')
+//		.Filter([](StringView s) { return s.Size() > 0; })
+//		.Map([](StringView s) { int64 v = 0; s.ParseAsInt(v, 10); return v; })
+//		.CollectInto(values);
+//
+// Adaptors are small objects that hold their input by value, nothing
+// runs until a terminal like ForEach or CollectInto. Items are pushed
+// from the source through every stage into the terminal, so the whole
+// chain inlines into a single loop without intermediate arrays or heap
+// allocations. Each stage calls its sink with an item and stops pulling
+// from its input as soon as a sink returns false.
+// Stages whose output count follows from their input, like Map or
+// Take, know their size up front so CollectInto reserves exactly once.
+namespace Pipeline
+{
+	// The value type of an item, the structs below hold copies so they
+	// outlive the stage that made them.
+	template<typename T>
+	using ValueOf = typename RemoveCV<typename RemoveReference<T>::Type>::Type;
+
+	template<typename TItem>
+	struct Indexed {
+		uint32 Index;
+		TItem Value;
+	};
+
+	template<typename TFirst, typename TSecond>
+	struct Zipped {
+		TFirst First;
+		TSecond Second;
+	};
+
+	template<typename TInner, typename F> class MapStage;
+	template<typename TInner, typename F> class FilterStage;
+	template<typename TInner> class EnumerateStage;
+	template<typename TInner> class TakeStage;
+	template<typename TInner, typename T> class ZipStage;
+
+	// The chaining methods and terminals shared by every stage. A stage
+	// implements Run(sink), HasKnownSize and KnownSize().
+	template<typename TStage>
+	class Stage {
+	public:
+		// Transforms every item with map(item).
+		template<typename F>
+		MapStage<TStage, F> Map(F map) const;
+		// Keeps the items for which filter(item) returns true.
+		template<typename F>
+		FilterStage<TStage, F> Filter(F filter) const;
+		// Pairs a copy of every item with its position as an Indexed.
+		EnumerateStage<TStage> Enumerate() const;
+		// Stops after the first num items.
+		TakeStage<TStage> Take(uint32 num) const;
+		// Pairs a copy of every item with a copy of the element at the
+		// same position in other as a Zipped, and stops when either runs
+		// out.
+		template<typename T>
+		ZipStage<TStage, T> Zip(ArrayView<T> other) const;
+
+		// Calls visit(item) on every item.
+		template<typename F>
+		void ForEach(F&& visit) const;
+		// Adds every item to out.
+		template<typename T>
+		void CollectInto(Array<T>& out) const;
+		uint32 Count() const;
+
+	private:
+		const TStage& Self() const { return static_cast<const TStage&>(*this); }
+	};
+
+	template<typename T>
+	class ViewStage : public Stage<ViewStage<T>> {
+	public:
+		static constexpr bool HasKnownSize = true;
+
+		ViewStage(ArrayView<T> view) : View(view) {}
+		uint32 KnownSize() const { return View.Size(); }
+
+		template<typename F>
+		void Run(F&& sink) const
+		{
+			const T* data = View.ConstData();
+			const uint32 num = View.Size();
+			for (uint32 i = 0; i < num; ++i) {
+				if (!sink(data[i])) {
+					return;
+				}
+			}
+		}
+
+	private:
+		ArrayView<T> View;
+	};
+
+	// Yields consecutive ArrayViews of num elements, the last one may be
+	// shorter.
+	template<typename T>
+	class ChunkStage : public Stage<ChunkStage<T>> {
+	public:
+		static constexpr bool HasKnownSize = true;
+
+		ChunkStage(ArrayView<T> view, uint32 num) : View(view), ChunkNum(num) { CHECK(num > 0); }
+		uint32 KnownSize() const { return (View.Size() + ChunkNum - 1) / ChunkNum; }
+
+		template<typename F>
+		void Run(F&& sink) const
+		{
+			const T* data = View.ConstData();
+			const uint32 num = View.Size();
+			for (uint32 start = 0; start < num; start += ChunkNum) {
+				if (!sink(ArrayView<T>(&data[start], Math::Min(ChunkNum, num - start)))) {
+					return;
+				}
+			}
+		}
+
+	private:
+		ArrayView<T> View;
+		uint32 ChunkNum;
+	};
+
+	// Splits a string on a delimiter without allocating, yielding the
+	// same pieces as StringView::Split. Besides being a pipeline source
+	// it can be stepped through by hand with Next, or with a range-for.
+	class SplitIter : public Stage<SplitIter> {
+	public:
+		static constexpr bool HasKnownSize = false;
+
+		SplitIter(StringView source, char8 delimiter) : Source(source), Position(0), Delimiter(delimiter) {}
+		uint32 KnownSize() const { return 0; }
+
+		// Returns false once every piece has been returned.
+		bool Next(StringView& outPiece)
+		{
+			const uint32 size = Source.Size();
+			if (Position >= size) {
+				return false;
+			}
+			const char8* data = Source.Data();
+			uint32 end = Position;
+			while (end < size && data[end] != Delimiter) {
+				++end;
+			}
+			outPiece = StringView(&data[Position], end - Position);
+			Position = end + 1;
+			return true;
+		}
+
+		template<typename F>
+		void Run(F&& sink) const
+		{
+			SplitIter iter = *this;
+			StringView piece;
+			while (iter.Next(piece) && sink(piece)) {
+			}
+		}
+
+		class Iterator {
+		public:
+			Iterator(SplitIter* iter) : Iter(iter) { Advance(); }
+			StringView operator*() const { return Piece; }
+			Iterator& operator++() { Advance(); return *this; }
+			bool operator!=(const Iterator& other) const { return Iter != other.Iter; }
+		private:
+			void Advance() { if (Iter != nullptr && !Iter->Next(Piece)) Iter = nullptr; }
+			SplitIter* Iter;
+			StringView Piece;
+		};
+		Iterator begin() { return Iterator(this); }
+		Iterator end() { return Iterator(nullptr); }
+
+	private:
+		StringView Source;
+		uint32 Position;
+		char8 Delimiter;
+	};
+
+	template<typename TInner, typename F>
+	class MapStage : public Stage<MapStage<TInner, F>> {
+	public:
+		static constexpr bool HasKnownSize = TInner::HasKnownSize;
+
+		MapStage(const TInner& inner, F map) : Inner(inner), MapItem(map) {}
+		uint32 KnownSize() const { return Inner.KnownSize(); }
+
+		template<typename S>
+		void Run(S&& sink) const
+		{
+			Inner.Run([&](auto&& item) { return sink(MapItem(Forward<decltype(item)>(item))); });
+		}
+
+	private:
+		TInner Inner;
+		F MapItem;
+	};
+
+	template<typename TInner, typename F>
+	class FilterStage : public Stage<FilterStage<TInner, F>> {
+	public:
+		static constexpr bool HasKnownSize = false;
+
+		FilterStage(const TInner& inner, F filter) : Inner(inner), KeepItem(filter) {}
+		uint32 KnownSize() const { return 0; }
+
+		template<typename S>
+		void Run(S&& sink) const
+		{
+			Inner.Run([&](auto&& item) { return !KeepItem(item) || sink(Forward<decltype(item)>(item)); });
+		}
+
+	private:
+		TInner Inner;
+		F KeepItem;
+	};
+
+	template<typename TInner>
+	class EnumerateStage : public Stage<EnumerateStage<TInner>> {
+	public:
+		static constexpr bool HasKnownSize = TInner::HasKnownSize;
+
+		EnumerateStage(const TInner& inner) : Inner(inner) {}
+		uint32 KnownSize() const { return Inner.KnownSize(); }
+
+		template<typename S>
+		void Run(S&& sink) const
+		{
+			uint32 index = 0;
+			Inner.Run([&](auto&& item) {
+				return sink(Indexed<ValueOf<decltype(item)>>{ index++, Forward<decltype(item)>(item) });
+			});
+		}
+
+	private:
+		TInner Inner;
+	};
+
+	template<typename TInner>
+	class TakeStage : public Stage<TakeStage<TInner>> {
+	public:
+		static constexpr bool HasKnownSize = TInner::HasKnownSize;
+
+		TakeStage(const TInner& inner, uint32 num) : Inner(inner), TakeNum(num) {}
+		uint32 KnownSize() const { return Math::Min(TakeNum, Inner.KnownSize()); }
+
+		template<typename S>
+		void Run(S&& sink) const
+		{
+			if (TakeNum == 0) {
+				return;
+			}
+			uint32 taken = 0;
+			Inner.Run([&](auto&& item) {
+				return sink(Forward<decltype(item)>(item)) && ++taken < TakeNum;
+			});
+		}
+
+	private:
+		TInner Inner;
+		uint32 TakeNum;
+	};
+
+	template<typename TInner, typename T>
+	class ZipStage : public Stage<ZipStage<TInner, T>> {
+	public:
+		static constexpr bool HasKnownSize = TInner::HasKnownSize;
+
+		ZipStage(const TInner& inner, ArrayView<T> other) : Inner(inner), Other(other) {}
+		uint32 KnownSize() const { return Math::Min(Inner.KnownSize(), Other.Size()); }
+
+		template<typename S>
+		void Run(S&& sink) const
+		{
+			const T* data = Other.ConstData();
+			const uint32 num = Other.Size();
+			if (num == 0) {
+				return;
+			}
+			uint32 index = 0;
+			Inner.Run([&](auto&& item) {
+				const T& other = data[index];
+				return sink(Zipped<ValueOf<decltype(item)>, ValueOf<T>>{ Forward<decltype(item)>(item), other }) && ++index < num;
+			});
+		}
+
+	private:
+		TInner Inner;
+		ArrayView<T> Other;
+	};
+
+	template<typename T>
+	ViewStage<T> From(ArrayView<T> view)
+	{
+		return ViewStage<T>(view);
+	}
+
+	template<typename T>
+	ViewStage<T> From(const Array<T>& array)
+	{
+		return ViewStage<T>(array.View());
+	}
+
+	template<typename T>
+	ChunkStage<T> Chunk(ArrayView<T> view, uint32 num)
+	{
+		return ChunkStage<T>(view, num);
+	}
+
+	template<typename A, typename B>
+	ZipStage<ViewStage<A>, B> Zip(ArrayView<A> first, ArrayView<B> second)
+	{
+		return From(first).Zip(second);
+	}
+
+	inline SplitIter Split(StringView source, char8 delimiter)
+	{
+		return SplitIter(source, delimiter);
+	}
+
+	template<typename TStage>
+	template<typename F>
+	MapStage<TStage, F> Stage<TStage>::Map(F map) const
+	{
+		return MapStage<TStage, F>(Self(), map);
+	}
+
+	template<typename TStage>
+	template<typename F>
+	FilterStage<TStage, F> Stage<TStage>::Filter(F filter) const
+	{
+		return FilterStage<TStage, F>(Self(), filter);
+	}
+
+	template<typename TStage>
+	EnumerateStage<TStage> Stage<TStage>::Enumerate() const
+	{
+		return EnumerateStage<TStage>(Self());
+	}
+
+	template<typename TStage>
+	TakeStage<TStage> Stage<TStage>::Take(uint32 num) const
+	{
+		return TakeStage<TStage>(Self(), num);
+	}
+
+	template<typename TStage>
+	template<typename T>
+	ZipStage<TStage, T> Stage<TStage>::Zip(ArrayView<T> other) const
+	{
+		return ZipStage<TStage, T>(Self(), other);
+	}
+
+	template<typename TStage>
+	template<typename F>
+	void Stage<TStage>::ForEach(F&& visit) const
+	{
+		Self().Run([&](auto&& item) {
+			visit(Forward<decltype(item)>(item));
+			return true;
+		});
+	}
+
+	template<typename TStage>
+	template<typename T>
+	void Stage<TStage>::CollectInto(Array<T>& out) const
+	{
+		if constexpr (TStage::HasKnownSize) {
+			out.Reserve(Self().KnownSize());
+		}
+		Self().Run([&](auto&& item) {
+			out.Add(Forward<decltype(item)>(item));
+			return true;
+		});
+	}
+
+	template<typename TStage>
+	uint32 Stage<TStage>::Count() const
+	{
+		if constexpr (TStage::HasKnownSize) {
+			return Self().KnownSize();
+		}
+		uint32 num = 0;
+		Self().Run([&num](auto&&) {
+			++num;
+			return true;
+		});
+		return num;
+	}
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "CSV.h"
 #include "Bench/Bench.h"
 #include "Common/StringUtil.h"
+#include "Containers/View/Pipeline.h"
 
 static String LastError;
 
@@ -46,16 +47,15 @@ bool GCSVReader::ParseHeader(StringView& csv, Array<int32>& outPropertyIndices,
 	StringView header = csv.Substring(0, firstLine);
 	csv = csv.ChopLeft(firstLine + 1);
 	
-	Array<StringView> headers = header.Split(',');
 	Set<ColumnName> foundHeaders;
 	
-	for (uint32 i=0; i<headers.Num(); ++i)
+	uint32 headerIndex = 0;
+	for (StringView h : Pipeline::Split(header, ','))
 	{
-		StringView h = headers[i];
 		h.Trim();
 		if (h.Size() == 0)
 		{
-			LastError = String::Format("The '{}'th header is empty"_sv, i);
+			LastError = String::Format("The '{}'th header is empty"_sv, headerIndex);
 			return false;
 		}
 		
@@ -77,6 +77,7 @@ bool GCSVReader::ParseHeader(StringView& csv, Array<int32>& outPropertyIndices,
 		{
 			outPropertyIndices.Add((int32)*propertyIndex);
 		}
+		++headerIndex;
 	}
 	
 	// We may have properties that are required but not in the CSV
@@ -36,7 +36,7 @@ bool File::Create(bool bReadOnly) {
 		return false;
 	}
 	
-	FileHandle = open(Path.AsCString(), bReadOnly ? O_RDONLY : O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR);
+	FileHandle = open(Path.AsCString(), bReadOnly ? O_RDONLY : O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
 	if (FileHandle == -1) {
 		FileHandle = 0;
 		bCheckedExists = true;
@@ -0,0 +1,35 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "MappedFile.h"
+
+#include "Common/CompilerMacros.h"
+
+MappedFile::MappedFile(const FilePath& path)
+	: Path(path)
+	, Data(nullptr)
+	, Size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::IsOpen() const
+{
+	return Data != nullptr;
+}
+
+const uint8* MappedFile::GetData() const
+{
+	CHECK(IsOpen());
+	return Data;
+}
+
+uint64 MappedFile::GetSize() const
+{
+	CHECK(IsOpen());
+	return Size;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+// A whole file mapped read-only into memory. The OS loads pages on
+// first access, so opening costs nothing up front and nothing is copied.
+
+#include "Common/Types.h"
+#include "FilePath.h"
+
+class MappedFile {
+public:
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	
+	MappedFile(const FilePath& path);
+	~MappedFile();
+	
+	// Fails for files that don't exist or are empty
+	bool Open();
+	void Close();
+	
+	bool IsOpen() const;
+	// Page aligned, valid until the file is closed
+	const uint8* GetData() const;
+	uint64 GetSize() const;
+	
+protected:
+	FilePath Path;
+	const uint8* Data;
+	uint64 Size;
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Common/CompilerMacros.h"
+
+#if PLATFORM == PLATFORM_LINUX
+
+#include "MappedFile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+bool MappedFile::Open() {
+	if (Data != nullptr) {
+		return false;
+	}
+	
+	const int32 handle = open(Path.AsCString(), O_RDONLY);
+	if (handle == -1) {
+		return false;
+	}
+	
+	struct stat st;
+	if (fstat(handle, &st) != 0 || st.st_size == 0) {
+		close(handle);
+		return false;
+	}
+	
+	// The mapping keeps the file alive after the descriptor is closed
+	void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, handle, 0);
+	close(handle);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+	
+	Data = static_cast<const uint8*>(data);
+	Size = st.st_size;
+	return true;
+}
+
+void MappedFile::Close() {
+	if (Data != nullptr) {
+		munmap(const_cast<uint8*>(Data), Size);
+	}
+	Data = nullptr;
+	Size = 0;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Common/CompilerMacros.h"
+
+#if PLATFORM == PLATFORM_WINDOWS
+
+#include "MappedFile.h"
+
+#include <windows.h>
+
+bool MappedFile::Open() {
+	if (Data != nullptr) {
+		return false;
+	}
+	
+	HANDLE file = CreateFileA(Path.AsCString(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	
+	// The view keeps the mapping and the file alive after their
+	// handles are closed.
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr) {
+		return false;
+	}
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == nullptr) {
+		return false;
+	}
+	
+	Data = static_cast<const uint8*>(data);
+	Size = size.QuadPart;
+	return true;
+}
+
+void MappedFile::Close() {
+	if (Data != nullptr) {
+		UnmapViewOfFile(Data);
+	}
+	Data = nullptr;
+	Size = 0;
+}
+
+#endif
\ No newline at end of file
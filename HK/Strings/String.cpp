@@ -5,6 +5,7 @@
 
 #include "Allocators/Memory.h"
 #include "Common/CompilerMacros.h"
+#include "Util/Hasher.h"
 
 uint8 CurrentBuffer = 0;
 const uint32 BufferCount = 16;
@@ -192,6 +193,10 @@ bool AnsiString::ParseAsInt(int64& result, uint32 base) const {
 	return AsView().ParseAsInt(result, base);
 }
 
+void AnsiString::Hash(Hasher& hasher) const {
+	hasher.HashItem(AsView());
+}
+
 void AnsiString::EnsureNullTerminated() {
 	if ((ArrayNum < ArrayMax) && (Data[ArrayNum] == '\0'))
 		return;
@@ -9,6 +9,8 @@
 
 // TODO (HvdK): UTF-8
 
+class Hasher;
+
 struct Format
 {
 public:
@@ -99,6 +101,10 @@ public:
 	static AnsiString Repeated(const char8 c, uint32 count);
 	
 	bool ParseAsInt(int64& result, uint32 base) const;
+	
+	// Hashes identically to the StringView of this string, so
+	// containers keyed on String can be probed with a StringView.
+	void Hash(Hasher& hasher) const;
 
 protected:
 	void EnsureNullTerminated();
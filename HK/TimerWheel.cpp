@@ -0,0 +1,247 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "TimerWheel.h"
+#include "Common/Math.h"
+
+TimerWheel::TimerWheel(uint64 startTime)
+	: Overflow(nullptr)
+	, Firing(nullptr)
+	, CurrentTime(startTime)
+	, NumTimers(0)
+	, bAdvancing(false)
+{
+	Memory::FillZero(Slots, sizeof(Slots));
+	Memory::FillZero(Occupied, sizeof(Occupied));
+}
+
+TimerHandle TimerWheel::Schedule(uint64 deadline, void (*function)(void*), void* context, const void* object)
+{
+	TimerWheelNode* node = AllocateNode();
+	node->Deadline = Math::Max(deadline, CurrentTime + 1);
+	node->Callback = DelegateEntry(object, function, context);
+	Insert(node);
+	++NumTimers;
+
+	TimerHandle handle;
+	handle.Node = node;
+	handle.Generation = node->Generation;
+	return handle;
+}
+
+TimerHandle TimerWheel::ScheduleAfter(uint64 delay, void (*function)(void*), void* context, const void* object)
+{
+	return Schedule(CurrentTime + delay, function, context, object);
+}
+
+bool TimerWheel::Cancel(TimerHandle handle)
+{
+	if (!IsScheduled(handle)) {
+		return false;
+	}
+	Unlink(handle.Node);
+	FreeNode(handle.Node);
+	return true;
+}
+
+void TimerWheel::CancelAll(const void* object)
+{
+	auto cancelInList = [this, object](TimerWheelNode* node) {
+		while (node != nullptr) {
+			TimerWheelNode* next = node->Next;
+			if (node->Callback.Object == object) {
+				Unlink(node);
+				FreeNode(node);
+			}
+			node = next;
+		}
+	};
+	for (uint32 level = 0; level < NumLevels; ++level) {
+		for (uint32 slot = 0; slot < NumSlots; ++slot) {
+			cancelInList(Slots[level][slot]);
+		}
+	}
+	cancelInList(Overflow);
+	cancelInList(Firing);
+}
+
+void TimerWheel::Clear()
+{
+	auto freeList = [this](TimerWheelNode*& list) {
+		while (list != nullptr) {
+			TimerWheelNode* next = list->Next;
+			FreeNode(list);
+			list = next;
+		}
+	};
+	for (uint32 level = 0; level < NumLevels; ++level) {
+		for (uint32 slot = 0; slot < NumSlots; ++slot) {
+			freeList(Slots[level][slot]);
+		}
+		Occupied[level] = 0;
+	}
+	freeList(Overflow);
+	freeList(Firing);
+}
+
+uint32 TimerWheel::Advance(uint64 now)
+{
+	CHECK(!bAdvancing);
+	bAdvancing = true;
+	uint32 numFired = 0;
+	for (;;) {
+		const uint64 time = GetNextEventTime();
+		if (time > now) {
+			break;
+		}
+		CurrentTime = time;
+
+		// Move timers down from the top, a timer due now may fall
+		// through every level on the way to the slot that fires.
+		if (Overflow != nullptr && (time & ((uint64(1) << (NumLevels * SlotBits)) - 1)) == 0) {
+			TimerWheelNode* list = Overflow;
+			Overflow = nullptr;
+			Reinsert(list);
+		}
+		for (uint32 level = NumLevels - 1; level > 0; --level) {
+			if ((time & ((uint64(1) << (level * SlotBits)) - 1)) != 0) {
+				continue;
+			}
+			const uint32 slot = (time >> (level * SlotBits)) & (NumSlots - 1);
+			if ((Occupied[level] >> slot) & 1) {
+				TimerWheelNode* list = Slots[level][slot];
+				Slots[level][slot] = nullptr;
+				Occupied[level] &= ~(uint64(1) << slot);
+				Reinsert(list);
+			}
+		}
+		numFired += FireSlot(time & (NumSlots - 1));
+	}
+	CurrentTime = Math::Max(CurrentTime, now);
+	bAdvancing = false;
+	return numFired;
+}
+
+bool TimerWheel::IsScheduled(TimerHandle handle) const
+{
+	return handle.Node != nullptr && handle.Node->Generation == handle.Generation;
+}
+
+uint64 TimerWheel::GetTime() const
+{
+	return CurrentTime;
+}
+
+uint32 TimerWheel::Num() const
+{
+	return NumTimers;
+}
+
+TimerWheelNode* TimerWheel::AllocateNode()
+{
+	if (FreeNodes.Num() > 0) {
+		return FreeNodes.Pop();
+	}
+	TimerWheelNode* node = Nodes.Allocate();
+	node->Generation = 0;
+	return node;
+}
+
+void TimerWheel::Insert(TimerWheelNode* node)
+{
+	const uint64 difference = node->Deadline ^ CurrentTime;
+	TimerWheelNode** head;
+	if (difference >> (NumLevels * SlotBits) != 0) {
+		node->Level = OverflowLevel;
+		node->Slot = 0;
+		head = &Overflow;
+	} else {
+		const uint32 level = difference == 0 ? 0 : (63 - Math::CountLeadingZeros(difference)) / SlotBits;
+		const uint32 slot = (node->Deadline >> (level * SlotBits)) & (NumSlots - 1);
+		node->Level = uint8(level);
+		node->Slot = uint8(slot);
+		head = &Slots[level][slot];
+		Occupied[level] |= uint64(1) << slot;
+	}
+	node->Next = *head;
+	node->PrevNext = head;
+	if (*head != nullptr) {
+		(*head)->PrevNext = &node->Next;
+	}
+	*head = node;
+}
+
+void TimerWheel::Unlink(TimerWheelNode* node)
+{
+	*node->PrevNext = node->Next;
+	if (node->Next != nullptr) {
+		node->Next->PrevNext = node->PrevNext;
+	}
+	// Firing nodes keep the slot they came from, which is already clear
+	if (node->Level != OverflowLevel && Slots[node->Level][node->Slot] == nullptr) {
+		Occupied[node->Level] &= ~(uint64(1) << node->Slot);
+	}
+}
+
+void TimerWheel::FreeNode(TimerWheelNode* node)
+{
+	++node->Generation;
+	FreeNodes.Add(node);
+	--NumTimers;
+}
+
+void TimerWheel::Reinsert(TimerWheelNode* list)
+{
+	while (list != nullptr) {
+		TimerWheelNode* next = list->Next;
+		Insert(list);
+		list = next;
+	}
+}
+
+uint64 TimerWheel::GetNextEventTime() const
+{
+	// Every timer of a level is due before the next slot of the level
+	// above starts, so the first level with a slot ahead wins.
+	for (uint32 level = 0; level < NumLevels; ++level) {
+		const uint32 shift = level * SlotBits;
+		const uint32 current = (CurrentTime >> shift) & (NumSlots - 1);
+		const uint64 ahead = Occupied[level] & ~((uint64(2) << current) - 1);
+		if (ahead != 0) {
+			const uint64 turn = CurrentTime >> (shift + SlotBits) << (shift + SlotBits);
+			return turn | (uint64(Math::CountTrailingZeros(ahead)) << shift);
+		}
+	}
+	if (Overflow != nullptr) {
+		const uint32 shift = NumLevels * SlotBits;
+		return ((CurrentTime >> shift) + 1) << shift;
+	}
+	return ~uint64(0);
+}
+
+uint32 TimerWheel::FireSlot(uint32 slot)
+{
+	if (((Occupied[0] >> slot) & 1) == 0) {
+		return 0;
+	}
+	Firing = Slots[0][slot];
+	Firing->PrevNext = &Firing;
+	Slots[0][slot] = nullptr;
+	Occupied[0] &= ~(uint64(1) << slot);
+
+	// Timers scheduled by the callbacks are due at a later tick, so they
+	// never land in the list that's firing.
+	uint32 numFired = 0;
+	while (Firing != nullptr) {
+		TimerWheelNode* node = Firing;
+		Firing = node->Next;
+		if (Firing != nullptr) {
+			Firing->PrevNext = &Firing;
+		}
+		const DelegateEntry callback = node->Callback;
+		FreeNode(node);
+		callback.Function(callback.Context);
+		++numFired;
+	}
+	return numFired;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Allocators/Pool.h"
+#include "Common/Types.h"
+#include "Delegate.h"
+
+struct TimerWheelNode
+{
+	uint64 Deadline;
+	DelegateEntry Callback;
+	TimerWheelNode* Next;
+	// The Next of the previous node, or the head of the list
+	TimerWheelNode** PrevNext;
+	// Bumped when the timer fires or is cancelled, so old handles fail
+	uint32 Generation;
+	uint8 Level;
+	uint8 Slot;
+};
+
+// Refers to a scheduled timer, see TimerWheel::Cancel
+struct TimerHandle
+{
+	TimerWheelNode* Node = nullptr;
+	uint32 Generation = 0;
+};
+
+// Schedules callbacks at a time in the future, in ticks of whatever
+// clock the owner advances it with: a game frame counter, or
+// Platform::GetTicks shifted down to the resolution that's needed.
+// Timers hang in hierarchical wheels of 64 slots, where a level's slot
+// spans a whole turn of the level below. A timer sits in the level of
+// the highest 6 bits in which its deadline differs from the current
+// time, and drops a level each time the current time reaches the start
+// of its slot, so scheduling and cancelling are O(1) and a timer moves
+// at most once per level. Deadlines beyond the top level wait in a list
+// that is sorted into the wheels every 2^36 ticks.
+// Advance skips empty slots with a bit mask per level, so stepping over
+// a long quiet stretch costs a few bit scans rather than a step per tick.
+class TimerWheel
+{
+public:
+	static constexpr uint32 NumLevels = 6;
+	static constexpr uint32 SlotBits = 6;
+	static constexpr uint32 NumSlots = 1 << SlotBits;
+
+	TimerWheel(uint64 startTime = 0);
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	// Calls function(context) from the Advance that reaches deadline.
+	// Deadlines that already passed fire on the next tick. The object is
+	// kept like in Delegate, to tell owners apart in CancelAll.
+	TimerHandle Schedule(uint64 deadline, void (*function)(void*), void* context, const void* object = nullptr);
+	TimerHandle ScheduleAfter(uint64 delay, void (*function)(void*), void* context, const void* object = nullptr);
+	// Returns false when the timer already fired or was cancelled
+	bool Cancel(TimerHandle handle);
+	// Cancels every timer scheduled with object, by visiting all timers
+	void CancelAll(const void* object);
+	void Clear();
+
+	// Fires every timer with a deadline up to now, earlier deadlines
+	// first, and returns how many fired. Callbacks may schedule and
+	// cancel timers, but must not call Advance.
+	uint32 Advance(uint64 now);
+
+	bool IsScheduled(TimerHandle handle) const;
+	uint64 GetTime() const;
+	uint32 Num() const;
+
+private:
+	static constexpr uint8 OverflowLevel = NumLevels;
+
+	TimerWheelNode* AllocateNode();
+	void Insert(TimerWheelNode* node);
+	void Unlink(TimerWheelNode* node);
+	void FreeNode(TimerWheelNode* node);
+	// Moves the timers of a list into the wheels from the current time
+	void Reinsert(TimerWheelNode* list);
+	// The next time at which a slot has to be fired or moved down,
+	// which is later than now when nothing happens until then.
+	uint64 GetNextEventTime() const;
+	uint32 FireSlot(uint32 slot);
+
+	TimerWheelNode* Slots[NumLevels][NumSlots];
+	// A bit per slot with timers
+	uint64 Occupied[NumLevels];
+	TimerWheelNode* Overflow;
+	// The timers of the slot that is firing, which callbacks may cancel
+	TimerWheelNode* Firing;
+	// Everything up to and including this time has fired
+	uint64 CurrentTime;
+	uint32 NumTimers;
+	bool bAdvancing;
+	Pool<TimerWheelNode> Nodes;
+	// Nodes of timers that fired or were cancelled. They don't go back to
+	// the pool, which can't tell them from fresh nodes, so they keep the
+	// generation that invalidated their handles.
+	Array<TimerWheelNode*> FreeNodes;
+};
\ No newline at end of file
@@ -0,0 +1,216 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Common/CompilerMacros.h"
+#include "Common/Types.h"
+
+enum class EMemoryOrder
+{
+	Relaxed,
+	Acquire,
+	Release,
+	AcqRel,
+	SeqCst,
+};
+
+// A 4 or 8 byte value that is read and written atomically, implemented
+// on the compiler intrinsics to stay clear of <atomic>.
+// Fetch operations are only meaningful for integer types.
+template<typename T>
+class Atomic {
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Atomic only supports 4 and 8 byte types");
+public:
+	Atomic() : Value(T()) {}
+	Atomic(T value) : Value(value) {}
+	Atomic(const Atomic&) = delete;
+	Atomic& operator=(const Atomic&) = delete;
+
+	T Load(EMemoryOrder order = EMemoryOrder::SeqCst) const;
+	void Store(T value, EMemoryOrder order = EMemoryOrder::SeqCst);
+	T Exchange(T value, EMemoryOrder order = EMemoryOrder::SeqCst);
+	// Stores desired and returns true if the value equals expected,
+	// otherwise returns false and loads the current value into expected.
+	bool CompareExchange(T& expected, T desired, EMemoryOrder order = EMemoryOrder::SeqCst);
+	T FetchAdd(T value, EMemoryOrder order = EMemoryOrder::SeqCst);
+	T FetchSub(T value, EMemoryOrder order = EMemoryOrder::SeqCst);
+	T FetchOr(T value, EMemoryOrder order = EMemoryOrder::SeqCst);
+	T FetchAnd(T value, EMemoryOrder order = EMemoryOrder::SeqCst);
+
+private:
+	T Value;
+};
+
+#ifdef GCC
+
+constexpr int ToBuiltinMemoryOrder(EMemoryOrder order)
+{
+	return order == EMemoryOrder::Relaxed ? __ATOMIC_RELAXED
+		: order == EMemoryOrder::Acquire ? __ATOMIC_ACQUIRE
+		: order == EMemoryOrder::Release ? __ATOMIC_RELEASE
+		: order == EMemoryOrder::AcqRel ? __ATOMIC_ACQ_REL
+		: __ATOMIC_SEQ_CST;
+}
+
+template<typename T>
+T Atomic<T>::Load(EMemoryOrder order) const
+{
+	return __atomic_load_n(&Value, ToBuiltinMemoryOrder(order));
+}
+
+template<typename T>
+void Atomic<T>::Store(T value, EMemoryOrder order)
+{
+	__atomic_store_n(&Value, value, ToBuiltinMemoryOrder(order));
+}
+
+template<typename T>
+T Atomic<T>::Exchange(T value, EMemoryOrder order)
+{
+	return __atomic_exchange_n(&Value, value, ToBuiltinMemoryOrder(order));
+}
+
+template<typename T>
+bool Atomic<T>::CompareExchange(T& expected, T desired, EMemoryOrder order)
+{
+	// The failure order may not be a release order
+	const int failure = (order == EMemoryOrder::Release || order == EMemoryOrder::Relaxed) ? __ATOMIC_RELAXED
+		: order == EMemoryOrder::SeqCst ? __ATOMIC_SEQ_CST : __ATOMIC_ACQUIRE;
+	return __atomic_compare_exchange_n(&Value, &expected, desired, false, ToBuiltinMemoryOrder(order), failure);
+}
+
+template<typename T>
+T Atomic<T>::FetchAdd(T value, EMemoryOrder order)
+{
+	return __atomic_fetch_add(&Value, value, ToBuiltinMemoryOrder(order));
+}
+
+template<typename T>
+T Atomic<T>::FetchSub(T value, EMemoryOrder order)
+{
+	return __atomic_fetch_sub(&Value, value, ToBuiltinMemoryOrder(order));
+}
+
+template<typename T>
+T Atomic<T>::FetchOr(T value, EMemoryOrder order)
+{
+	return __atomic_fetch_or(&Value, value, ToBuiltinMemoryOrder(order));
+}
+
+template<typename T>
+T Atomic<T>::FetchAnd(T value, EMemoryOrder order)
+{
+	return __atomic_fetch_and(&Value, value, ToBuiltinMemoryOrder(order));
+}
+
+#endif
+
+#ifdef MSVC
+
+// Every interlocked operation is a full barrier on x86 and x64, and
+// aligned plain loads and stores already have acquire and release
+// semantics, so only the compiler needs to be kept from reordering.
+template<int Size>
+struct AtomicImpl;
+
+template<>
+struct AtomicImpl<4> {
+	typedef long Type;
+	static Type Exchange(volatile Type* p, Type v) { return _InterlockedExchange(p, v); }
+	static Type CompareExchange(volatile Type* p, Type v, Type c) { return _InterlockedCompareExchange(p, v, c); }
+	static Type Add(volatile Type* p, Type v) { return _InterlockedExchangeAdd(p, v); }
+	static Type Or(volatile Type* p, Type v) { return _InterlockedOr(p, v); }
+	static Type And(volatile Type* p, Type v) { return _InterlockedAnd(p, v); }
+};
+
+template<>
+struct AtomicImpl<8> {
+	typedef long long Type;
+	static Type Exchange(volatile Type* p, Type v) { return _InterlockedExchange64(p, v); }
+	static Type CompareExchange(volatile Type* p, Type v, Type c) { return _InterlockedCompareExchange64(p, v, c); }
+	static Type Add(volatile Type* p, Type v) { return _InterlockedExchangeAdd64(p, v); }
+	static Type Or(volatile Type* p, Type v) { return _InterlockedOr64(p, v); }
+	static Type And(volatile Type* p, Type v) { return _InterlockedAnd64(p, v); }
+};
+
+template<typename T>
+union AtomicCast {
+	T Value;
+	typename AtomicImpl<sizeof(T)>::Type Raw;
+};
+
+#define __ATOMIC_RAW(x) reinterpret_cast<volatile typename AtomicImpl<sizeof(T)>::Type*>(x)
+
+template<typename T>
+T Atomic<T>::Load(EMemoryOrder order) const
+{
+	AtomicCast<T> cast;
+	cast.Raw = *reinterpret_cast<const volatile typename AtomicImpl<sizeof(T)>::Type*>(&Value);
+	_ReadWriteBarrier();
+	return cast.Value;
+}
+
+template<typename T>
+void Atomic<T>::Store(T value, EMemoryOrder order)
+{
+	if (order == EMemoryOrder::SeqCst) {
+		Exchange(value, order);
+		return;
+	}
+	AtomicCast<T> cast;
+	cast.Value = value;
+	_ReadWriteBarrier();
+	*__ATOMIC_RAW(&Value) = cast.Raw;
+}
+
+template<typename T>
+T Atomic<T>::Exchange(T value, EMemoryOrder order)
+{
+	AtomicCast<T> cast;
+	cast.Value = value;
+	cast.Raw = AtomicImpl<sizeof(T)>::Exchange(__ATOMIC_RAW(&Value), cast.Raw);
+	return cast.Value;
+}
+
+template<typename T>
+bool Atomic<T>::CompareExchange(T& expected, T desired, EMemoryOrder order)
+{
+	AtomicCast<T> compare, exchange, previous;
+	compare.Value = expected;
+	exchange.Value = desired;
+	previous.Raw = AtomicImpl<sizeof(T)>::CompareExchange(__ATOMIC_RAW(&Value), exchange.Raw, compare.Raw);
+	if (previous.Raw == compare.Raw) {
+		return true;
+	}
+	expected = previous.Value;
+	return false;
+}
+
+template<typename T>
+T Atomic<T>::FetchAdd(T value, EMemoryOrder order)
+{
+	return T(AtomicImpl<sizeof(T)>::Add(__ATOMIC_RAW(&Value), typename AtomicImpl<sizeof(T)>::Type(value)));
+}
+
+template<typename T>
+T Atomic<T>::FetchSub(T value, EMemoryOrder order)
+{
+	return T(AtomicImpl<sizeof(T)>::Add(__ATOMIC_RAW(&Value), -typename AtomicImpl<sizeof(T)>::Type(value)));
+}
+
+template<typename T>
+T Atomic<T>::FetchOr(T value, EMemoryOrder order)
+{
+	return T(AtomicImpl<sizeof(T)>::Or(__ATOMIC_RAW(&Value), typename AtomicImpl<sizeof(T)>::Type(value)));
+}
+
+template<typename T>
+T Atomic<T>::FetchAnd(T value, EMemoryOrder order)
+{
+	return T(AtomicImpl<sizeof(T)>::And(__ATOMIC_RAW(&Value), typename AtomicImpl<sizeof(T)>::Type(value)));
+}
+
+#undef __ATOMIC_RAW
+
+#endif
\ No newline at end of file
@@ -18,6 +18,18 @@ public:
 	template<typename V, typename T>
 	static V Hash(const T& item);
 	
+	// Spreads every input bit over the whole output, for users that
+	// split a hash into several independent parts.
+	static constexpr uint64 Mix(uint64 hash)
+	{
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ULL;
+		hash ^= hash >> 33;
+		return hash;
+	}
+	
 	template<typename T>
 	void HashItem(const T& item);
 	void HashItem(const uint8& item);
@@ -65,7 +77,8 @@ V Hasher::Get() const
 	V output = V(0xC4CEB9FE1A85EC53);
 	while (multiple > 0) {
 		output ^= V(state);
-		state >>= sizeof(V) * 8;
+		// Masked so a 64 bit V never shifts by the full width
+		state >>= (sizeof(V) * 8) & 63;
 		--multiple;
 	}
 	return output;
@@ -7,4 +7,10 @@ namespace Platform {
 	// TODO (HvdK): noexcept everywhere?
 	uint64 GetTicks() noexcept;
 	uint64 GetFrequency() noexcept;
+	// Gives up the rest of the time slice of the calling thread
+	void YieldThread() noexcept;
+	// The number of logical cores the process may run on
+	uint32 GetNumCores() noexcept;
+	// Restricts the calling thread to one logical core, returns false if that failed
+	bool PinThreadToCore(uint32 core) noexcept;
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "Platform.h"
 
 #include <time.h>
+#include <sched.h>
+#include <unistd.h>
 
 void Platform::SetDPIAware() {
 	// Do nothing
@@ -20,4 +22,20 @@ uint64 Platform::GetFrequency() noexcept {
 	return 1000000000ULL;
 }
 
+void Platform::YieldThread() noexcept {
+	sched_yield();
+}
+
+uint32 Platform::GetNumCores() noexcept {
+	const long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+	return numCores > 0 ? uint32(numCores) : 1;
+}
+
+bool Platform::PinThreadToCore(uint32 core) noexcept {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
 #endif
\ No newline at end of file
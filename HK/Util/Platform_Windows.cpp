@@ -22,4 +22,18 @@ uint64 Platform::GetFrequency() noexcept {
 	return li.QuadPart;
 }
 
+void Platform::YieldThread() noexcept {
+	SwitchToThread();
+}
+
+uint32 Platform::GetNumCores() noexcept {
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return uint32(info.dwNumberOfProcessors);
+}
+
+bool Platform::PinThreadToCore(uint32 core) noexcept {
+	return core < 64 && SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core) != 0;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "SpinLock.h"
+
+#include "Common/CompilerMacros.h"
+#include "Util/Platform.h"
+
+void SpinWait::Wait()
+{
+	if (LIKELY(Count < 64)) {
+		++Count;
+		CPU_PAUSE;
+	} else {
+		Platform::YieldThread();
+	}
+}
+
+void SpinLock::Lock()
+{
+	SpinWait wait;
+	while (true) {
+		if (Locked.Load(EMemoryOrder::Relaxed) == 0 && TryLock()) {
+			return;
+		}
+		wait.Wait();
+	}
+}
+
+bool SpinLock::TryLock()
+{
+	return Locked.Exchange(1, EMemoryOrder::Acquire) == 0;
+}
+
+void SpinLock::Unlock()
+{
+	Locked.Store(0, EMemoryOrder::Release);
+}
+
+void SharedSpinLock::Lock()
+{
+	SpinWait wait;
+	while (true) {
+		uint32 state = State.Load(EMemoryOrder::Relaxed);
+		if ((state & (WriterBit | ReaderMask)) == 0) {
+			// Taking the lock also clears our pending bit
+			if (State.CompareExchange(state, WriterBit, EMemoryOrder::Acquire)) {
+				return;
+			}
+		} else if ((state & PendingBit) == 0) {
+			State.FetchOr(PendingBit, EMemoryOrder::Relaxed);
+		}
+		wait.Wait();
+	}
+}
+
+void SharedSpinLock::Unlock()
+{
+	State.FetchAnd(~WriterBit, EMemoryOrder::Release);
+}
+
+void SharedSpinLock::LockShared()
+{
+	SpinWait wait;
+	while (true) {
+		uint32 state = State.Load(EMemoryOrder::Relaxed);
+		if ((state & (WriterBit | PendingBit)) == 0) {
+			if (State.CompareExchange(state, state + 1, EMemoryOrder::Acquire)) {
+				return;
+			}
+		}
+		wait.Wait();
+	}
+}
+
+void SharedSpinLock::UnlockShared()
+{
+	State.FetchSub(1, EMemoryOrder::Release);
+}
\ No newline at end of file
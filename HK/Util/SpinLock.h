@@ -0,0 +1,68 @@
+// Copyright (c) 2025, Hidde van der Kooij
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include "Common/Types.h"
+#include "Util/Atomic.h"
+
+// A lock for short critical sections. Waiters spin on a plain load
+// with a pause, and yield their time slice after a while so a holder
+// that got descheduled can finish.
+class SpinLock {
+public:
+	SpinLock() = default;
+	SpinLock(const SpinLock&) = delete;
+	SpinLock& operator=(const SpinLock&) = delete;
+
+	void Lock();
+	bool TryLock();
+	void Unlock();
+
+private:
+	Atomic<uint32> Locked;
+};
+
+// A readers-writer spin lock. Any number of readers may hold it at once,
+// a waiting writer blocks new readers from entering so it isn't starved.
+class SharedSpinLock {
+public:
+	SharedSpinLock() = default;
+	SharedSpinLock(const SharedSpinLock&) = delete;
+	SharedSpinLock& operator=(const SharedSpinLock&) = delete;
+
+	void Lock();
+	void Unlock();
+	void LockShared();
+	void UnlockShared();
+
+private:
+	static constexpr uint32 WriterBit = 0x80000000;
+	static constexpr uint32 PendingBit = 0x40000000;
+	static constexpr uint32 ReaderMask = 0x3FFFFFFF;
+
+	Atomic<uint32> State;
+};
+
+// Backs off a spinning thread, pausing at first and later yielding.
+struct SpinWait {
+	void Wait();
+	uint32 Count = 0;
+};
+
+template<typename L>
+class ScopeLock {
+public:
+	ScopeLock(L& lock) : Lock(lock) { Lock.Lock(); }
+	~ScopeLock() { Lock.Unlock(); }
+private:
+	L& Lock;
+};
+
+class ScopeSharedLock {
+public:
+	ScopeSharedLock(SharedSpinLock& lock) : Lock(lock) { Lock.LockShared(); }
+	~ScopeSharedLock() { Lock.UnlockShared(); }
+private:
+	SharedSpinLock& Lock;
+};
\ No newline at end of file